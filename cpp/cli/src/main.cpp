@@ -26,22 +26,25 @@
 #include <zxing/ReaderException.h>
 #include <zxing/common/GlobalHistogramBinarizer.h>
 #include <zxing/common/HybridBinarizer.h>
+#include <zxing/common/PresenceGate.h>
 #include <exception>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
 #include <zxing/Exception.h>
 #include <zxing/common/IllegalArgumentException.h>
 #include <zxing/BinaryBitmap.h>
 #include <zxing/DecodeHints.h>
 
-#include <zxing/qrcode/QRCodeReader.h>
-#include <zxing/multi/qrcode/QRCodeMultiReader.h>
 #include <zxing/multi/ByQuadrantReader.h>
 #include <zxing/multi/MultipleBarcodeReader.h>
 #include <zxing/multi/GenericMultipleBarcodeReader.h>
+#include <zxing/multi/RegionMultipleBarcodeReader.h>
 
 using namespace std;
 using namespace zxing;
 using namespace zxing::multi;
-using namespace zxing::qrcode;
 
 namespace {
 
@@ -49,30 +52,120 @@ bool more = false;
 bool test_mode = false;
 bool try_harder = false;
 bool search_multi = false;
+bool search_regions = false;
+bool pure_barcode = false;
 bool use_hybrid = false;
 bool use_global = false;
 bool verbose = false;
+bool benchmark = false;
+bool row_consensus = false;
+bool sub_pixel_edges = false;
+bool coarse_detection = false;
+bool also_inverted = false;
+int threads = 0;
+vector<int> scan_angles;
+Ref<PresenceGate> presence_gate;
+
+const int BENCHMARK_ITERATIONS = 100;
+
+// One reader for the whole run: its sub-readers are built on the first
+// image and reused for every following one.
+MultiFormatReader& shared_reader() {
+  static MultiFormatReader reader;
+  return reader;
+}
+
+// Puts a presence gate with the default thresholds in front of the shared
+// reader, unless there is one already.
+void use_presence_gate() {
+  if (!presence_gate) {
+    presence_gate = new PresenceGate();
+    shared_reader().setPresenceGate(presence_gate);
+  }
+}
 
 }
 
 vector<Ref<Result> > decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  Ref<Reader> reader(new MultiFormatReader);
-  return vector<Ref<Result> >(1, reader->decode(image, hints));
+  return vector<Ref<Result> >(1, shared_reader().decode(image, hints));
 }
 
 vector<Ref<Result> > decode_multi(Ref<BinaryBitmap> image, DecodeHints hints) {
-  MultiFormatReader delegate;
-  GenericMultipleBarcodeReader reader(delegate);
+  if (search_regions) {
+    RegionMultipleBarcodeReader reader(shared_reader());
+    return reader.decodeMultiple(image, hints);
+  }
+  GenericMultipleBarcodeReader reader(shared_reader());
   return reader.decodeMultiple(image, hints);
 }
 
+double elapsed_usec(clock_t start) {
+  return double(clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+}
+
+// Decodes the same frame repeatedly, once with a reader created per frame and
+// once with a reused reader, and reports the average time per frame for both.
+void run_benchmark(Ref<LuminanceSource> source, bool hybrid) {
+  DecodeHints hints(DecodeHints::DEFAULT_HINT);
+  hints.setTryHarder(try_harder);
+  hints.setPureBarcode(pure_barcode);
+  hints.setThreads(threads);
+  hints.setScanAngles(scan_angles);
+  hints.setRowConsensus(row_consensus);
+  hints.setSubPixelEdges(sub_pixel_edges);
+  hints.setCoarseDetection(coarse_detection);
+  hints.setAlsoInverted(also_inverted);
+
+  double fresh = 0;
+  double reused = 0;
+  for (int pass = 0; pass < 2; pass++) {
+    clock_t start = clock();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+      Ref<Binarizer> binarizer;
+      if (hybrid) {
+        binarizer = new HybridBinarizer(source);
+      } else {
+        binarizer = new GlobalHistogramBinarizer(source);
+      }
+      Ref<BinaryBitmap> binary(new BinaryBitmap(binarizer));
+      try {
+        if (pass == 0) {
+          MultiFormatReader reader;
+          reader.decode(binary, hints);
+        } else {
+          shared_reader().decode(binary, hints);
+        }
+      } catch (const zxing::Exception&) {
+        // timing only
+      }
+    }
+    if (pass == 0) {
+      fresh = elapsed_usec(start) / BENCHMARK_ITERATIONS;
+    } else {
+      reused = elapsed_usec(start) / BENCHMARK_ITERATIONS;
+    }
+  }
+
+  clock_t start = clock();
+  for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+    MultiFormatReader reader;
+    reader.setHints(hints);
+  }
+  double setup = elapsed_usec(start) / BENCHMARK_ITERATIONS;
+
+  cout << (hybrid ? "Hybrid" : "Global") << " binarizer: "
+       << fresh << " us/frame with a new reader, "
+       << reused << " us/frame with a reused reader, "
+       << setup << " us reader setup" << endl;
+}
+
 int read_image(Ref<LuminanceSource> source, bool hybrid, string expected) {
   vector<Ref<Result> > results;
   string cell_result;
   int res = -1;
+  Ref<Binarizer> binarizer;
 
   try {
-    Ref<Binarizer> binarizer;
     if (hybrid) {
       binarizer = new HybridBinarizer(source);
     } else {
@@ -80,8 +173,15 @@ int read_image(Ref<LuminanceSource> source, bool hybrid, string expected) {
     }
     DecodeHints hints(DecodeHints::DEFAULT_HINT);
     hints.setTryHarder(try_harder);
+    hints.setPureBarcode(pure_barcode);
+    hints.setThreads(threads);
+    hints.setScanAngles(scan_angles);
+    hints.setRowConsensus(row_consensus);
+    hints.setSubPixelEdges(sub_pixel_edges);
+    hints.setCoarseDetection(coarse_detection);
+    hints.setAlsoInverted(also_inverted);
     Ref<BinaryBitmap> binary(new BinaryBitmap(binarizer));
-    if (search_multi) {
+    if (search_multi || search_regions) {
       results = decode_multi(binary, hints);
     } else {
       results = decode(binary, hints);
@@ -102,7 +202,7 @@ int read_image(Ref<LuminanceSource> source, bool hybrid, string expected) {
   }
 
   if (test_mode && results.size() == 1) {
-    std::string result = results[0]->getText()->getText();
+    std::string const& result = results[0]->getText()->getText();
     if (expected.empty()) {
       cout << "  Expected text or binary data for image missing." << endl
            << "  Detected: " << result << endl;
@@ -117,6 +217,16 @@ int read_image(Ref<LuminanceSource> source, bool hybrid, string expected) {
     }
   }
 
+  if (verbose && hybrid && !binarizer.empty()) {
+    Ref<BitMatrix> matrix (binarizer->getBlackMatrix());
+    if (matrix->getTileCount() > 0) {
+      cout << "Hybrid binarizer thresholded " << matrix->getFilledTileCount()
+           << " of " << matrix->getTileCount() << " tiles ("
+           << 100 * matrix->getFilledTileCount() / matrix->getTileCount()
+           << "%)" << endl;
+    }
+  }
+
   if (res != 0 && (verbose || (use_global ^ use_hybrid))) {
     cout << (hybrid ? "Hybrid" : "Global")
          << " binarizer failed: " << cell_result << endl;
@@ -192,6 +302,22 @@ int main(int argc, char** argv) {
          << "  --test-mode               compare IMAGEs against text files" << endl
          << "  --try-harder              spend more time to try to find a barcode" << endl
          << "  --search-multi            search for more than one bar code" << endl
+         << "  --regions                 search for more than one bar code, each only" << endl
+         << "                            where the black and white look like one" << endl
+         << "  --pure                    IMAGE is an unrotated symbol on a white border" << endl
+         << "  --benchmark               time repeated decoding of each IMAGE" << endl
+         << "  --threads N               scan 1D barcode rows, or the parts of IMAGE a" << endl
+         << "                            multiple bar code search tries, on N threads" << endl
+         << "  --angles A,B,...          also scan for 1D barcodes tilted A, B, ... degrees" << endl
+         << "  --consensus               read 1D barcodes no single row holds whole" << endl
+         << "  --edges                   find 1D bar edges between pixels, for blurry images" << endl
+         << "  --coarse                  find 2D barcodes in large IMAGEs scaled down" << endl
+         << "  --inverted                also look for white on black barcodes" << endl
+         << "  --presence                skip IMAGEs without barcode-like texture, and report" << endl
+         << "                            how many of those with a barcode were kept, and how fast" << endl
+         << "  --presence-thresholds E,D,C,P" << endl
+         << "                            the same, with the minimum gradient energy, transition" << endl
+         << "                            density, orientation coherence and periodicity to keep" << endl
          << endl
          << "Example usage:" << endl
          << "  zxing --test-mode *.jpg" << endl
@@ -204,6 +330,13 @@ int main(int argc, char** argv) {
   int honly = 0;
   int both = 0;
   int neither = 0;
+  // Images with and without expected text, and how many of each the
+  // presence gate kept.
+  int with_barcode = 0;
+  int kept_with = 0;
+  int without_barcode = 0;
+  int kept_without = 0;
+  double presence_time = 0;
 
   for (int i = 1; i < argc; i++) {
     string filename = argv[i];
@@ -238,6 +371,66 @@ int main(int argc, char** argv) {
       search_multi = true;
       continue;
     }
+    if (filename.compare("--regions") == 0) {
+      search_regions = true;
+      continue;
+    }
+    if (filename.compare("--pure") == 0) {
+      pure_barcode = true;
+      continue;
+    }
+    if (filename.compare("--benchmark") == 0) {
+      benchmark = true;
+      continue;
+    }
+    if (filename.compare("--consensus") == 0) {
+      row_consensus = true;
+      continue;
+    }
+    if (filename.compare("--edges") == 0) {
+      sub_pixel_edges = true;
+      continue;
+    }
+    if (filename.compare("--coarse") == 0) {
+      coarse_detection = true;
+      continue;
+    }
+    if (filename.compare("--inverted") == 0) {
+      also_inverted = true;
+      continue;
+    }
+    if (filename.compare("--presence") == 0) {
+      use_presence_gate();
+      continue;
+    }
+    if (filename.compare("--presence-thresholds") == 0 && i + 1 < argc) {
+      use_presence_gate();
+      char* end = argv[++i];
+      presence_gate->setMinGradientEnergy((int) strtol(end, &end, 10));
+      if (*end == ',') {
+        presence_gate->setMinTransitionDensity((float) strtod(end + 1, &end));
+      }
+      if (*end == ',') {
+        presence_gate->setMinCoherence((float) strtod(end + 1, &end));
+      }
+      if (*end == ',') {
+        presence_gate->setMinPeriodicity((float) strtod(end + 1, &end));
+      }
+      continue;
+    }
+    if (filename.compare("--threads") == 0 && i + 1 < argc) {
+      threads = std::max(0, atoi(argv[++i]));
+      continue;
+    }
+    if (filename.compare("--angles") == 0 && i + 1 < argc) {
+      scan_angles.clear();
+      for (char const* angle = argv[++i]; *angle; ) {
+        char* end;
+        scan_angles.push_back(std::max(-90, std::min(90, (int) strtol(angle, &end, 10))));
+        angle = *end == ',' ? end + 1 : end + strlen(end);
+      }
+      continue;
+    }
 
     if (filename.length() > 3 &&
         (filename.substr(filename.length() - 3, 3).compare("txt") == 0 ||
@@ -261,8 +454,31 @@ int main(int argc, char** argv) {
       continue;
     }
 
+    if (benchmark) {
+      if (use_hybrid) {
+        run_benchmark(source, true);
+      }
+      if (use_global) {
+        run_benchmark(source, false);
+      }
+      continue;
+    }
+
     string expected = read_expected(filename);
 
+    if (presence_gate) {
+      clock_t start = clock();
+      bool kept = presence_gate->mayContainBarcode(*source);
+      presence_time += elapsed_usec(start);
+      if (expected.empty()) {
+        without_barcode++;
+        kept_without += kept;
+      } else {
+        with_barcode++;
+        kept_with += kept;
+      }
+    }
+
     int gresult = 1;
     int hresult = 1;
     if (use_hybrid) {
@@ -293,5 +509,20 @@ int main(int argc, char** argv) {
          << " passed only global, " << neither << " pass neither." << endl;
   }
 
+  if (presence_gate && total > 0) {
+    cout << endl
+         << "Presence gate (energy " << presence_gate->getMinGradientEnergy()
+         << ", density " << presence_gate->getMinTransitionDensity()
+         << ", coherence " << presence_gate->getMinCoherence()
+         << ", periodicity " << presence_gate->getMinPeriodicity() << "):" << endl
+         << " kept " << kept_with << " of " << with_barcode << " images with a barcode";
+    if (with_barcode > 0) {
+      cout << " (recall " << 100.0 * kept_with / with_barcode << "%)";
+    }
+    cout << "," << endl
+         << " kept " << kept_without << " of " << without_barcode << " images without one," << endl
+         << " " << presence_time / total << " us per image." << endl;
+  }
+
   return 0;
 }
@@ -30,10 +30,14 @@ namespace zxing {
 	Binarizer::~Binarizer() {
 	}
 	
-	Ref<LuminanceSource> Binarizer::getLuminanceSource() const {
+	Ref<LuminanceSource> const& Binarizer::getLuminanceSource() const {
 		return source_;
 	}
 
+  Ref<BitMatrix> Binarizer::getFineBlackMatrix(Ref<Binarizer> const&, int) {
+    return getBlackMatrix();
+  }
+
   int Binarizer::getWidth() const {
     return source_->getWidth();
   }
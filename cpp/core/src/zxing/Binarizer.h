@@ -37,8 +37,12 @@ class Binarizer : public Counted {
 
   virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row) = 0;
   virtual Ref<BitMatrix> getBlackMatrix() = 0;
+  // The black matrix thresholded with what coarse, a binarizer of the same
+  // image scaled down by scale, has already worked out, where that saves
+  // work. getBlackMatrix() unless overridden.
+  virtual Ref<BitMatrix> getFineBlackMatrix(Ref<Binarizer> const& coarse, int scale);
 
-  Ref<LuminanceSource> getLuminanceSource() const ;
+  Ref<LuminanceSource> const& getLuminanceSource() const;
   virtual Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source) = 0;
 
   int getWidth() const;
@@ -16,12 +16,15 @@
  */
 
 #include <zxing/BinaryBitmap.h>
+#include <zxing/InvertedBinarizer.h>
+#include <algorithm>
 
 using zxing::Ref;
 using zxing::BitArray;
 using zxing::BitMatrix;
 using zxing::LuminanceSource;
 using zxing::BinaryBitmap;
+using zxing::InvertedBinarizer;
 	
 // VC++
 using zxing::Binarizer;
@@ -48,7 +51,7 @@ int BinaryBitmap::getHeight() const {
   return getLuminanceSource()->getHeight();
 }
 	
-Ref<LuminanceSource> BinaryBitmap::getLuminanceSource() const {
+Ref<LuminanceSource> const& BinaryBitmap::getLuminanceSource() const {
   return binarizer_->getLuminanceSource();
 }
 	
@@ -61,10 +64,59 @@ Ref<BinaryBitmap> BinaryBitmap::crop(int left, int top, int width, int height) {
   return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->crop(left, top, width, height))));
 }
 
+Ref<BinaryBitmap> BinaryBitmap::clone() {
+  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource())));
+}
+
+Ref<BinaryBitmap> BinaryBitmap::invert() {
+  Ref<BinaryBitmap> inverted (new BinaryBitmap(Ref<Binarizer>(new InvertedBinarizer(binarizer_))));
+  if (!rotated_.empty()) {
+    inverted->rotated_ = rotated_->invert();
+  }
+  if (!halved_.empty()) {
+    inverted->halved_ = halved_->invert();
+    // Without a level to halve to, fine_ is just the black matrix, which
+    // the binarizer flips by itself.
+    if (!fine_.empty()) {
+      inverted->fine_ = fine_->inverted();
+    }
+  }
+  return inverted;
+}
+
 bool BinaryBitmap::isRotateSupported() const {
   return getLuminanceSource()->isRotateSupported();
 }
 
 Ref<BinaryBitmap> BinaryBitmap::rotateCounterClockwise() {
-  return Ref<BinaryBitmap> (new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->rotateCounterClockwise())));
+  if (rotated_.empty()) {
+    rotated_ = new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->rotateCounterClockwise()));
+  }
+  return rotated_;
+}
+
+Ref<BinaryBitmap> BinaryBitmap::getCoarseLevel(int& scale) {
+  if (std::min(getWidth(), getHeight()) / 2 < MIN_COARSE_DIMENSION) {
+    scale = 1;
+    return Ref<BinaryBitmap>(this);
+  }
+  if (halved_.empty()) {
+    halved_ = new BinaryBitmap(binarizer_->createBinarizer(getLuminanceSource()->scaleDown()));
+  }
+  Ref<BinaryBitmap> level = halved_->getCoarseLevel(scale);
+  scale *= 2;
+  return level;
+}
+
+Ref<BitMatrix> BinaryBitmap::getFineBlackMatrix() {
+  if (fine_.empty()) {
+    int scale;
+    Ref<BinaryBitmap> coarse = getCoarseLevel(scale);
+    if (scale > 1) {
+      fine_ = binarizer_->getFineBlackMatrix(coarse->binarizer_, scale);
+    } else {
+      fine_ = getBlackMatrix();
+    }
+  }
+  return fine_;
 }
@@ -30,6 +30,9 @@ namespace zxing {
 	class BinaryBitmap : public Counted {
 	private:
 		Ref<Binarizer> binarizer_;
+		Ref<BinaryBitmap> rotated_;
+		Ref<BinaryBitmap> halved_;
+		Ref<BitMatrix> fine_;
 		
 	public:
 		BinaryBitmap(Ref<Binarizer> binarizer);
@@ -38,17 +41,42 @@ namespace zxing {
 		Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
 		Ref<BitMatrix> getBlackMatrix();
 		
-		Ref<LuminanceSource> getLuminanceSource() const;
+		Ref<LuminanceSource> const& getLuminanceSource() const;
 
 		int getWidth() const;
 		int getHeight() const;
 
 		bool isRotateSupported() const;
+		// Rotated once and then kept, since every try-harder 1D pass asks for
+		// the same rotation.
 		Ref<BinaryBitmap> rotateCounterClockwise();
 
 		bool isCropSupported() const;
 		Ref<BinaryBitmap> crop(int left, int top, int width, int height);
 
+		// The image with black and white swapped, for white on black symbols.
+		// Its rows and black matrix are flipped from this one's rather than
+		// binarized again, and so are the rotation and coarse levels this one
+		// has made so far. Made anew on each call.
+		Ref<BinaryBitmap> invert();
+
+		// A bitmap of the same image with a binarizer of its own, so that rows
+		// can be binarized on another thread while this one is in use.
+		Ref<BinaryBitmap> clone();
+		// The smaller sides of the levels getCoarseLevel() returns are at least
+		// this long.
+		static const int MIN_COARSE_DIMENSION = 480;
+		// For finding symbols in large images: the image halved in size as
+		// often as leaves at least MIN_COARSE_DIMENSION pixels on its shorter
+		// side, with scale set to how many times smaller that is. Without room
+		// to halve it even once, this bitmap itself with scale 1. Each level is
+		// made once and then kept.
+		Ref<BinaryBitmap> getCoarseLevel(int& scale);
+		// For finishing off at full size what was found on getCoarseLevel():
+		// the black matrix as thresholded by the binarizer of that level, so
+		// it is only worked out where it is read. Made once and then kept.
+		Ref<BitMatrix> getFineBlackMatrix();
+
 	};
 	
 }
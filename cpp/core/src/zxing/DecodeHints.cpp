@@ -20,6 +20,7 @@
 
 #include <zxing/DecodeHints.h>
 #include <zxing/common/IllegalArgumentException.h>
+#include <algorithm>
 
 using zxing::Ref;
 using zxing::ResultPointCallback;
@@ -31,6 +32,29 @@ using zxing::BarcodeFormat;
 
 const DecodeHintType DecodeHints::CHARACTER_SET;
 
+namespace {
+
+const DecodeHintType FORMAT_HINTS =
+  DecodeHints::AZTEC_HINT |
+  DecodeHints::CODABAR_HINT |
+  DecodeHints::CODE_39_HINT |
+  DecodeHints::CODE_93_HINT |
+  DecodeHints::CODE_128_HINT |
+  DecodeHints::DATA_MATRIX_HINT |
+  DecodeHints::EAN_8_HINT |
+  DecodeHints::EAN_13_HINT |
+  DecodeHints::ITF_HINT |
+  DecodeHints::MAXICODE_HINT |
+  DecodeHints::PDF_417_HINT |
+  DecodeHints::QR_CODE_HINT |
+  DecodeHints::RSS_14_HINT |
+  DecodeHints::RSS_EXPANDED_HINT |
+  DecodeHints::UPC_A_HINT |
+  DecodeHints::UPC_E_HINT |
+  DecodeHints::UPC_EAN_EXTENSION_HINT;
+
+}
+
 const DecodeHints DecodeHints::PRODUCT_HINT(
   UPC_A_HINT |
   UPC_E_HINT |
@@ -56,12 +80,14 @@ const DecodeHints DecodeHints::DEFAULT_HINT(
   PDF_417_HINT
   );
 
-DecodeHints::DecodeHints() {
-  hints = 0;
+DecodeHints::DecodeHints()
+  : hints(0), roiLeft(0), roiTop(0), roiWidth(0), roiHeight(0),
+    minModuleSize(0), maxModuleSize(0), symbolDimension(0), threads(0) {
 }
 
-DecodeHints::DecodeHints(DecodeHintType init) {
-  hints = init;
+DecodeHints::DecodeHints(DecodeHintType init)
+  : hints(init), roiLeft(0), roiTop(0), roiWidth(0), roiHeight(0),
+    minModuleSize(0), maxModuleSize(0), symbolDimension(0), threads(0) {
 }
 
 void DecodeHints::addFormat(BarcodeFormat toadd) {
@@ -112,6 +138,14 @@ bool DecodeHints::containsFormat(BarcodeFormat tocheck) const {
   return (hints & checkAgainst) != 0;
 }
 
+bool DecodeHints::hasFormats() const {
+  return (hints & FORMAT_HINTS) != 0;
+}
+
+void DecodeHints::retainFormats(DecodeHints const& formats) {
+  hints &= formats.hints | ~FORMAT_HINTS;
+}
+
 void DecodeHints::setTryHarder(bool toset) {
   if (toset) {
     hints |= TRYHARDER_HINT;
@@ -124,6 +158,66 @@ bool DecodeHints::getTryHarder() const {
   return (hints & TRYHARDER_HINT) != 0;
 }
 
+void DecodeHints::setPureBarcode(bool toset) {
+  if (toset) {
+    hints |= PURE_BARCODE_HINT;
+  } else {
+    hints &= ~PURE_BARCODE_HINT;
+  }
+}
+
+bool DecodeHints::getPureBarcode() const {
+  return (hints & PURE_BARCODE_HINT) != 0;
+}
+
+void DecodeHints::setRowConsensus(bool toset) {
+  if (toset) {
+    hints |= ROW_CONSENSUS_HINT;
+  } else {
+    hints &= ~ROW_CONSENSUS_HINT;
+  }
+}
+
+bool DecodeHints::getRowConsensus() const {
+  return (hints & ROW_CONSENSUS_HINT) != 0;
+}
+
+void DecodeHints::setSubPixelEdges(bool toset) {
+  if (toset) {
+    hints |= SUB_PIXEL_EDGES_HINT;
+  } else {
+    hints &= ~SUB_PIXEL_EDGES_HINT;
+  }
+}
+
+bool DecodeHints::getSubPixelEdges() const {
+  return (hints & SUB_PIXEL_EDGES_HINT) != 0;
+}
+
+void DecodeHints::setCoarseDetection(bool toset) {
+  if (toset) {
+    hints |= COARSE_DETECTION_HINT;
+  } else {
+    hints &= ~COARSE_DETECTION_HINT;
+  }
+}
+
+bool DecodeHints::getCoarseDetection() const {
+  return (hints & COARSE_DETECTION_HINT) != 0;
+}
+
+void DecodeHints::setAlsoInverted(bool toset) {
+  if (toset) {
+    hints |= ALSO_INVERTED_HINT;
+  } else {
+    hints &= ~ALSO_INVERTED_HINT;
+  }
+}
+
+bool DecodeHints::getAlsoInverted() const {
+  return (hints & ALSO_INVERTED_HINT) != 0;
+}
+
 void DecodeHints::setResultPointCallback(Ref<ResultPointCallback> const& _callback) {
   callback = _callback;
 }
@@ -132,11 +226,122 @@ Ref<ResultPointCallback> DecodeHints::getResultPointCallback() const {
   return callback;
 }
 
+void DecodeHints::setRegionOfInterest(int left, int top, int width, int height) {
+  if (left < 0 || top < 0 || width <= 0 || height <= 0) {
+    throw IllegalArgumentException("Invalid region of interest");
+  }
+  roiLeft = left;
+  roiTop = top;
+  roiWidth = width;
+  roiHeight = height;
+}
+
+void DecodeHints::clearRegionOfInterest() {
+  roiLeft = roiTop = roiWidth = roiHeight = 0;
+}
+
+void DecodeHints::getRegionOfInterest(int width, int height,
+                                      int& left, int& top, int& right, int& bottom) const {
+  if (!hasRegionOfInterest()) {
+    left = 0;
+    top = 0;
+    right = width;
+    bottom = height;
+    return;
+  }
+  left = std::min(roiLeft, width);
+  top = std::min(roiTop, height);
+  right = std::min(roiLeft + roiWidth, width);
+  bottom = std::min(roiTop + roiHeight, height);
+}
+
+void DecodeHints::setModuleSizeRange(float minSize, float maxSize) {
+  if (minSize < 0 || (maxSize > 0 && maxSize < minSize)) {
+    throw IllegalArgumentException("Invalid module size range");
+  }
+  minModuleSize = minSize;
+  maxModuleSize = maxSize;
+}
+
+void DecodeHints::setSymbolDimension(int dimension) {
+  if (dimension < 0) {
+    throw IllegalArgumentException("Invalid symbol dimension");
+  }
+  symbolDimension = dimension;
+}
+
+void DecodeHints::setThreads(int count) {
+  if (count < 0) {
+    throw IllegalArgumentException("Invalid thread count");
+  }
+  threads = count;
+}
+
+void DecodeHints::setScanAngles(std::vector<int> const& degrees) {
+  for (size_t i = 0; i < degrees.size(); i++) {
+    if (degrees[i] < -90 || degrees[i] > 90) {
+      throw IllegalArgumentException("Invalid scan angle");
+    }
+  }
+  scanAngles = degrees;
+}
+
+DecodeHints DecodeHints::scaleDown(int scale) const {
+  DecodeHints result (*this);
+  if (hasRegionOfInterest()) {
+    // Keep every pixel the region touches.
+    result.roiLeft = roiLeft / scale;
+    result.roiTop = roiTop / scale;
+    result.roiWidth = (roiLeft + roiWidth + scale - 1) / scale - result.roiLeft;
+    result.roiHeight = (roiTop + roiHeight + scale - 1) / scale - result.roiTop;
+  }
+  result.minModuleSize = minModuleSize / scale;
+  result.maxModuleSize = maxModuleSize / scale;
+  return result;
+}
+
 DecodeHints zxing::operator | (DecodeHints const& l, DecodeHints const& r) {
   DecodeHints result (l);
   result.hints |= r.hints;
   if (!result.callback) {
     result.callback = r.callback;
   }
+  if (!result.hasRegionOfInterest()) {
+    result.roiLeft = r.roiLeft;
+    result.roiTop = r.roiTop;
+    result.roiWidth = r.roiWidth;
+    result.roiHeight = r.roiHeight;
+  }
+  if (result.minModuleSize == 0 && result.maxModuleSize == 0) {
+    result.minModuleSize = r.minModuleSize;
+    result.maxModuleSize = r.maxModuleSize;
+  }
+  if (result.symbolDimension == 0) {
+    result.symbolDimension = r.symbolDimension;
+  }
+  if (result.threads == 0) {
+    result.threads = r.threads;
+  }
+  if (result.scanAngles.empty()) {
+    result.scanAngles = r.scanAngles;
+  }
   return result;
 }
+
+bool zxing::operator == (DecodeHints const& l, DecodeHints const& r) {
+  return l.hints == r.hints &&
+    l.callback.object_ == r.callback.object_ &&
+    l.roiLeft == r.roiLeft &&
+    l.roiTop == r.roiTop &&
+    l.roiWidth == r.roiWidth &&
+    l.roiHeight == r.roiHeight &&
+    l.minModuleSize == r.minModuleSize &&
+    l.maxModuleSize == r.maxModuleSize &&
+    l.symbolDimension == r.symbolDimension &&
+    l.threads == r.threads &&
+    l.scanAngles == r.scanAngles;
+}
+
+bool zxing::operator != (DecodeHints const& l, DecodeHints const& r) {
+  return !(l == r);
+}
@@ -22,18 +22,31 @@
 
 #include <zxing/BarcodeFormat.h>
 #include <zxing/ResultPointCallback.h>
+#include <vector>
 
 namespace zxing {
 
 typedef unsigned int DecodeHintType;
 class DecodeHints;
 DecodeHints operator | (DecodeHints const&, DecodeHints const&);
+bool operator == (DecodeHints const&, DecodeHints const&);
+bool operator != (DecodeHints const&, DecodeHints const&);
 
 class DecodeHints {
  private:
   DecodeHintType hints;
   Ref<ResultPointCallback> callback;
 
+  int roiLeft;
+  int roiTop;
+  int roiWidth;
+  int roiHeight;
+  float minModuleSize;
+  float maxModuleSize;
+  int symbolDimension;
+  int threads;
+  std::vector<int> scanAngles;
+
  public:
   static const DecodeHintType AZTEC_HINT = 1 << BarcodeFormat::AZTEC;
   static const DecodeHintType CODABAR_HINT = 1 << BarcodeFormat::CODABAR;
@@ -59,6 +72,11 @@ class DecodeHints {
   // static const DecodeHintType ASSUME_CODE_39_CHECK_DIGIT = 1 << 28;
   static const DecodeHintType  ASSUME_GS1 = 1 << 27;
   // static const DecodeHintType NEED_RESULT_POINT_CALLBACK = 1 << 26;
+  static const DecodeHintType PURE_BARCODE_HINT = 1 << 25;
+  static const DecodeHintType ROW_CONSENSUS_HINT = 1 << 24;
+  static const DecodeHintType SUB_PIXEL_EDGES_HINT = 1 << 23;
+  static const DecodeHintType COARSE_DETECTION_HINT = 1 << 22;
+  static const DecodeHintType ALSO_INVERTED_HINT = 1 << 21;
   
   static const DecodeHints PRODUCT_HINT;
   static const DecodeHints ONED_HINT;
@@ -69,15 +87,83 @@ class DecodeHints {
 
   void addFormat(BarcodeFormat toadd);
   bool containsFormat(BarcodeFormat tocheck) const;
+  bool hasFormats() const;
+  // Drops the formats that formats does not contain; other hints stay.
+  void retainFormats(DecodeHints const& formats);
   bool isEmpty() const {return (hints==0);}
   void clear() {hints=0;}
   void setTryHarder(bool toset);
   bool getTryHarder() const;
 
+  // The image is a pure, axis-aligned rendering of a single symbol with a
+  // quiet zone around it, so readers may skip detection entirely.
+  void setPureBarcode(bool toset);
+  bool getPureBarcode() const;
+
+  // When no single row of a 1D barcode decodes, combine what each row could
+  // read, position by position, into one checksum-valid reading. Supported
+  // by the EAN-13, UPC-A, EAN-8 and Code 128 readers.
+  void setRowConsensus(bool toset);
+  bool getRowConsensus() const;
+
+  // When a row of a 1D barcode does not decode binarized, find its bar
+  // edges from the luminances to a fraction of a pixel (see oned::EdgeRow)
+  // and try again. Helps with blurry and low resolution barcodes.
+  void setSubPixelEdges(bool toset);
+  bool getSubPixelEdges() const;
+
+  // In large images, find QR codes, Aztec bull's eyes and PDF417 start and
+  // stop patterns on the image scaled down (see BinaryBitmap::getCoarseLevel)
+  // and only sample the symbol at full resolution. Falls back to detecting
+  // at full resolution when that does not decode.
+  void setCoarseDetection(bool toset);
+  bool getCoarseDetection() const;
+
+  // When nothing decodes, MultiFormatReader tries again with black and
+  // white swapped (see BinaryBitmap::invert), for white on black symbols.
+  void setAlsoInverted(bool toset);
+  bool getAlsoInverted() const;
+
   void setResultPointCallback(Ref<ResultPointCallback> const&);
   Ref<ResultPointCallback> getResultPointCallback() const;
 
+  // Restricts detection to the given rectangle of the image, in pixels.
+  void setRegionOfInterest(int left, int top, int width, int height);
+  bool hasRegionOfInterest() const {return roiWidth > 0 && roiHeight > 0;}
+  void clearRegionOfInterest();
+  // Clips the region of interest to an image of the given size; without a
+  // region of interest this is the whole image. right and bottom are exclusive.
+  void getRegionOfInterest(int width, int height,
+                           int& left, int& top, int& right, int& bottom) const;
+
+  // Expected size of one module in pixels; 0 means unknown.
+  void setModuleSizeRange(float minSize, float maxSize);
+  float getMinModuleSize() const {return minModuleSize;}
+  float getMaxModuleSize() const {return maxModuleSize;}
+
+  // Expected symbol size in modules per side (e.g. 21 for a version 1 QR
+  // code); 0 means unknown.
+  void setSymbolDimension(int dimension);
+  int getSymbolDimension() const {return symbolDimension;}
+
+  // Number of threads a reader may use to scan rows in parallel; the
+  // result does not depend on it. 0 or 1 scans on the calling thread only.
+  void setThreads(int count);
+  int getThreads() const {return threads;}
+
+  // Angles in degrees, counter-clockwise from horizontal and between -90
+  // and 90, of straight lines that 1D readers scan when no row of the image
+  // decodes. This finds tilted barcodes without rotating the image; with
+  // try harder, vertical lines are scanned too in place of the rotation.
+  void setScanAngles(std::vector<int> const& degrees);
+  std::vector<int> const& getScanAngles() const {return scanAngles;}
+
+  // These hints for the image scaled down by scale: the region of interest
+  // and the module sizes shrink with it.
+  DecodeHints scaleDown(int scale) const;
+
   friend DecodeHints operator | (DecodeHints const&, DecodeHints const&);
+  friend bool operator == (DecodeHints const&, DecodeHints const&);
 };
 
 }
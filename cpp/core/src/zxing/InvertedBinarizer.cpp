@@ -0,0 +1,56 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/InvertedBinarizer.h>
+
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::BitMatrix;
+using zxing::Binarizer;
+using zxing::InvertedBinarizer;
+
+// VC++
+using zxing::LuminanceSource;
+
+InvertedBinarizer::InvertedBinarizer(Ref<Binarizer> const& delegate)
+  : Binarizer(delegate->getLuminanceSource()->invert()), delegate_(delegate) {
+}
+
+Ref<BitArray> InvertedBinarizer::getBlackRow(int y, Ref<BitArray> row) {
+  row = delegate_->getBlackRow(y, row);
+  row->invert();
+  return row;
+}
+
+Ref<BitMatrix> InvertedBinarizer::getBlackMatrix() {
+  if (matrix_.empty()) {
+    matrix_ = delegate_->getBlackMatrix()->inverted();
+  }
+  return matrix_;
+}
+
+Ref<BitMatrix> InvertedBinarizer::getFineBlackMatrix(Ref<Binarizer> const& coarse, int scale) {
+  InvertedBinarizer* invertedCoarse = dynamic_cast<InvertedBinarizer*>(&*coarse);
+  if (!invertedCoarse) {
+    return Binarizer::getFineBlackMatrix(coarse, scale);
+  }
+  return delegate_->getFineBlackMatrix(invertedCoarse->delegate_, scale)->inverted();
+}
+
+Ref<Binarizer> InvertedBinarizer::createBinarizer(Ref<LuminanceSource> source) {
+  return delegate_->createBinarizer(source);
+}
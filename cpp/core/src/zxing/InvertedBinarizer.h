@@ -0,0 +1,45 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __INVERTEDBINARIZER_H__
+#define __INVERTEDBINARIZER_H__
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/Binarizer.h>
+
+namespace zxing {
+
+// Binarizes white on black symbols as if they were black on white by
+// flipping what the delegate has already binarized, rather than binarizing
+// the inverted luminances again. Its luminance source is the inverted one,
+// for readers that look at luminances themselves.
+class InvertedBinarizer : public Binarizer {
+private:
+  Ref<Binarizer> delegate_;
+  Ref<BitMatrix> matrix_;
+
+public:
+  InvertedBinarizer(Ref<Binarizer> const& delegate);
+
+  Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
+  Ref<BitMatrix> getBlackMatrix();
+  Ref<BitMatrix> getFineBlackMatrix(Ref<Binarizer> const& coarse, int scale);
+  // A plain binarizer of the delegate's kind: source is already inverted.
+  Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+};
+
+}
+
+#endif /* INVERTEDBINARIZER_H_ */
@@ -21,10 +21,13 @@
 #include <sstream>
 #include <zxing/LuminanceSource.h>
 #include <zxing/InvertedLuminanceSource.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
 #include <zxing/common/IllegalArgumentException.h>
 
 using zxing::Ref;
 using zxing::LuminanceSource;
+using zxing::ArrayRef;
+using zxing::GreyscaleLuminanceSource;
 
 LuminanceSource::LuminanceSource(int width_, int height_) :width(width_), height(height_) {}
 
@@ -84,3 +87,31 @@ Ref<LuminanceSource> LuminanceSource::invert() const {
   return Ref<LuminanceSource>
       (new InvertedLuminanceSource(Ref<LuminanceSource>(const_cast<LuminanceSource*>(this))));
 }
+
+Ref<LuminanceSource> LuminanceSource::scaleDown() const {
+  int width = getWidth() / 2;
+  int height = getHeight() / 2;
+  if (width == 0 || height == 0) {
+    throw IllegalArgumentException("Image too small to scale down.");
+  }
+  ArrayRef<char> scaled (width * height);
+  ArrayRef<char> top;
+  ArrayRef<char> bottom;
+  for (int y = 0; y < height; y++) {
+    top = getRow(2 * y, top);
+    bottom = getRow(2 * y + 1, bottom);
+    scaleDownRows(&top[0], &bottom[0], width, &scaled[y * width]);
+  }
+  return Ref<LuminanceSource>
+      (new GreyscaleLuminanceSource(scaled, width, height, 0, 0, width, height));
+}
+
+void LuminanceSource::scaleDownRows(char const* top, char const* bottom, int width, char* out) {
+  unsigned char const* above = (unsigned char const*) top;
+  unsigned char const* below = (unsigned char const*) bottom;
+  // A plain loop over bytes, which the compiler vectorizes.
+  for (int x = 0; x < width; x++) {
+    out[x] = (char) ((above[2 * x] + above[2 * x + 1] +
+                      below[2 * x] + below[2 * x + 1] + 2) >> 2);
+  }
+}
@@ -51,7 +51,16 @@ class LuminanceSource : public Counted {
   
   virtual Ref<LuminanceSource> rotateCounterClockwise() const;
 
+  // The image at half the width and height, each pixel the average of the
+  // two by two it covers here.
+  virtual Ref<LuminanceSource> scaleDown() const;
+
   operator std::string () const;
+
+ protected:
+  // Averages each two by two pixels of the rows top and bottom, 2 * width
+  // pixels long, into width pixels of out.
+  static void scaleDownRows(char const* top, char const* bottom, int width, char* out);
 };
 
 }
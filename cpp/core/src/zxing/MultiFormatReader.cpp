@@ -17,13 +17,23 @@
 
 #include <zxing/ZXing.h>
 #include <zxing/MultiFormatReader.h>
+#ifndef NO_QR_CODE
 #include <zxing/qrcode/QRCodeReader.h>
+#endif
+#ifndef NO_DATA_MATRIX
 #include <zxing/datamatrix/DataMatrixReader.h>
+#endif
+#ifndef NO_AZTEC
 #include <zxing/aztec/AztecReader.h>
+#endif
+#ifndef NO_PDF_417
 #include <zxing/pdf417/PDF417Reader.h>
-#include <zxing/oned/MultiFormatUPCEANReader.h>
+#endif
+#ifndef NO_ONED
 #include <zxing/oned/MultiFormatOneDReader.h>
+#endif
 #include <zxing/ReaderException.h>
+#include <zxing/NotFoundException.h>
 
 using zxing::Ref;
 using zxing::Result;
@@ -32,8 +42,56 @@ using zxing::MultiFormatReader;
 // VC++
 using zxing::DecodeHints;
 using zxing::BinaryBitmap;
+using zxing::Reader;
+using zxing::BarcodeFormat;
+using zxing::DecodeHintType;
+using zxing::PresenceGate;
+using zxing::NotFoundException;
 
-MultiFormatReader::MultiFormatReader() {}
+namespace {
+
+DecodeHintType oneDFormatsOf(DecodeHints const& hints) {
+  DecodeHintType formats = 0;
+#ifndef NO_ONED
+  static const BarcodeFormat::Value ONED_FORMATS[] = {
+#ifndef NO_UPC_EAN
+    BarcodeFormat::UPC_A,
+    BarcodeFormat::UPC_E,
+    BarcodeFormat::EAN_13,
+    BarcodeFormat::EAN_8,
+#endif
+#ifndef NO_CODABAR
+    BarcodeFormat::CODABAR,
+#endif
+#ifndef NO_CODE_39
+    BarcodeFormat::CODE_39,
+#endif
+#ifndef NO_CODE_93
+    BarcodeFormat::CODE_93,
+#endif
+#ifndef NO_CODE_128
+    BarcodeFormat::CODE_128,
+#endif
+#ifndef NO_ITF
+    BarcodeFormat::ITF,
+#endif
+    BarcodeFormat::RSS_14,
+    BarcodeFormat::RSS_EXPANDED
+  };
+  for (int i = 0; i < ZXING_ARRAY_LEN(ONED_FORMATS); i++) {
+    if (hints.containsFormat(ONED_FORMATS[i])) {
+      formats |= 1 << ONED_FORMATS[i];
+    }
+  }
+#else
+  (void)hints;
+#endif
+  return formats;
+}
+
+}
+
+MultiFormatReader::MultiFormatReader() : configured_(false), oneDFormats_(0) {}
   
 Ref<Result> MultiFormatReader::decode(Ref<BinaryBitmap> image) {
   setHints(DecodeHints::DEFAULT_HINT);
@@ -47,69 +105,104 @@ Ref<Result> MultiFormatReader::decode(Ref<BinaryBitmap> image, DecodeHints hints
 
 Ref<Result> MultiFormatReader::decodeWithState(Ref<BinaryBitmap> image) {
   // Make sure to set up the default state so we don't crash
-  if (readers_.size() == 0) {
+  if (!configured_) {
     setHints(DecodeHints::DEFAULT_HINT);
   }
   return decodeInternal(image);
 }
 
+Ref<Reader> MultiFormatReader::getOneDReader(DecodeHints const& hints) {
+#ifndef NO_ONED
+  DecodeHintType formats = oneDFormatsOf(hints);
+  if (!oneDReader_ || formats != oneDFormats_) {
+    oneDReader_ = new zxing::oned::MultiFormatOneDReader(hints);
+    oneDFormats_ = formats;
+  }
+#else
+  (void)hints;
+#endif
+  return oneDReader_;
+}
+
 void MultiFormatReader::setHints(DecodeHints hints) {
+  if (configured_ && hints == hints_) {
+    return;
+  }
   hints_ = hints;
+  configured_ = true;
   readers_.clear();
-  bool tryHarder = hints.getTryHarder();
+  bool addOneDReader = oneDFormatsOf(hints) != 0;
+  bool addAll = !addOneDReader &&
+    !hints.containsFormat(BarcodeFormat::QR_CODE) &&
+    !hints.containsFormat(BarcodeFormat::DATA_MATRIX) &&
+    !hints.containsFormat(BarcodeFormat::AZTEC) &&
+    !hints.containsFormat(BarcodeFormat::PDF_417);
 
-  bool addOneDReader = hints.containsFormat(BarcodeFormat::UPC_E) ||
-    hints.containsFormat(BarcodeFormat::UPC_A) ||
-    hints.containsFormat(BarcodeFormat::UPC_E) ||
-    hints.containsFormat(BarcodeFormat::EAN_13) ||
-    hints.containsFormat(BarcodeFormat::EAN_8) ||
-    hints.containsFormat(BarcodeFormat::CODABAR) ||
-    hints.containsFormat(BarcodeFormat::CODE_39) ||
-    hints.containsFormat(BarcodeFormat::CODE_93) ||
-    hints.containsFormat(BarcodeFormat::CODE_128) ||
-    hints.containsFormat(BarcodeFormat::ITF) ||
-    hints.containsFormat(BarcodeFormat::RSS_14) ||
-    hints.containsFormat(BarcodeFormat::RSS_EXPANDED);
-  if (addOneDReader && !tryHarder) {
-    readers_.push_back(Ref<Reader>(new zxing::oned::MultiFormatOneDReader(hints)));
+#ifndef NO_ONED
+  if ((addOneDReader || addAll) && !hints.getTryHarder()) {
+    readers_.push_back(getOneDReader(hints));
   }
-  if (hints.containsFormat(BarcodeFormat::QR_CODE)) {
-    readers_.push_back(Ref<Reader>(new zxing::qrcode::QRCodeReader()));
+#endif
+#ifndef NO_QR_CODE
+  if (addAll || hints.containsFormat(BarcodeFormat::QR_CODE)) {
+    if (!qrCodeReader_) {
+      qrCodeReader_ = new zxing::qrcode::QRCodeReader();
+    }
+    readers_.push_back(qrCodeReader_);
   }
-  if (hints.containsFormat(BarcodeFormat::DATA_MATRIX)) {
-    readers_.push_back(Ref<Reader>(new zxing::datamatrix::DataMatrixReader()));
+#endif
+#ifndef NO_DATA_MATRIX
+  if (addAll || hints.containsFormat(BarcodeFormat::DATA_MATRIX)) {
+    if (!dataMatrixReader_) {
+      dataMatrixReader_ = new zxing::datamatrix::DataMatrixReader();
+    }
+    readers_.push_back(dataMatrixReader_);
   }
-  if (hints.containsFormat(BarcodeFormat::AZTEC)) {
-    readers_.push_back(Ref<Reader>(new zxing::aztec::AztecReader()));
+#endif
+#ifndef NO_AZTEC
+  if (addAll || hints.containsFormat(BarcodeFormat::AZTEC)) {
+    if (!aztecReader_) {
+      aztecReader_ = new zxing::aztec::AztecReader();
+    }
+    readers_.push_back(aztecReader_);
   }
-  if (hints.containsFormat(BarcodeFormat::PDF_417)) {
-    readers_.push_back(Ref<Reader>(new zxing::pdf417::PDF417Reader()));
+#endif
+#ifndef NO_PDF_417
+  if (addAll || hints.containsFormat(BarcodeFormat::PDF_417)) {
+    if (!pdf417Reader_) {
+      pdf417Reader_ = new zxing::pdf417::PDF417Reader();
+    }
+    readers_.push_back(pdf417Reader_);
   }
+#endif
   /*
   if (hints.contains(BarcodeFormat.MAXICODE)) {
     readers.add(new MaxiCodeReader());
   }
   */
-  if (addOneDReader && tryHarder) {
-    readers_.push_back(Ref<Reader>(new zxing::oned::MultiFormatOneDReader(hints)));
+#ifndef NO_ONED
+  if ((addOneDReader || addAll) && hints.getTryHarder()) {
+    readers_.push_back(getOneDReader(hints));
   }
-  if (readers_.size() == 0) {
-    if (!tryHarder) {
-      readers_.push_back(Ref<Reader>(new zxing::oned::MultiFormatOneDReader(hints)));
-    }
-    readers_.push_back(Ref<Reader>(new zxing::qrcode::QRCodeReader()));
-    readers_.push_back(Ref<Reader>(new zxing::datamatrix::DataMatrixReader()));
-    readers_.push_back(Ref<Reader>(new zxing::aztec::AztecReader()));
-    readers_.push_back(Ref<Reader>(new zxing::pdf417::PDF417Reader()));
-    // readers.add(new MaxiCodeReader());
+#endif
+}
 
-    if (tryHarder) {
-      readers_.push_back(Ref<Reader>(new zxing::oned::MultiFormatOneDReader(hints)));
-    }
+void MultiFormatReader::setPresenceGate(Ref<PresenceGate> gate) {
+  presenceGate_ = gate;
+}
+
+Ref<Reader> MultiFormatReader::cloneReader() const {
+  Ref<MultiFormatReader> copy (new MultiFormatReader());
+  if (presenceGate_) {
+    copy->presenceGate_ = presenceGate_->clone();
   }
+  return copy;
 }
 
 Ref<Result> MultiFormatReader::decodeInternal(Ref<BinaryBitmap> image) {
+  if (presenceGate_ && !presenceGate_->mayContainBarcode(*image->getLuminanceSource())) {
+    throw NotFoundException("No barcode-like texture");
+  }
   for (unsigned int i = 0; i < readers_.size(); i++) {
     try {
       return readers_[i]->decode(image, hints_);
@@ -118,6 +211,16 @@ Ref<Result> MultiFormatReader::decodeInternal(Ref<BinaryBitmap> image) {
       // continue
     }
   }
+  if (hints_.getAlsoInverted()) {
+    Ref<BinaryBitmap> inverted = image->invert();
+    for (unsigned int i = 0; i < readers_.size(); i++) {
+      try {
+        return readers_[i]->decode(inverted, hints_);
+      } catch (ReaderException const& re) {
+        (void)re;
+      }
+    }
+  }
   throw ReaderException("No code detected");
 }
   
@@ -25,14 +25,29 @@
 #include <zxing/common/BitArray.h>
 #include <zxing/Result.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/common/PresenceGate.h>
 
 namespace zxing {
   class MultiFormatReader : public Reader {
   private:
     Ref<Result> decodeInternal(Ref<BinaryBitmap> image);
-  
+    Ref<Reader> getOneDReader(DecodeHints const& hints);
+
     std::vector<Ref<Reader> > readers_;
     DecodeHints hints_;
+    bool configured_;
+
+    // Readers are created on first use and kept across setHints() calls, so
+    // decoding a stream of frames does not rebuild them (and their decoders)
+    // for every frame. Only the 1D reader depends on the hints it was built
+    // with; oneDFormats_ records them.
+    Ref<Reader> oneDReader_;
+    DecodeHintType oneDFormats_;
+    Ref<Reader> qrCodeReader_;
+    Ref<Reader> dataMatrixReader_;
+    Ref<Reader> aztecReader_;
+    Ref<Reader> pdf417Reader_;
+    Ref<PresenceGate> presenceGate_;
 
   public:
     MultiFormatReader();
@@ -41,6 +56,11 @@ namespace zxing {
     Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
     Ref<Result> decodeWithState(Ref<BinaryBitmap> image);
     void setHints(DecodeHints hints);
+    // Images the gate finds no barcode-like texture in fail straight away,
+    // without going through the readers. None by default.
+    void setPresenceGate(Ref<PresenceGate> gate);
+    // A new reader with a copy of the presence gate, if any.
+    Ref<Reader> cloneReader() const;
     ~MultiFormatReader();
   };
 }
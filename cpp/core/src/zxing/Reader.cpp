@@ -28,4 +28,8 @@ Ref<Result> Reader::decode(Ref<BinaryBitmap> image) {
   return decode(image, DecodeHints::DEFAULT_HINT);
 }
 
+Ref<Reader> Reader::cloneReader() const {
+  return Ref<Reader>();
+}
+
 }
@@ -32,6 +32,11 @@ namespace zxing {
   public:
    virtual Ref<Result> decode(Ref<BinaryBitmap> image);
    virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints) = 0;
+   // Returns a new reader configured like this one that shares no state with
+   // it, so that parts of an image can be decoded on several threads at once
+   // (see multi::RegionSearch). Readers that return an empty Ref, as this
+   // default does, only decode on the calling thread.
+   virtual Ref<Reader> cloneReader() const;
    virtual ~Reader();
 };
 
@@ -30,9 +30,9 @@ using zxing::ResultPoint;
 // VC++
 using zxing::BarcodeFormat;
 
-Result::Result(Ref<String> text,
-               ArrayRef<char> rawBytes,
-               ArrayRef< Ref<ResultPoint> > resultPoints,
+Result::Result(Ref<String> const& text,
+               ArrayRef<char> const& rawBytes,
+               ArrayRef< Ref<ResultPoint> > const& resultPoints,
                BarcodeFormat format) :
   text_(text), rawBytes_(rawBytes), resultPoints_(resultPoints), format_(format) {
 }
@@ -40,11 +40,11 @@ Result::Result(Ref<String> text,
 Result::~Result() {
 }
 
-Ref<String> Result::getText() {
+Ref<String> const& Result::getText() {
   return text_;
 }
 
-ArrayRef<char> Result::getRawBytes() {
+ArrayRef<char> const& Result::getRawBytes() {
   return rawBytes_;
 }
 
@@ -37,13 +37,13 @@ private:
   BarcodeFormat format_;
 
 public:
-  Result(Ref<String> text,
-         ArrayRef<char> rawBytes,
-         ArrayRef< Ref<ResultPoint> > resultPoints,
+  Result(Ref<String> const& text,
+         ArrayRef<char> const& rawBytes,
+         ArrayRef< Ref<ResultPoint> > const& resultPoints,
          BarcodeFormat format);
   ~Result();
-  Ref<String> getText();
-  ArrayRef<char> getRawBytes();
+  Ref<String> const& getText();
+  ArrayRef<char> const& getRawBytes();
   ArrayRef< Ref<ResultPoint> > const& getResultPoints() const;
   ArrayRef< Ref<ResultPoint> >& getResultPoints();
   BarcodeFormat getBarcodeFormat() const;
@@ -87,7 +87,7 @@ void ResultPoint::orderBestPatterns(std::vector<Ref<ResultPoint> > &patterns) {
     patterns[2] = pointC;
 }
 
-  float ResultPoint::distance(Ref<ResultPoint> pattern1, Ref<ResultPoint> pattern2) {
+  float ResultPoint::distance(RefView<ResultPoint> pattern1, RefView<ResultPoint> pattern2) {
   return MathUtils::distance(pattern1->posX_,
                              pattern1->posY_,
                              pattern2->posX_,
@@ -100,7 +100,7 @@ float ResultPoint::distance(float x1, float x2, float y1, float y2) {
   return (float) sqrt((double) (xDiff * xDiff + yDiff * yDiff));
 }
 
-float ResultPoint::crossProductZ(Ref<ResultPoint> pointA, Ref<ResultPoint> pointB, Ref<ResultPoint> pointC) {
+float ResultPoint::crossProductZ(RefView<ResultPoint> pointA, RefView<ResultPoint> pointB, RefView<ResultPoint> pointC) {
   float bX = pointB->getX();
   float bY = pointB->getY();
   return ((pointC->getX() - bX) * (pointA->getY() - bY)) - ((pointC->getY() - bY) * (pointA->getX() - bX));
@@ -43,11 +43,11 @@ public:
   bool equals(Ref<ResultPoint> other);
 
   static void orderBestPatterns(std::vector<Ref<ResultPoint> > &patterns);
-  static float distance(Ref<ResultPoint> point1, Ref<ResultPoint> point2);
+  static float distance(RefView<ResultPoint> point1, RefView<ResultPoint> point2);
   static float distance(float x1, float x2, float y1, float y2);
 
 private:
-  static float crossProductZ(Ref<ResultPoint> pointA, Ref<ResultPoint> pointB, Ref<ResultPoint> pointC);
+  static float crossProductZ(RefView<ResultPoint> pointA, RefView<ResultPoint> pointB, RefView<ResultPoint> pointC);
 };
 
 }
@@ -0,0 +1,94 @@
+#ifndef __STATIC_MULTI_FORMAT_READER_H__
+#define __STATIC_MULTI_FORMAT_READER_H__
+
+/*
+ *  StaticMultiFormatReader.h
+ *  ZXing
+ *
+ *  Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/Reader.h>
+#include <zxing/ReaderException.h>
+
+namespace zxing {
+
+/**
+ * Marks an unused reader slot of a StaticMultiFormatReader.
+ */
+class NoReader {
+};
+
+/**
+ * A MultiFormatReader whose readers are fixed at compile time, e.g.
+ *
+ *   StaticMultiFormatReader<qrcode::QRCodeReader,
+ *                           pdf417::PDF417Reader,
+ *                           aztec::AztecReader> reader;
+ *
+ * The readers are held by value and tried in argument order. Each one is
+ * called directly rather than through Ref<Reader>, so there is no virtual
+ * dispatch between this reader and the decoders and only the named readers
+ * are linked in. Unlike MultiFormatReader, the format hints are not
+ * consulted; all other hints are passed on to every reader.
+ */
+template<class R1, class R2 = NoReader, class R3 = NoReader,
+         class R4 = NoReader, class R5 = NoReader>
+class StaticMultiFormatReader : public Reader {
+private:
+  R1 reader1_;
+  R2 reader2_;
+  R3 reader3_;
+  R4 reader4_;
+  R5 reader5_;
+
+  template<class R>
+  static bool tryDecode(R& reader, Ref<BinaryBitmap> const& image,
+                        DecodeHints const& hints, Ref<Result>& result) {
+    try {
+      result = reader.R::decode(image, hints);
+      return true;
+    } catch (ReaderException const& re) {
+      (void)re;
+      return false;
+    }
+  }
+
+  static bool tryDecode(NoReader&, Ref<BinaryBitmap> const&,
+                        DecodeHints const&, Ref<Result>&) {
+    return false;
+  }
+
+public:
+  Ref<Result> decode(Ref<BinaryBitmap> image) {
+    return StaticMultiFormatReader::decode(image, DecodeHints::DEFAULT_HINT);
+  }
+
+  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+    Ref<Result> result;
+    if (tryDecode(reader1_, image, hints, result) ||
+        tryDecode(reader2_, image, hints, result) ||
+        tryDecode(reader3_, image, hints, result) ||
+        tryDecode(reader4_, image, hints, result) ||
+        tryDecode(reader5_, image, hints, result)) {
+      return result;
+    }
+    throw ReaderException("No code detected");
+  }
+};
+
+}
+
+#endif
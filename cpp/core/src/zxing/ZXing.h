@@ -30,6 +30,13 @@
 #define ZXING_DEBUG 0
 #endif
 
+// Formats can be left out of the build with NO_<FORMAT> (see ZXING_FORMATS
+// in CMakeLists.txt); without any 1D format there is no 1D reader at all.
+#if defined(NO_UPC_EAN) && defined(NO_CODE_39) && defined(NO_CODE_93) && \
+    defined(NO_CODE_128) && defined(NO_ITF) && defined(NO_CODABAR)
+#define NO_ONED 1
+#endif
+
 namespace zxing {
 typedef char byte;
 typedef bool boolean;
@@ -22,29 +22,66 @@
 #include <zxing/aztec/AztecReader.h>
 #include <zxing/aztec/detector/Detector.h>
 #include <zxing/common/DecoderResult.h>
+#include <zxing/NotFoundException.h>
 #include <iostream>
 
 using zxing::Ref;
 using zxing::ArrayRef;
 using zxing::Result;
+using zxing::BitMatrix;
+using zxing::NotFoundException;
+using zxing::ReaderException;
 using zxing::aztec::AztecReader;
 
 // VC++
 using zxing::BinaryBitmap;
 using zxing::DecodeHints;
+using zxing::Reader;
         
 AztecReader::AztecReader() : decoder_() {
   // nothing
 }
         
 Ref<Result> AztecReader::decode(Ref<zxing::BinaryBitmap> image) {
-  Detector detector(image->getBlackMatrix());
-            
-  Ref<AztecDetectorResult> detectorResult(detector.detect());
-            
-  ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
-            
-  Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult));
+  return decode(image, DecodeHints::DEFAULT_HINT);
+}
+        
+Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+  Ref<BitMatrix> matrix(image->getBlackMatrix());
+  if (hints.getPureBarcode()) {
+    // Aztec symbols have no corner finder to read the module size from, but
+    // in a pure image the bull's eye sits exactly in the middle of the black
+    // pixels, so the detector does not need to search for it.
+    ArrayRef<int> rectangle = matrix->getEnclosingRectangle();
+    if (!rectangle) {
+      throw NotFoundException("AztecReader: no black pixels");
+    }
+    hints.setRegionOfInterest(rectangle[0], rectangle[1], rectangle[2], rectangle[3]);
+  }
+  Detector detector(matrix);
+  ArrayRef< Ref<ResultPoint> > points;
+  Ref<DecoderResult> decoderResult;
+  int scale = 1;
+  Ref<BinaryBitmap> coarse;
+  if (hints.getCoarseDetection()) {
+    coarse = image->getCoarseLevel(scale);
+  }
+  if (scale > 1) {
+    try {
+      Detector fineDetector(image->getFineBlackMatrix());
+      Ref<AztecDetectorResult> detectorResult(
+        fineDetector.detect(hints, coarse->getBlackMatrix(), scale));
+      points = detectorResult->getPoints();
+      decoderResult = decoder_.decode(detectorResult);
+    } catch (ReaderException const&) {
+      // Perhaps the bull's eye is too small to find scaled down.
+    }
+  }
+  if (!decoderResult) {
+    Ref<AztecDetectorResult> detectorResult(detector.detect(hints));
+    points = detectorResult->getPoints();
+    decoderResult = decoder_.decode(detectorResult);
+  }
             
   Ref<Result> result(new Result(decoderResult->getText(),
                                 decoderResult->getRawBytes(),
@@ -54,9 +91,8 @@ Ref<Result> AztecReader::decode(Ref<zxing::BinaryBitmap> image) {
   return result;
 }
         
-Ref<Result> AztecReader::decode(Ref<BinaryBitmap> image, DecodeHints) {
-  //cout << "decoding with hints not supported for aztec" << "\n" << flush;
-  return this->decode(image);
+Ref<Reader> AztecReader::cloneReader() const {
+  return Ref<Reader>(new AztecReader());
 }
         
 AztecReader::~AztecReader() {
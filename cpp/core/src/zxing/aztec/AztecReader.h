@@ -40,6 +40,7 @@ class AztecReader : public Reader {
   AztecReader();
   virtual Ref<Result> decode(Ref<BinaryBitmap> image);
   virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual Ref<Reader> cloneReader() const;
   virtual ~AztecReader();
 };
         
@@ -20,9 +20,6 @@
  */
 
 #include <zxing/aztec/decoder/Decoder.h>
-#ifndef NO_ICONV
-#include <iconv.h>
-#endif
 #include <iostream>
 #include <zxing/FormatException.h>
 #include <zxing/common/reedsolomon/ReedSolomonDecoder.h>
@@ -30,33 +27,23 @@
 #include <zxing/common/reedsolomon/GenericGF.h>
 #include <zxing/common/IllegalArgumentException.h>
 #include <zxing/common/DecoderResult.h>
+#include <zxing/common/StringUtils.h>
 
 using zxing::aztec::Decoder;
 using zxing::DecoderResult;
 using zxing::String;
 using zxing::BitArray;
 using zxing::BitMatrix;
+using zxing::BitSource;
+using zxing::ArrayRef;
 using zxing::Ref;
+using zxing::common::StringUtils;
 
 using std::string;
 
 namespace {
   void add(string& result, char character) {
-#ifndef NO_ICONV
-    char s[] = { character & 0xff };
-    char* ss = s;
-    size_t sl = sizeof(s);
-    char d[4];
-    char* ds = d;
-    size_t dl = sizeof(d);
-    iconv_t ic = iconv_open("UTF-8", "ISO-8859-1");
-    iconv(ic, &ss, &sl, &ds, &dl);
-    iconv_close(ic);
-    d[sizeof(d)-dl] = 0;
-    result.append(d);
-#else
-    result.push_back(character);
-#endif
+    StringUtils::appendUTF8(result, &character, 1, StringUtils::ISO88591);
   }
 
   const int NB_BITS_COMPACT[] = {
@@ -77,67 +64,47 @@ namespace {
     940, 1020, 920, 992, 1066, 1144, 1224, 1306, 1392, 1480, 1570, 1664
   };
         
-  const char* UPPER_TABLE[] = {
-    "CTRL_PS", " ", "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M", "N", "O", "P",
-    "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z", "CTRL_LL", "CTRL_ML", "CTRL_DL", "CTRL_BS"
-  };
-        
-  const char* LOWER_TABLE[] = {
-    "CTRL_PS", " ", "a", "b", "c", "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p",
-    "q", "r", "s", "t", "u", "v", "w", "x", "y", "z", "CTRL_US", "CTRL_ML", "CTRL_DL", "CTRL_BS"
-  };
-        
-  const char* MIXED_TABLE[] = {
-    "CTRL_PS", " ", "\1", "\2", "\3", "\4", "\5", "\6", "\7", "\b", "\t", "\n",
-    "\13", "\f", "\r", "\33", "\34", "\35", "\36", "\37", "@", "\\", "^", "_",
-    "`", "|", "~", "\177", "CTRL_LL", "CTRL_UL", "CTRL_PL", "CTRL_BS"
-  };
-        
-  const char* PUNCT_TABLE[] = {
-    "", "\r", "\r\n", ". ", ", ", ": ", "!", "\"", "#", "$", "%", "&", "'", "(", ")",
-    "*", "+", ",", "-", ".", "/", ":", ";", "<", "=", ">", "?", "[", "]", "{", "}", "CTRL_UL"
-  };
-        
-  const char* DIGIT_TABLE[] = {
-    "CTRL_PS", " ", "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", ",", ".", "CTRL_UL", "CTRL_US"
-  };
-}
-        
-Decoder::Table Decoder::getTable(char t) {
-  switch (t) {
-  case 'L':
-    return LOWER;
-  case 'P':
-    return PUNCT;
-  case 'M':
-    return MIXED;
-  case 'D':
-    return DIGIT;
-  case 'B':
-    return BINARY;
-  case 'U':
-  default:
-    return UPPER;
-  }
 }
-        
-const char* Decoder::getCharacter(zxing::aztec::Decoder::Table table, int code) {
-  switch (table) {
-  case UPPER:
-    return UPPER_TABLE[code];
-  case LOWER:
-    return LOWER_TABLE[code];
-  case MIXED:
-    return MIXED_TABLE[code];
-  case PUNCT:
-    return PUNCT_TABLE[code];
-  case DIGIT:
-    return DIGIT_TABLE[code];
-  default:
-    return "";
+
+// Entries are one character, two characters with the second in the high
+// byte, or a table switch.
+#define CONTROL 0x10000
+#define SHIFT_FLAG 0x100
+#define LATCH(TABLE) (CONTROL | TABLE)
+#define SHIFT(TABLE) (CONTROL | SHIFT_FLAG | TABLE)
+#define PAIR(A, B) (A | (B << 8))
+
+const int Decoder::CODE_TABLES[5][32] = {
+  { // UPPER
+    SHIFT(PUNCT), ' ', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N',
+    'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z',
+    LATCH(LOWER), LATCH(MIXED), LATCH(DIGIT), SHIFT(BINARY)
+  },
+  { // LOWER
+    SHIFT(PUNCT), ' ', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
+    'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z',
+    SHIFT(UPPER), LATCH(MIXED), LATCH(DIGIT), SHIFT(BINARY)
+  },
+  { // MIXED
+    SHIFT(PUNCT), ' ', 1, 2, 3, 4, 5, 6, 7, '\b', '\t', '\n', 11, '\f', '\r', 27,
+    28, 29, 30, 31, '@', '\\', '^', '_', '`', '|', '~', 127,
+    LATCH(LOWER), LATCH(UPPER), LATCH(PUNCT), SHIFT(BINARY)
+  },
+  { // DIGIT, four bit codes
+    SHIFT(PUNCT), ' ', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ',', '.',
+    LATCH(UPPER), SHIFT(UPPER)
+  },
+  { // PUNCT
+    0, '\r', PAIR('\r', '\n'), PAIR('.', ' '), PAIR(',', ' '), PAIR(':', ' '), '!', '"',
+    '#', '$', '%', '&', '\'', '(', ')', '*', '+', ',', '-', '.', '/', ':', ';', '<',
+    '=', '>', '?', '[', ']', '{', '}', LATCH(UPPER)
   }
-}
-        
+};
+
+#undef PAIR
+#undef SHIFT
+#undef LATCH
+
 Decoder::Decoder() {
   // nothing
 }
@@ -158,33 +125,30 @@ Ref<DecoderResult> Decoder::decode(Ref<zxing::aztec::AztecDetectorResult> detect
   Ref<BitArray> rawbits = extractBits(matrix);
             
   // std::printf("correcting bits\n");
-  Ref<BitArray> aCorrectedBits = correctBits(rawbits);
+  ArrayRef<char> correctedBits = correctBits(rawbits);
             
   // std::printf("decoding bits\n");
-  Ref<String> result = getEncodedData(aCorrectedBits);
-            
-  // std::printf("constructing array\n");
-  ArrayRef<char> arrayOut(aCorrectedBits->getSize());
-  for (int i = 0; i < aCorrectedBits->count(); i++) {
-    arrayOut[i] = (char)aCorrectedBits->get(i);
-  }
+  Ref<String> result = getEncodedData(correctedBits);
             
   // std::printf("returning\n");
             
-  return Ref<DecoderResult>(new DecoderResult(arrayOut, result));
+  return Ref<DecoderResult>(new DecoderResult(correctedBits, result));
 }
         
-Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
+Ref<String> Decoder::getEncodedData(ArrayRef<char> const& correctedBits) {
   int endIndex = codewordSize_ * ddata_->getNBDatablocks() - invertedBitCount_;
-  if (endIndex > (int)correctedBits->getSize()) {
+  if (endIndex > 8 * correctedBits->size()) {
     // std::printf("invalid input\n");
     throw FormatException("invalid input data");
   }
             
+  BitSource bits(correctedBits);
+  int remaining = endIndex;
   Table lastTable = UPPER;
   Table table = UPPER;
-  int startIndex = 0;
   std::string result;
+  // Punctuation pairs take two characters per five bits.
+  result.reserve(endIndex * 2 / 5);
   bool end = false;
   bool shift = false;
   bool switchShift = false;
@@ -201,38 +165,40 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
                 
     int code;
     if (binaryShift) {
-      if (endIndex - startIndex < 5) {
+      if (remaining < 5) {
         break;
       }
                     
-      int length = readCode(correctedBits, startIndex, 5);
-      startIndex += 5;
+      int length = readCode(bits, 5);
+      remaining -= 5;
       if (length == 0) {
-        if (endIndex - startIndex < 11) {
+        if (remaining < 11) {
           break;
         }
                         
-        length = readCode(correctedBits, startIndex, 11) + 31;
-        startIndex += 11;
+        length = readCode(bits, 11) + 31;
+        remaining -= 11;
       }
+      string bytes;
       for (int charCount = 0; charCount < length; charCount++) {
-        if (endIndex - startIndex < 8) {
+        if (remaining < 8) {
           end = true;
           break;
         }
                         
-        code = readCode(correctedBits, startIndex, 8);
-        add(result, code);
-        startIndex += 8;
+        code = readCode(bits, 8);
+        bytes += (char) code;
+        remaining -= 8;
       }
+      StringUtils::appendUTF8(result, bytes.data(), bytes.size(), StringUtils::ISO88591);
       binaryShift = false;
     } else {
       if (table == BINARY) {
-        if (endIndex - startIndex < 8) {
+        if (remaining < 8) {
           break;
         }
-        code = readCode(correctedBits, startIndex, 8);
-        startIndex += 8;
+        code = readCode(bits, 8);
+        remaining -= 8;
                         
         add(result, code);
       } else {
@@ -242,26 +208,27 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
           size = 4;
         }
                         
-        if (endIndex - startIndex < size) {
+        if (remaining < size) {
           break;
         }
                         
-        code = readCode(correctedBits, startIndex, size);
-        startIndex += size;
+        code = readCode(bits, size);
+        remaining -= size;
                         
-        const char *str = getCharacter(table, code);
-        std::string string(str);
-        if ((int)string.find("CTRL_") != -1) {
-          table = getTable(str[5]);
-                            
-          if (str[6] == 'S') {
+        int entry = CODE_TABLES[table][code];
+        if (entry & CONTROL) {
+          table = (Table) (entry & 7);
+          if (entry & SHIFT_FLAG) {
             shift = true;
-            if (str[5] == 'B') {
+            if (table == BINARY) {
               binaryShift = true;
             }
           }
-        } else {
-          result.append(string);
+        } else if (entry) {
+          result += (char) entry;
+          if (entry >> 8) {
+            result += (char) (entry >> 8);
+          }
         }
                         
       }
@@ -276,28 +243,31 @@ Ref<String> Decoder::getEncodedData(Ref<zxing::BitArray> correctedBits) {
                 
   }
             
-  return Ref<String>(new String(result));
+  return String::adopt(result);
             
 }
+
+#undef SHIFT_FLAG
+#undef CONTROL
         
-Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
+ArrayRef<char> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
   //return rawbits;
   // std::printf("decoding stuff:%d datablocks in %d layers\n", ddata_->getNBDatablocks(), ddata_->getNBLayers());
             
-  Ref<GenericGF> gf = GenericGF::AZTEC_DATA_6;
+  Ref<GenericGF> gf = GenericGF::AZTEC_DATA_6();
             
   if (ddata_->getNBLayers() <= 2) {
     codewordSize_ = 6;
-    gf = GenericGF::AZTEC_DATA_6;
+    gf = GenericGF::AZTEC_DATA_6();
   } else if (ddata_->getNBLayers() <= 8) {
     codewordSize_ = 8;
-    gf = GenericGF::AZTEC_DATA_8;
+    gf = GenericGF::AZTEC_DATA_8();
   } else if (ddata_->getNBLayers() <= 22) {
     codewordSize_ = 10;
-    gf = GenericGF::AZTEC_DATA_10;
+    gf = GenericGF::AZTEC_DATA_10();
   } else {
     codewordSize_ = 12;
-    gf = GenericGF::AZTEC_DATA_12;
+    gf = GenericGF::AZTEC_DATA_12();
   }
             
   int numDataCodewords = ddata_->getNBDatablocks();
@@ -343,7 +313,7 @@ Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
   offset = 0;
   invertedBitCount_ = 0;
             
-  Ref<BitArray> correctedBits(new BitArray(numDataCodewords * codewordSize_));
+  ArrayRef<char> correctedBits((numDataCodewords * codewordSize_ + 7) / 8);
   for (int i = 0; i < numDataCodewords; i++) {
                 
     bool seriesColor = false;
@@ -374,7 +344,10 @@ Ref<BitArray> Decoder::correctBits(Ref<zxing::BitArray> rawbits) {
           seriesColor = color;
         }
                         
-        if (color) correctedBits->set(i * codewordSize_ + j - offset);
+        if (color) {
+          int bit = i * codewordSize_ + j - offset;
+          correctedBits[bit >> 3] |= (char) (0x80 >> (bit & 7));
+        }
                         
       }
                     
@@ -474,15 +447,8 @@ Ref<BitMatrix> Decoder::removeDashedLines(Ref<zxing::BitMatrix> matrix) {
   return newMatrix;
 }
         
-int Decoder::readCode(Ref<zxing::BitArray> rawbits, int startIndex, int length) {
-  int res = 0;
-            
-  for (int i = startIndex; i < startIndex + length; i++) {
-    res <<= 1;
-    if (rawbits->get(i)) {
-      res ++;
-    }
-  }
-            
-  return res;
+int Decoder::readCode(BitSource& bits, int length) {
+  int code = bits.peekBits(length);
+  bits.skipBits(length);
+  return code;
 }
@@ -23,6 +23,7 @@
 #define __ZXING_AZTEC_DECODER_DECODER_H__
 
 #include <zxing/common/BitMatrix.h>
+#include <zxing/common/BitSource.h>
 #include <zxing/common/Str.h>
 #include <zxing/aztec/AztecDetectorResult.h>
 
@@ -43,19 +44,18 @@ class Decoder : public Counted {
     BINARY
   };
             
-  static Table getTable(char t);
-  static const char* getCharacter(Table table, int code);
+  static const int CODE_TABLES[5][32];
             
   int numCodewords_;
   int codewordSize_;
   Ref<AztecDetectorResult> ddata_;
   int invertedBitCount_;
             
-  Ref<String> getEncodedData(Ref<BitArray> correctedBits);
-  Ref<BitArray> correctBits(Ref<BitArray> rawbits);
+  Ref<String> getEncodedData(ArrayRef<char> const& correctedBits);
+  ArrayRef<char> correctBits(Ref<BitArray> rawbits);
   Ref<BitArray> extractBits(Ref<BitMatrix> matrix);
   static Ref<BitMatrix> removeDashedLines(Ref<BitMatrix> matrix);
-  static int readCode(Ref<BitArray> rawbits, int startIndex, int length);
+  static int readCode(BitSource& bits, int length);
             
             
  public:
@@ -39,18 +39,53 @@ using zxing::ResultPoint;
 using zxing::BitArray;
 using zxing::BitMatrix;
 using zxing::common::detector::MathUtils;
+using zxing::DecodeHints;
+
+namespace {
+// Initial size of the white rectangle searched for around the center
+const int INIT_SIZE = 30;
+}
 
 Detector::Detector(Ref<BitMatrix> image):
   image_(image),
   nbLayers_(0),
   nbDataBlocks_(0),
-  nbCenterLayers_(0) {
+  nbCenterLayers_(0),
+  searchCenterX_(image->getWidth() / 2),
+  searchCenterY_(image->getHeight() / 2) {
         
 }
+
+Ref<AztecDetectorResult> Detector::detect(DecodeHints const& hints) {
+  setSearchCenter(hints);
+  return detect();
+}
+
+Ref<AztecDetectorResult> Detector::detect(DecodeHints const& hints, Ref<BitMatrix> coarse,
+                                          int scale) {
+  Detector finder(coarse);
+  finder.setSearchCenter(hints.scaleDown(scale));
+  Ref<Point> center = finder.getMatrixCenter();
+  return detect(Ref<Point>(new Point(center->getX() * scale + scale / 2,
+                                     center->getY() * scale + scale / 2)));
+}
+
+void Detector::setSearchCenter(DecodeHints const& hints) {
+  if (hints.hasRegionOfInterest()) {
+    // Look for the bull's eye around the center of the region of interest
+    // rather than the center of the image.
+    int left, top, right, bottom;
+    hints.getRegionOfInterest(image_->getWidth(), image_->getHeight(), left, top, right, bottom);
+    searchCenterX_ = (left + right) / 2;
+    searchCenterY_ = (top + bottom) / 2;
+  }
+}
         
 Ref<AztecDetectorResult> Detector::detect() {
-  Ref<Point> pCenter = getMatrixCenter();
-            
+  return detect(getMatrixCenter());
+}
+
+Ref<AztecDetectorResult> Detector::detect(Ref<Point> pCenter) {
   std::vector<Ref<Point> > bullEyeCornerPoints = getBullEyeCornerPoints(pCenter);
             
   extractParameters(bullEyeCornerPoints);
@@ -167,13 +202,12 @@ Detector::getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints) {
       !isValid(targetdx, targetdy)) {
     throw ReaderException("matrix extends over image bounds");
   }
-  Array< Ref<ResultPoint> >* array = new Array< Ref<ResultPoint> >();
-  vector< Ref<ResultPoint> >& returnValue (array->values());
-  returnValue.push_back(Ref<ResultPoint>(new ResultPoint(float(targetax), float(targetay))));
-  returnValue.push_back(Ref<ResultPoint>(new ResultPoint(float(targetbx), float(targetby))));
-  returnValue.push_back(Ref<ResultPoint>(new ResultPoint(float(targetcx), float(targetcy))));
-  returnValue.push_back(Ref<ResultPoint>(new ResultPoint(float(targetdx), float(targetdy))));
-  return ArrayRef< Ref<ResultPoint> >(array);
+  ArrayRef< Ref<ResultPoint> > returnValue(4);
+  returnValue[0] = Ref<ResultPoint>(new ResultPoint(float(targetax), float(targetay)));
+  returnValue[1] = Ref<ResultPoint>(new ResultPoint(float(targetbx), float(targetby)));
+  returnValue[2] = Ref<ResultPoint>(new ResultPoint(float(targetcx), float(targetcy)));
+  returnValue[3] = Ref<ResultPoint>(new ResultPoint(float(targetdx), float(targetdy)));
+  return returnValue;
 }
         
 void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool compact) {
@@ -190,7 +224,7 @@ void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool com
             
   int numECCodewords = numCodewords - numDataCodewords;
             
-  ArrayRef<int> parameterWords(new Array<int>(numCodewords));
+  ArrayRef<int> parameterWords(numCodewords);
             
   int codewordSize = 4;
   for (int i = 0; i < numCodewords; i++) {
@@ -205,7 +239,7 @@ void Detector::correctParameterData(Ref<zxing::BitArray> parameterData, bool com
                         
   try {
     // std::printf("parameter data reed solomon\n");
-    ReedSolomonDecoder rsDecoder(GenericGF::AZTEC_PARAM);
+    ReedSolomonDecoder rsDecoder(GenericGF::AZTEC_PARAM());
     rsDecoder.decode(parameterWords, numECCodewords);
   } catch (ReedSolomonException const& ignored) {
     (void)ignored;
@@ -305,7 +339,8 @@ Ref<Point> Detector::getMatrixCenter() {
   Ref<ResultPoint> pointA, pointB, pointC, pointD;
   try {
                 
-    std::vector<Ref<ResultPoint> > cornerPoints = WhiteRectangleDetector(image_).detect();
+    std::vector<Ref<ResultPoint> > cornerPoints =
+      WhiteRectangleDetector(image_, INIT_SIZE, searchCenterX_, searchCenterY_).detect();
     pointA = cornerPoints[0];
     pointB = cornerPoints[1];
     pointC = cornerPoints[2];
@@ -314,8 +349,8 @@ Ref<Point> Detector::getMatrixCenter() {
   } catch (NotFoundException const& e) {
     (void)e;
                 
-    int cx = image_->getWidth() / 2;
-    int cy = image_->getHeight() / 2;
+    int cx = searchCenterX_;
+    int cy = searchCenterY_;
                 
     pointA = getFirstDifferent(Ref<Point>(new Point(cx+7, cy-7)), false,  1, -1)->toResultPoint();
     pointB = getFirstDifferent(Ref<Point>(new Point(cx+7, cy+7)), false,  1,  1)->toResultPoint();
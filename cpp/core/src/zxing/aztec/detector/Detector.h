@@ -59,7 +59,11 @@ class Detector : public Counted {
   int nbDataBlocks_;
   int nbCenterLayers_;
   int shift_;
+  int searchCenterX_;
+  int searchCenterY_;
             
+  void setSearchCenter(DecodeHints const& hints);
+  Ref<AztecDetectorResult> detect(Ref<Point> pCenter);
   void extractParameters(std::vector<Ref<Point> > bullEyeCornerPoints);
   ArrayRef< Ref<ResultPoint> > getMatrixCornerPoints(std::vector<Ref<Point> > bullEyeCornerPoints);
   static void correctParameterData(Ref<BitArray> parameterData, bool compact);
@@ -84,6 +88,10 @@ class Detector : public Counted {
  public:
   Detector(Ref<BitMatrix> image);
   Ref<AztecDetectorResult> detect();
+  Ref<AztecDetectorResult> detect(DecodeHints const& hints);
+  // Finds the bull's eye on coarse, this image scaled down by scale, and
+  // reads everything around it here.
+  Ref<AztecDetectorResult> detect(DecodeHints const& hints, Ref<BitMatrix> coarse, int scale);
 };
 
 }
@@ -21,46 +21,169 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 #include <zxing/common/Counted.h>
 
 namespace zxing {
 
+/* a pointer and a length: the view of an Array's elements returned by
+   Array::values() */
+template<typename T> class Span {
+private:
+  T *data_;
+  int size_;
+public:
+  Span(T *data, int size) :
+      data_(data), size_(size) {
+  }
+  T* data() const {
+    return data_;
+  }
+  int size() const {
+    return size_;
+  }
+  bool empty() const {
+    return size_ == 0;
+  }
+  T* begin() const {
+    return data_;
+  }
+  T* end() const {
+    return data_ + size_;
+  }
+  T& operator[](int i) const {
+    return data_[i];
+  }
+};
+
+/* Arrays made through create() (and so through ArrayRef(n)) keep their
+   elements directly after the header, in the same allocation; the
+   public constructors put them in a separate block. */
 template<typename T> class Array : public Counted {
-protected:
+private:
+  struct Inline {};
+  T *values_;
+  int size_;
+  // Whether values_ is the storage after the header rather than a block
+  // of its own; told apart by how it was made, since a separate block
+  // could also happen to start right after the header.
+  bool inline_;
+
+  static size_t headerSize() {
+    // keep the elements aligned for any fundamental type
+    return (sizeof(Array<T>) + 15) & ~(size_t) 15;
+  }
+  T* inlineValues() {
+    return reinterpret_cast<T*>(reinterpret_cast<char*>(this) + headerSize());
+  }
+  Array(Inline, int n) :
+      Counted(), values_(inlineValues()), size_(n), inline_(true) {
+    std::uninitialized_fill_n(values_, n, T());
+  }
+  Array(Inline, T const* ts, int n) :
+      Counted(), values_(inlineValues()), size_(n), inline_(true) {
+    std::uninitialized_copy(ts, ts + n, values_);
+  }
+  void allocate(int n) {
+    values_ = n == 0 ? 0 : static_cast<T*>(::operator new(n * sizeof(T)));
+    size_ = n;
+    inline_ = false;
+  }
+  void clear() {
+    for (int i = 0; i < size_; i++) {
+      values_[i].~T();
+    }
+    if (!inline_) {
+      ::operator delete(values_);
+    }
+    values_ = 0;
+    size_ = 0;
+  }
+  void assign(T const* ts, int n) {
+    if (n == size_) {
+      std::copy(ts, ts + n, values_);
+    } else {
+      clear();
+      allocate(n);
+      std::uninitialized_copy(ts, ts + n, values_);
+    }
+  }
+
 public:
-  std::vector<T> values_;
-  Array() {}
+  Array() :
+      Counted(), values_(0), size_(0), inline_(false) {
+  }
   Array(int n) :
-      Counted(), values_(n, T()) {
+      Counted() {
+    allocate(n);
+    std::uninitialized_fill_n(values_, n, T());
   }
   Array(T const* ts, int n) :
-      Counted(), values_(ts, ts+n) {
+      Counted() {
+    allocate(n);
+    std::uninitialized_copy(ts, ts + n, values_);
   }
   Array(T const* ts, T const* te) :
-      Counted(), values_(ts, te) {
+      Counted() {
+    allocate((int) (te - ts));
+    std::uninitialized_copy(ts, te, values_);
   }
   Array(T v, int n) :
-      Counted(), values_(n, v) {
+      Counted() {
+    allocate(n);
+    std::uninitialized_fill_n(values_, n, v);
   }
-  Array(std::vector<T> &v) :
-      Counted(), values_(v) {
+  Array(std::vector<T> const& v) :
+      Counted() {
+    allocate((int) v.size());
+    std::uninitialized_copy(v.begin(), v.end(), values_);
   }
   Array(Array<T> &other) :
-      Counted(), values_(other.values_) {
+      Counted() {
+    allocate(other.size_);
+    std::uninitialized_copy(other.values_, other.values_ + size_, values_);
   }
   Array(Array<T> *other) :
-      Counted(), values_(other->values_) {
+      Counted() {
+    allocate(other->size_);
+    std::uninitialized_copy(other->values_, other->values_ + size_, values_);
   }
   virtual ~Array() {
+    clear();
+  }
+
+  static Array<T>* create(int n) {
+    return new (n) Array<T>(Inline(), n);
+  }
+  static Array<T>* create(T const* ts, int n) {
+    return new (n) Array<T>(Inline(), ts, n);
+  }
+
+  static void* operator new(size_t size) {
+    return ::operator new(size);
   }
+  static void* operator new(size_t, int n) {
+    return ::operator new(headerSize() + n * sizeof(T));
+  }
+  static void operator delete(void *memory) {
+    ::operator delete(memory);
+  }
+  static void operator delete(void *memory, int) {
+    ::operator delete(memory);
+  }
+
   Array<T>& operator=(const Array<T> &other) {
-    values_ = other.values_;
+    if (this != &other) {
+      assign(other.values_, other.size_);
+    }
     return *this;
   }
   Array<T>& operator=(const std::vector<T> &array) {
-    values_ = array;
+    assign(array.empty() ? 0 : &array[0], (int) array.size());
     return *this;
   }
   T const& operator[](int i) const {
@@ -70,16 +193,16 @@ public:
     return values_[i];
   }
   int size() const {
-    return (int) values_.size();
+    return size_;
   }
   bool empty() const {
-    return values_.size() == 0;
+    return size_ == 0;
   }
-  std::vector<T> const& values() const {
-    return values_;
+  Span<T const> values() const {
+    return Span<T const>(values_, size_);
   }
-  std::vector<T>& values() {
-    return values_;
+  Span<T> values() {
+    return Span<T>(values_, size_);
   }
 };
 
@@ -92,11 +215,11 @@ public:
   }
   explicit ArrayRef(int n) :
       array_(0) {
-    reset(new Array<T> (n));
+    reset(Array<T>::create(n));
   }
   ArrayRef(T *ts, int n) :
       array_(0) {
-    reset(new Array<T> (ts, n));
+    reset(Array<T>::create(ts, n));
   }
   ArrayRef(Array<T> *a) :
       array_(0) {
@@ -113,6 +236,13 @@ public:
     reset(static_cast<const Array<T> *>(other.array_));
   }
 
+#if ZXING_HAS_RVALUE_REFERENCES
+  ArrayRef(ArrayRef &&other) :
+      Counted(), array_(other.array_) {
+    other.array_ = 0;
+  }
+#endif
+
   ~ArrayRef() {
     if (array_) {
       array_->release();
@@ -144,6 +274,19 @@ public:
     reset(other);
     return *this;
   }
+#if ZXING_HAS_RVALUE_REFERENCES
+  ArrayRef<T>& operator=(ArrayRef<T> &&other) {
+    if (this != &other) {
+      Array<T> *old = array_;
+      array_ = other.array_;
+      other.array_ = 0;
+      if (old) {
+        old->release();
+      }
+    }
+    return *this;
+  }
+#endif
   ArrayRef<T>& operator=(Array<T> *a) {
     reset(a);
     return *this;
@@ -22,6 +22,7 @@ using zxing::BitArray;
 
 // VC++
 using zxing::Ref;
+using zxing::Span;
 
 int BitArray::makeArraySize(int size) {
   return (size + bitsPerWord-1) >> logBits;
@@ -41,6 +42,32 @@ void BitArray::setBulk(int i, int newBits) {
   bits[i >> logBits] = newBits;
 }
 
+void BitArray::setRange(int start, int end) {
+  if (end < start) {
+    throw IllegalArgumentException();
+  }
+  if (end == start) {
+    return;
+  }
+  end--; // will be easier to treat this as the last actually set bit -- inclusive
+  int firstInt = start >> logBits;
+  int lastInt = end >> logBits;
+  for (int i = firstInt; i <= lastInt; i++) {
+    int firstBit = i > firstInt ? 0 : start & bitsMask;
+    int lastBit = i < lastInt ? (bitsPerWord-1) : end & bitsMask;
+    int mask;
+    if (firstBit == 0 && lastBit == (bitsPerWord-1)) {
+      mask = -1;
+    } else {
+      mask = 0;
+      for (int j = firstBit; j <= lastBit; j++) {
+        mask |= 1 << j;
+      }
+    }
+    bits[i] |= mask;
+  }
+}
+
 void BitArray::clear() {
   int max = bits->size();
   for (int i = 0; i < max; i++) {
@@ -80,7 +107,7 @@ bool BitArray::isRange(int start, int end, bool value) {
   return true;
 }
 
-vector<int>& BitArray::getBitArray() {
+Span<int> BitArray::getBitArray() {
   return bits->values();
 }
 
@@ -95,6 +122,22 @@ void BitArray::reverse() {
   bits = newBits;
 }
 
+void BitArray::invert() {
+  int max = bits->size();
+  int used = size >> logBits;
+  for (int i = 0; i < used; i++) {
+    bits[i] = ~bits[i];
+  }
+  // Bits past the end stay clear, as getNextSet() expects.
+  if ((size & bitsMask) != 0) {
+    bits[used] = ~bits[used] & ((1 << (size & bitsMask)) - 1);
+    used++;
+  }
+  for (int i = used; i < max; i++) {
+    bits[i] = 0;
+  }
+}
+
 BitArray::Reverse::Reverse(Ref<BitArray> array_) : array(array_) {
   array->reverse();
 }
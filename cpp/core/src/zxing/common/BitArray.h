@@ -58,9 +58,11 @@ public:
   void setRange(int start, int end);
   void clear();
   bool isRange(int start, int end, bool value);
-  std::vector<int>& getBitArray();
+  Span<int> getBitArray();
   
   void reverse();
+  // Flips every bit, a word at a time.
+  void invert();
 
   class Reverse {
    private:
@@ -18,6 +18,7 @@
 #include <zxing/common/BitMatrix.h>
 #include <zxing/common/IllegalArgumentException.h>
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -38,6 +39,10 @@ void BitMatrix::init(int width, int height) {
   this->height = height;
   this->rowSize = (width + bitsPerWord - 1) >> logBits;
   bits = ArrayRef<int>(rowSize * height);
+  tileSizePower = 0;
+  tileColumns = 0;
+  tileCount = 0;
+  filledTileCount = 0;
 }
 
 BitMatrix::BitMatrix(int dimension) {
@@ -48,9 +53,49 @@ BitMatrix::BitMatrix(int width, int height) {
   init(width, height);
 }
 
+BitMatrix::BitMatrix(int width, int height, int tileSizePower_, Ref<TileSource> const& source) {
+  init(width, height);
+  int tileSize = 1 << tileSizePower_;
+  tileSizePower = tileSizePower_;
+  tileColumns = (width + tileSize - 1) >> tileSizePower;
+  tileCount = tileColumns * ((height + tileSize - 1) >> tileSizePower);
+  filledTiles.assign(tileCount, 0);
+  tileSource = source;
+}
+
 BitMatrix::~BitMatrix() {}
 
+void BitMatrix::fillNewTile(int x, int y) const {
+  filledTiles[y * tileColumns + x] = 1;
+  tileSource->fillTile(const_cast<BitMatrix&>(*this), x, y);
+  if (++filledTileCount == tileCount) {
+    tileSource = 0;
+  }
+}
+
+void BitMatrix::fillRows(int top, int bottom) const {
+  if (!tileSource) {
+    return;
+  }
+  for (int y = top >> tileSizePower; y <= (bottom - 1) >> tileSizePower; y++) {
+    for (int x = 0; x < tileColumns; x++) {
+      fillTile(x, y);
+    }
+  }
+}
+
+int BitMatrix::getTileCount() const {
+  return tileCount;
+}
+
+int BitMatrix::getFilledTileCount() const {
+  return filledTileCount;
+}
+
 void BitMatrix::flip(int x, int y) {
+  if (tileSource) {
+    fillTile(x >> tileSizePower, y >> tileSizePower);
+  }
   int offset = y * rowSize + (x >> logBits);
   bits[offset] ^= 1 << (x & bitsMask);
 }
@@ -79,6 +124,7 @@ Ref<BitArray> BitMatrix::getRow(int y, Ref<BitArray> row) {
   if (row.empty() || row->getSize() < width) {
     row = new BitArray(width);
   }
+  fillRows(y, y + 1);
   int offset = y * rowSize;
   for (int x = 0; x < rowSize; x++) {
     row->setBulk(x << logBits, bits[offset + x]);
@@ -86,6 +132,55 @@ Ref<BitArray> BitMatrix::getRow(int y, Ref<BitArray> row) {
   return row;
 }
 
+// Fills a tile of the inverted matrix with the flipped bits of the same tile
+// of the original, filling that first.
+class BitMatrix::InvertedTiles : public BitMatrix::TileSource {
+public:
+  InvertedTiles(Ref<BitMatrix> const& original) : original_(original) {}
+
+  void fillTile(BitMatrix& matrix, int x, int y) {
+    original_->fillTile(x, y);
+    int left = x << matrix.tileSizePower;
+    int top = y << matrix.tileSizePower;
+    int right = std::min(left + (1 << matrix.tileSizePower), matrix.width);
+    int bottom = std::min(top + (1 << matrix.tileSizePower), matrix.height);
+    for (int word = left >> logBits; word <= (right - 1) >> logBits; word++) {
+      // The bits of the word that fall in the tile.
+      int from = std::max(left - (word << logBits), 0);
+      int to = right - (word << logBits);
+      if (to > bitsPerWord) {
+        to = bitsPerWord;
+      }
+      unsigned int mask = (to == bitsPerWord ? ~0u : (1u << to) - 1) & ~((1u << from) - 1);
+      for (int row = top; row < bottom; row++) {
+        int offset = row * matrix.rowSize + word;
+        matrix.bits[offset] |= ~original_->bits[offset] & mask;
+      }
+    }
+  }
+
+private:
+  Ref<BitMatrix> original_;
+};
+
+Ref<BitMatrix> BitMatrix::inverted() {
+  if (tileSource) {
+    return Ref<BitMatrix>(new BitMatrix(width, height, tileSizePower,
+                                           Ref<TileSource>(new InvertedTiles(Ref<BitMatrix>(this)))));
+  }
+  Ref<BitMatrix> result (new BitMatrix(width, height));
+  // Bits past the right edge stay clear.
+  unsigned int lastMask = (width & bitsMask) == 0 ? ~0u : (1u << (width & bitsMask)) - 1;
+  for (int y = 0; y < height; y++) {
+    int offset = y * rowSize;
+    for (int x = 0; x < rowSize - 1; x++) {
+      result->bits[offset + x] = ~bits[offset + x];
+    }
+    result->bits[offset + rowSize - 1] = ~bits[offset + rowSize - 1] & lastMask;
+  }
+  return result;
+}
+
 int BitMatrix::getWidth() const {
   return width;
 }
@@ -95,6 +190,7 @@ int BitMatrix::getHeight() const {
 }
 
 ArrayRef<int> BitMatrix::getTopLeftOnBit() const {
+  fillRows(0, height);
   int bitsOffset = 0;
   while (bitsOffset < bits->size() && bits[bitsOffset] == 0) {
     bitsOffset++;
@@ -118,6 +214,7 @@ ArrayRef<int> BitMatrix::getTopLeftOnBit() const {
 }
 
 ArrayRef<int> BitMatrix::getBottomRightOnBit() const {
+  fillRows(0, height);
   int bitsOffset = bits->size() - 1;
   while (bitsOffset >= 0 && bits[bitsOffset] == 0) {
     bitsOffset--;
@@ -141,3 +238,53 @@ ArrayRef<int> BitMatrix::getBottomRightOnBit() const {
   res[1]=y;
   return res;
 }
+
+ArrayRef<int> BitMatrix::getEnclosingRectangle() const {
+  fillRows(0, height);
+  int left = width;
+  int top = height;
+  int right = -1;
+  int bottom = -1;
+
+  for (int y = 0; y < height; y++) {
+    for (int x32 = 0; x32 < rowSize; x32++) {
+      unsigned int theBits = bits[y * rowSize + x32];
+      if (theBits != 0) {
+        if (y < top) {
+          top = y;
+        }
+        if (y > bottom) {
+          bottom = y;
+        }
+        if (x32 * 32 < left) {
+          int bit = 0;
+          while ((theBits << (31 - bit)) == 0) {
+            bit++;
+          }
+          if ((x32 * 32 + bit) < left) {
+            left = x32 * 32 + bit;
+          }
+        }
+        if (x32 * 32 + 31 > right) {
+          int bit = 31;
+          while ((theBits >> bit) == 0) {
+            bit--;
+          }
+          if ((x32 * 32 + bit) > right) {
+            right = x32 * 32 + bit;
+          }
+        }
+      }
+    }
+  }
+
+  if (right < left || bottom < top) {
+    return ArrayRef<int>();
+  }
+  ArrayRef<int> res (4);
+  res[0] = left;
+  res[1] = top;
+  res[2] = right - left + 1;
+  res[3] = bottom - top + 1;
+  return res;
+}
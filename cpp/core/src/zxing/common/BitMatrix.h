@@ -25,6 +25,7 @@
 #include <zxing/common/BitArray.h>
 #include <zxing/common/Array.h>
 #include <limits>
+#include <vector>
 
 namespace zxing {
 
@@ -50,12 +51,29 @@ private:
   static const int bitsMask = (1 << logBits) - 1;
 
 public:
+  // Works out the bits of a matrix one square tile at a time, the first time
+  // something reads them, so that whoever only looks at part of an image
+  // only pays for that part.
+  class TileSource : public Counted {
+  public:
+    // Sets the bits of the tile in column x and row y of tiles. It may only
+    // set bits, never clear them.
+    virtual void fillTile(BitMatrix& matrix, int x, int y) = 0;
+  };
+
   BitMatrix(int dimension);
   BitMatrix(int width, int height);
+  // A matrix whose tiles of 1 << tileSizePower pixels square source fills
+  // in as they are read. Reading such a matrix writes to it, so threads
+  // must not share it.
+  BitMatrix(int width, int height, int tileSizePower, Ref<TileSource> const& source);
 
   ~BitMatrix();
 
   bool get(int x, int y) const {
+    if (tileSource) {
+      fillTile(x >> tileSizePower, y >> tileSizePower);
+    }
     int offset = y * rowSize + (x >> logBits);
     return ((((unsigned)bits[offset]) >> (x & bitsMask)) & 1) != 0;
   }
@@ -65,23 +83,58 @@ public:
     bits[offset] |= 1 << (x & bitsMask);
   }
 
+  // ORs newBits into row y from x on, bit 0 going to x. All of them must
+  // land in the same word, as they do when x is a multiple of their count.
+  void setBits(int x, int y, unsigned int newBits) {
+    int offset = y * rowSize + (x >> logBits);
+    bits[offset] |= newBits << (x & bitsMask);
+  }
+
   void flip(int x, int y);
   void clear();
   void setRegion(int left, int top, int width, int height);
   Ref<BitArray> getRow(int y, Ref<BitArray> row);
+  // A new matrix with every bit flipped, a word at a time. While this one
+  // still has tiles to fill, the new one fills the same tiles, flipping
+  // each as it is read.
+  Ref<BitMatrix> inverted();
 
   int getWidth() const;
   int getHeight() const;
 
+  // How many tiles a TileSource fills in, and how many it has so far; both
+  // are 0 for a matrix without one.
+  int getTileCount() const;
+  int getFilledTileCount() const;
+
   ArrayRef<int> getTopLeftOnBit() const;
   ArrayRef<int> getBottomRightOnBit() const;
+  // left, top, width, height of the smallest rectangle holding all set bits
+  ArrayRef<int> getEnclosingRectangle() const;
 
   friend std::ostream& operator<<(std::ostream &out, const BitMatrix &bm);
   const char *description();
 
 private:
+  class InvertedTiles;
+
   inline void init(int, int);
 
+  void fillTile(int x, int y) const {
+    if (!filledTiles[y * tileColumns + x]) {
+      fillNewTile(x, y);
+    }
+  }
+  void fillNewTile(int x, int y) const;
+  void fillRows(int top, int bottom) const;
+
+  int tileSizePower;
+  int tileColumns;
+  int tileCount;
+  mutable int filledTileCount;
+  mutable std::vector<char> filledTiles;
+  mutable Ref<TileSource> tileSource;
+
   BitMatrix(const BitMatrix&);
   BitMatrix& operator =(const BitMatrix&);
 };
@@ -21,12 +21,17 @@
  */
 
 #include <zxing/common/Array.h>
+#include <stdint.h>
 
 namespace zxing {
 /**
  * <p>This provides an easy abstraction to read bits at a time from a sequence of bytes, where the
  * number of bits read is not often a multiple of 8.</p>
  *
+ * <p>Bits are served from a 64-bit buffer that is refilled a whole word at a time, so reading a
+ * code costs a shift and a mask. {@link #peekBits} and {@link #skipBits} expose the buffer for
+ * callers that decode variable-length codes.</p>
+ *
  * <p>This class is not thread-safe.</p>
  *
  * @author srowen@google.com (Sean Owen)
@@ -36,23 +41,71 @@ class BitSource : public Counted {
   typedef char byte;
 private:
   ArrayRef<byte> bytes_;
-  int byteOffset_;
-  int bitOffset_;
+  unsigned char const* data_;
+  int size_;
+  int byteOffset_;  // next byte to move into the buffer
+  uint64_t buffer_; // unread bits, most significant first
+  int bufferBits_;
+
+  void refill() {
+    if (byteOffset_ + 8 <= size_) {
+      // Load a whole big-endian word. Bits past the whole bytes that fit are
+      // merged again, with the same values, by the next refill.
+      unsigned char const* p = data_ + byteOffset_;
+      uint64_t word = 0;
+      for (int i = 0; i < 8; i++) {
+        word = (word << 8) | p[i];
+      }
+      buffer_ |= word >> bufferBits_;
+      int bytes = (64 - bufferBits_) >> 3;
+      byteOffset_ += bytes;
+      bufferBits_ += bytes << 3;
+    } else {
+      while (bufferBits_ <= 56 && byteOffset_ < size_) {
+        buffer_ |= (uint64_t) data_[byteOffset_++] << (56 - bufferBits_);
+        bufferBits_ += 8;
+      }
+    }
+  }
+
+  static void badRead(int numBits);
+
 public:
   /**
    * @param bytes bytes from which this will read bits. Bits will be read from the first byte first.
    * Bits are read within a byte from most-significant to least-significant bit.
    */
-  BitSource(ArrayRef<byte> &bytes) :
-      bytes_(bytes), byteOffset_(0), bitOffset_(0) {
+  BitSource(ArrayRef<byte> const& bytes) :
+      bytes_(bytes), data_((unsigned char const*) bytes->values().data()), size_(bytes->size()),
+      byteOffset_(0), buffer_(0), bufferBits_(0) {
   }
 
   int getBitOffset() {
-    return bitOffset_;
+    return (8 * byteOffset_ - bufferBits_) & 7;
   }
 
   int getByteOffset() {
-    return byteOffset_;
+    return (8 * byteOffset_ - bufferBits_) >> 3;
+  }
+
+  /**
+   * @param numBits number of bits to look at, in [1,32]
+   * @return the next numBits bits without consuming them; bits past the end of the data read
+   *         as 0
+   */
+  int peekBits(int numBits) {
+    if (bufferBits_ < numBits) {
+      refill();
+    }
+    return (int) (buffer_ >> (64 - numBits));
+  }
+
+  /**
+   * @param numBits number of bits to consume, at most the number just peeked
+   */
+  void skipBits(int numBits) {
+    buffer_ <<= numBits;
+    bufferBits_ -= numBits;
   }
 
   /**
@@ -61,12 +114,24 @@ public:
    *         bits of the int
    * @throws IllegalArgumentException if numBits isn't in [1,32]
    */
-  int readBits(int numBits);
+  int readBits(int numBits) {
+    if (numBits <= 0 || numBits > 32 || numBits > available()) {
+      if (numBits == 0) {
+        return 0;
+      }
+      badRead(numBits);
+    }
+    int result = peekBits(numBits);
+    skipBits(numBits);
+    return result;
+  }
 
   /**
    * @return number of bits that can be read successfully
    */
-  int available();
+  int available() {
+    return 8 * (size_ - byteOffset_) + bufferBits_;
+  }
 };
 
 }
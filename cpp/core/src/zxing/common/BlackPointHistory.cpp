@@ -0,0 +1,102 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/BlackPointHistory.h>
+#include <stdlib.h>
+
+using zxing::BlackPointHistory;
+using zxing::ArrayRef;
+
+namespace {
+  const int HISTOGRAM_SCALE_POWER = 4;
+  // Each frame makes up 1 / (1 << HISTOGRAM_WEIGHT_POWER) of the running
+  // histogram.
+  const int HISTOGRAM_WEIGHT_POWER = 2;
+}
+
+BlackPointHistory::BlackPointHistory(int tolerance)
+  : tolerance_(tolerance), width_(0), height_(0), reused_(0), computed_(0) {
+}
+
+int BlackPointHistory::getReusedCount() const {
+  return reused_;
+}
+
+int BlackPointHistory::getComputedCount() const {
+  return computed_;
+}
+
+float BlackPointHistory::getReuseRatio() const {
+  int total = reused_ + computed_;
+  return total == 0 ? 0.0f : float(reused_) / total;
+}
+
+void BlackPointHistory::resetCounts() {
+  reused_ = 0;
+  computed_ = 0;
+}
+
+void BlackPointHistory::clear() {
+  width_ = 0;
+  height_ = 0;
+  means_.clear();
+  blackPoints_.clear();
+  histogram_.clear();
+}
+
+void BlackPointHistory::startFrame(int width, int height, int blocks) {
+  if (width != width_ || height != height_) {
+    clear();
+    width_ = width;
+    height_ = height;
+  }
+  if ((int) means_.size() < blocks) {
+    means_.resize(blocks, -1);
+    blackPoints_.resize(blocks, -1);
+  }
+}
+
+int BlackPointHistory::reuseBlackPoint(int block, int mean, int sampleSize) {
+  if (means_[block] < 0 || abs(mean - means_[block]) > tolerance_ * sampleSize) {
+    return -1;
+  }
+  reused_++;
+  int blackPoint = blackPoints_[block] + (mean - means_[block]) / sampleSize;
+  return blackPoint < 0 ? 0 : blackPoint;
+}
+
+void BlackPointHistory::storeBlackPoint(int block, int mean, int blackPoint) {
+  computed_++;
+  means_[block] = mean;
+  blackPoints_[block] = blackPoint;
+}
+
+void BlackPointHistory::smoothHistogram(ArrayRef<int>& buckets) {
+  int size = buckets->size();
+  if ((int) histogram_.size() != size) {
+    histogram_.resize(size);
+    for (int i = 0; i < size; i++) {
+      histogram_[i] = buckets[i] << HISTOGRAM_SCALE_POWER;
+    }
+    return;
+  }
+  for (int i = 0; i < size; i++) {
+    int scaled = buckets[i] << HISTOGRAM_SCALE_POWER;
+    histogram_[i] += (scaled - histogram_[i]) / (1 << HISTOGRAM_WEIGHT_POWER);
+    buckets[i] = (histogram_[i] + (1 << (HISTOGRAM_SCALE_POWER - 1))) >> HISTOGRAM_SCALE_POWER;
+  }
+}
@@ -0,0 +1,74 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __BLACK_POINT_HISTORY_H__
+#define __BLACK_POINT_HISTORY_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/common/Counted.h>
+#include <zxing/common/Array.h>
+
+namespace zxing {
+
+// Black points carried over from one frame of a video to the next, so that
+// a binarizer only works out those of the parts of the scene that changed.
+// Give the same history to the binarizer of each frame in turn; frames of a
+// different size start it afresh.
+class BlackPointHistory : public Counted {
+public:
+  // Blocks whose sampled mean moved by no more than tolerance luminance
+  // levels since their black point was worked out keep that black point.
+  explicit BlackPointHistory(int tolerance = 2);
+
+  // Black points reused and worked out afresh since the last resetCounts().
+  int getReusedCount() const;
+  int getComputedCount() const;
+  // The share of black points that were reused, or 0 before any were
+  // needed.
+  float getReuseRatio() const;
+  void resetCounts();
+  // Forgets all frames so far.
+  void clear();
+
+  // For binarizers: called for each frame before anything else, with the
+  // number of blocks the frame is divided into, if any.
+  void startFrame(int width, int height, int blocks);
+  // Returns the black point stored for the block, shifted by how far its
+  // mean moved, or -1 if it moved too far or none is stored yet. mean is
+  // the sum of sampleSize luminances.
+  int reuseBlackPoint(int block, int mean, int sampleSize);
+  void storeBlackPoint(int block, int mean, int blackPoint);
+  // Blends the histogram of this frame into a running average of those of
+  // the frames before and replaces it with the average.
+  void smoothHistogram(ArrayRef<int>& buckets);
+
+private:
+  int tolerance_;
+  int width_;
+  int height_;
+  int reused_;
+  int computed_;
+  // -1 for blocks without a black point.
+  std::vector<int> means_;
+  std::vector<int> blackPoints_;
+  // Scaled up by HISTOGRAM_SCALE.
+  std::vector<int> histogram_;
+};
+
+}
+
+#endif // __BLACK_POINT_HISTORY_H__
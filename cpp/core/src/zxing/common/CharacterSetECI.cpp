@@ -27,8 +27,6 @@ using zxing::IllegalArgumentException;
 std::map<int, CharacterSetECI*> CharacterSetECI::VALUE_TO_ECI;
 std::map<std::string, CharacterSetECI*> CharacterSetECI::NAME_TO_ECI;
 
-const bool CharacterSetECI::inited = CharacterSetECI::init_tables();
-
 #define ADD_CHARACTER_SET(VALUES, STRINGS) \
   { static int values[] = {VALUES, -1}; \
     static char const* strings[] = {STRINGS, 0}; \
@@ -69,6 +67,13 @@ bool CharacterSetECI::init_tables() {
 
 #undef XC
 
+// The tables are filled on the first lookup rather than during static
+// initialization; most symbols never carry an ECI designator.
+void CharacterSetECI::ensure_tables() {
+  static const bool inited = init_tables();
+  (void)inited;
+}
+
 CharacterSetECI::CharacterSetECI(int const* values,
                                  char const* const* names) 
   : values_(values), names_(names) {
@@ -96,9 +101,13 @@ CharacterSetECI* CharacterSetECI::getCharacterSetECIByValue(int value) {
   if (value < 0 || value >= 900) {
     throw FormatException();
   }
-  return VALUE_TO_ECI[value];
+  ensure_tables();
+  std::map<int, CharacterSetECI*>::const_iterator i = VALUE_TO_ECI.find(value);
+  return i == VALUE_TO_ECI.end() ? 0 : i->second;
 }
 
 CharacterSetECI* CharacterSetECI::getCharacterSetECIByName(string const& name) {
-  return NAME_TO_ECI[name];
+  ensure_tables();
+  std::map<string, CharacterSetECI*>::const_iterator i = NAME_TO_ECI.find(name);
+  return i == NAME_TO_ECI.end() ? 0 : i->second;
 }
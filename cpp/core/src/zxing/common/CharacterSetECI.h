@@ -29,8 +29,8 @@ class CharacterSetECI {
 private:
   static std::map<int, CharacterSetECI*> VALUE_TO_ECI;
   static std::map<std::string, CharacterSetECI*> NAME_TO_ECI;
-  static const bool inited;
   static bool init_tables();
+  static void ensure_tables();
 
   int const* const values_;
   char const* const* const names_;
@@ -0,0 +1,43 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __CHARACTER_SET_TABLES_H__
+#define __CHARACTER_SET_TABLES_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Mapping tables for the character sets StringUtils::appendUTF8 decodes
+// without iconv. Entries are Unicode code points; 0 means unmapped.
+
+namespace zxing {
+namespace common {
+
+struct SingleByteCharset {
+  char const* name;            // upper case, without '-', '_' or spaces
+  unsigned short const* upper; // code points for bytes 0x80 to 0xFF
+};
+
+// Terminated by an entry with a null name.
+extern SingleByteCharset const SINGLE_BYTE_CHARSETS[];
+
+// 94 x 94 cells indexed by (row - 1) * 94 + (cell - 1), i.e. by the EUC
+// bytes minus 0xA1.
+extern unsigned short const JIS_X_0208[94 * 94];
+extern unsigned short const GB_2312[94 * 94];
+
+}
+}
+
+#endif // __CHARACTER_SET_TABLES_H__
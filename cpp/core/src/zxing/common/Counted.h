@@ -20,11 +20,24 @@
 
 #include <iostream>
 
+// Define ZXING_COUNT_REFS to 1 to count retain() and release() calls; debug
+// builds do so by default.
+#ifndef ZXING_COUNT_REFS
+#define ZXING_COUNT_REFS 0
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define ZXING_HAS_RVALUE_REFERENCES 1
+#else
+#define ZXING_HAS_RVALUE_REFERENCES 0
+#endif
+
 namespace zxing {
 
 /* base class for reference-counted objects */
 class Counted {
 private:
+  static const unsigned int PERMANENT = 0xFFFFFFFF;
   unsigned int count_;
 public:
   Counted() :
@@ -32,11 +45,30 @@ public:
   }
   virtual ~Counted() {
   }
+#if ZXING_COUNT_REFS
+  /* number of retain() and release() calls so far, for measuring reference
+     churn; not thread-safe */
+  static unsigned long& operations() {
+    static unsigned long operations_ = 0;
+    return operations_;
+  }
+#endif
   Counted *retain() {
-    count_++;
+#if ZXING_COUNT_REFS
+    operations()++;
+#endif
+    if (count_ != PERMANENT) {
+      count_++;
+    }
     return this;
   }
   void release() {
+#if ZXING_COUNT_REFS
+    operations()++;
+#endif
+    if (count_ == PERMANENT) {
+      return;
+    }
     count_--;
     if (count_ == 0) {
       count_ = 0xDEADF001;
@@ -45,6 +77,13 @@ public:
   }
 
 
+  /* stops counting references to an object that is never deleted, such as a
+     table all decoders share, so that several threads can take and drop
+     references to it at once (see ParallelSearch) */
+  void makePermanent() {
+    count_ = PERMANENT;
+  }
+
   /* return the current count for denugging purposes or similar */
   int count() const {
     return count_;
@@ -71,6 +110,18 @@ public:
     reset(other.object_);
   }
 
+#if ZXING_HAS_RVALUE_REFERENCES
+  Ref(Ref &&other) :
+      object_(other.object_) {
+    other.object_ = 0;
+  }
+  template<class Y>
+  Ref(Ref<Y> &&other) :
+      object_(other.object_) {
+    other.object_ = 0;
+  }
+#endif
+
   ~Ref() {
     if (object_) {
       object_->release();
@@ -95,6 +146,19 @@ public:
     reset(other.object_);
     return *this;
   }
+#if ZXING_HAS_RVALUE_REFERENCES
+  Ref& operator=(Ref &&other) {
+    if (this != &other) {
+      T *old = object_;
+      object_ = other.object_;
+      other.object_ = 0;
+      if (old) {
+        old->release();
+      }
+    }
+    return *this;
+  }
+#endif
   Ref& operator=(T* o) {
     reset(o);
     return *this;
@@ -105,7 +169,7 @@ public:
     return *this;
   }
 
-  T& operator*() {
+  T& operator*() const {
     return *object_;
   }
   T* operator->() const {
@@ -135,6 +199,35 @@ public:
   }
 };
 
+/* non-owning reference for parameters that are only used during the call:
+   binds to a Ref of T or of a subclass, or to a plain pointer, without
+   touching the reference count. Never store one. */
+template<typename T> class RefView {
+private:
+  T *object_;
+public:
+  RefView(T *o) :
+      object_(o) {
+  }
+  template<class Y>
+  RefView(const Ref<Y> &other) :
+      object_(other.object_) {
+  }
+
+  T& operator*() const {
+    return *object_;
+  }
+  T* operator->() const {
+    return object_;
+  }
+  operator T*() const {
+    return object_;
+  }
+  bool empty() const {
+    return object_ == 0;
+  }
+};
+
 }
 
 #endif // __COUNTED_H__
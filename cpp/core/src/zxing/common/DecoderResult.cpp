@@ -24,8 +24,8 @@
 using namespace std;
 using namespace zxing;
 
-DecoderResult::DecoderResult(ArrayRef<char> rawBytes,
-                             Ref<String> text,
+DecoderResult::DecoderResult(ArrayRef<char> const& rawBytes,
+                             Ref<String> const& text,
                              ArrayRef< ArrayRef<char> >& byteSegments,
                              string const& ecLevel) :
   rawBytes_(rawBytes),
@@ -33,14 +33,14 @@ DecoderResult::DecoderResult(ArrayRef<char> rawBytes,
   byteSegments_(byteSegments),
   ecLevel_(ecLevel) {}
 
-DecoderResult::DecoderResult(ArrayRef<char> rawBytes,
-                             Ref<String> text)
+DecoderResult::DecoderResult(ArrayRef<char> const& rawBytes,
+                             Ref<String> const& text)
   : rawBytes_(rawBytes), text_(text) {}
 
-ArrayRef<char> DecoderResult::getRawBytes() {
+ArrayRef<char> const& DecoderResult::getRawBytes() {
   return rawBytes_;
 }
 
-Ref<String> DecoderResult::getText() {
+Ref<String> const& DecoderResult::getText() {
   return text_;
 }
@@ -35,15 +35,15 @@ private:
   std::string ecLevel_;
 
 public:
-  DecoderResult(ArrayRef<char> rawBytes,
-                Ref<String> text,
+  DecoderResult(ArrayRef<char> const& rawBytes,
+                Ref<String> const& text,
                 ArrayRef< ArrayRef<char> >& byteSegments,
                 std::string const& ecLevel);
 
-  DecoderResult(ArrayRef<char> rawBytes, Ref<String> text);
+  DecoderResult(ArrayRef<char> const& rawBytes, Ref<String> const& text);
 
-  ArrayRef<char> getRawBytes();
-  Ref<String> getText();
+  ArrayRef<char> const& getRawBytes();
+  Ref<String> const& getText();
 };
 
 }
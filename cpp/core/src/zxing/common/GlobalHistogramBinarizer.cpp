@@ -28,6 +28,7 @@ using zxing::ArrayRef;
 using zxing::Ref;
 using zxing::BitArray;
 using zxing::BitMatrix;
+using zxing::BlackPointHistory;
 
 // VC++
 using zxing::LuminanceSource;
@@ -36,16 +37,19 @@ namespace {
   const int LUMINANCE_BITS = 5;
   const int LUMINANCE_SHIFT = 8 - LUMINANCE_BITS;
   const int LUMINANCE_BUCKETS = 1 << LUMINANCE_BITS;
-  const ArrayRef<char> EMPTY (0);
 }
 
 GlobalHistogramBinarizer::GlobalHistogramBinarizer(Ref<LuminanceSource> source) 
-  : Binarizer(source), luminances(EMPTY), buckets(LUMINANCE_BUCKETS) {}
+  : Binarizer(source), luminances(), buckets(LUMINANCE_BUCKETS) {}
+
+GlobalHistogramBinarizer::GlobalHistogramBinarizer(Ref<LuminanceSource> source,
+                                                   Ref<BlackPointHistory> history)
+  : Binarizer(source), luminances(), buckets(LUMINANCE_BUCKETS), history_(history) {}
 
 GlobalHistogramBinarizer::~GlobalHistogramBinarizer() {}
 
 void GlobalHistogramBinarizer::initArrays(int luminanceSize) {
-  if (luminances->size() < luminanceSize) {
+  if (!luminances || luminances->size() < luminanceSize) {
     luminances = ArrayRef<char>(luminanceSize);
   }
   for (int x = 0; x < LUMINANCE_BUCKETS; x++) {
@@ -72,26 +76,7 @@ Ref<BitArray> GlobalHistogramBinarizer::getBlackRow(int y, Ref<BitArray> row) {
     }
     std::cerr << std::endl;
   }
-  ArrayRef<int> localBuckets = buckets;
-  for (int x = 0; x < width; x++) {
-    int pixel = localLuminances[x] & 0xff;
-    localBuckets[pixel >> LUMINANCE_SHIFT]++;
-  }
-  int blackPoint = estimateBlackPoint(localBuckets);
-  // std::cerr << "gbr bp " << y << " " << blackPoint << std::endl;
-
-  int left = localLuminances[0] & 0xff;
-  int center = localLuminances[1] & 0xff;
-  for (int x = 1; x < width - 1; x++) {
-    int right = localLuminances[x + 1] & 0xff;
-    // A simple -1 4 -1 box filter with a weight of 2.
-    int luminance = ((center << 2) - left - right) >> 1;
-    if (luminance < blackPoint) {
-      row->set(x);
-    }
-    left = center;
-    center = right;
-  }
+  binarizeRow(localLuminances, width, buckets, *row);
   return row;
 }
  
@@ -116,6 +101,10 @@ Ref<BitMatrix> GlobalHistogramBinarizer::getBlackMatrix() {
     }
   }
 
+  if (history_) {
+    history_->startFrame(width, height, 0);
+    history_->smoothHistogram(localBuckets);
+  }
   int blackPoint = estimateBlackPoint(localBuckets);
 
   ArrayRef<char> localLuminances = source.getMatrix();
@@ -132,6 +121,35 @@ Ref<BitMatrix> GlobalHistogramBinarizer::getBlackMatrix() {
   return matrix;
 }
 
+void GlobalHistogramBinarizer::binarizeRow(ArrayRef<char> const& luminances, int width,
+                                           ArrayRef<int>& buckets, BitArray& row) {
+  if (!buckets) {
+    buckets = ArrayRef<int>(LUMINANCE_BUCKETS);
+  }
+  for (int x = 0; x < LUMINANCE_BUCKETS; x++) {
+    buckets[x] = 0;
+  }
+  for (int x = 0; x < width; x++) {
+    int pixel = luminances[x] & 0xff;
+    buckets[pixel >> LUMINANCE_SHIFT]++;
+  }
+  int blackPoint = estimateBlackPoint(buckets);
+  // std::cerr << "gbr bp " << blackPoint << std::endl;
+
+  int left = luminances[0] & 0xff;
+  int center = luminances[1] & 0xff;
+  for (int x = 1; x < width - 1; x++) {
+    int right = luminances[x + 1] & 0xff;
+    // A simple -1 4 -1 box filter with a weight of 2.
+    int luminance = ((center << 2) - left - right) >> 1;
+    if (luminance < blackPoint) {
+      row.set(x);
+    }
+    left = center;
+    center = right;
+  }
+}
+
 using namespace std;
 
 int GlobalHistogramBinarizer::estimateBlackPoint(ArrayRef<int> const& buckets) {
@@ -210,3 +228,7 @@ int GlobalHistogramBinarizer::estimateBlackPoint(ArrayRef<int> const& buckets) {
 Ref<Binarizer> GlobalHistogramBinarizer::createBinarizer(Ref<LuminanceSource> source) {
   return Ref<Binarizer> (new GlobalHistogramBinarizer(source));
 }
+
+Ref<BlackPointHistory> GlobalHistogramBinarizer::getHistory() const {
+  return history_;
+}
@@ -24,6 +24,7 @@
 #include <zxing/common/BitArray.h>
 #include <zxing/common/BitMatrix.h>
 #include <zxing/common/Array.h>
+#include <zxing/common/BlackPointHistory.h>
 
 namespace zxing {
 	
@@ -31,14 +32,26 @@ class GlobalHistogramBinarizer : public Binarizer {
 private:
   ArrayRef<char> luminances;
   ArrayRef<int> buckets;
+  Ref<BlackPointHistory> history_;
 public:
   GlobalHistogramBinarizer(Ref<LuminanceSource> source);
+  // For a frame of a video: getBlackMatrix() smooths the histogram of the
+  // frame with those of the frames before. Other binarizers created from
+  // this one do not share the history.
+  GlobalHistogramBinarizer(Ref<LuminanceSource> source, Ref<BlackPointHistory> history);
   virtual ~GlobalHistogramBinarizer();
 		
   virtual Ref<BitArray> getBlackRow(int y, Ref<BitArray> row);
   virtual Ref<BitMatrix> getBlackMatrix();
   static int estimateBlackPoint(ArrayRef<int> const& buckets);
+  // Sets the bits of the cleared row for the black pixels among the first
+  // width luminances, the way getBlackRow() does for a row of the image.
+  // buckets is scratch space, allocated on first use. Throws
+  // NotFoundException if the luminances have too little contrast.
+  static void binarizeRow(ArrayRef<char> const& luminances, int width,
+                          ArrayRef<int>& buckets, BitArray& row);
   Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
+  Ref<BlackPointHistory> getHistory() const;
 private:
   void initArrays(int luminanceSize);
 };
@@ -19,14 +19,95 @@
  */
 
 #include <zxing/common/GreyscaleLuminanceSource.h>
-#include <zxing/common/GreyscaleRotatedLuminanceSource.h>
 #include <zxing/common/IllegalArgumentException.h>
+#include <stdint.h>
+#include <string.h>
 
 using zxing::Ref;
 using zxing::ArrayRef;
 using zxing::LuminanceSource;
 using zxing::GreyscaleLuminanceSource;
 
+namespace {
+
+const int TILE = 8;
+
+bool isLittleEndian() {
+  uint16_t one = 1;
+  return *reinterpret_cast<unsigned char*>(&one) == 1;
+}
+
+uint64_t repeat(uint32_t word) {
+  return (uint64_t(word) << 32) | word;
+}
+
+// Swaps the bits of a and b selected by mask in b and by mask << shift in a.
+void swapBits(uint64_t& a, uint64_t& b, int shift, uint64_t mask) {
+  uint64_t t = ((a >> shift) ^ b) & mask;
+  a ^= t << shift;
+  b ^= t;
+}
+
+// Transposes the 8x8 bytes held one row per word, byte j of a word being
+// bits 8j to 8j+7, by swapping 1x1, 2x2 and then 4x4 blocks of bytes.
+void transposeTile(uint64_t rows[TILE]) {
+  for (int i = 0; i < TILE; i += 2) {
+    swapBits(rows[i], rows[i + 1], 8, repeat(0x00FF00FF));
+  }
+  for (int i = 0; i < TILE; i += 4) {
+    swapBits(rows[i], rows[i + 2], 16, repeat(0x0000FFFF));
+    swapBits(rows[i + 1], rows[i + 3], 16, repeat(0x0000FFFF));
+  }
+  for (int i = 0; i < TILE / 2; i++) {
+    swapBits(rows[i], rows[i + 4], 32, uint64_t(0xFFFFFFFF));
+  }
+}
+
+// Rotates the given rectangle of rows and columns one by one.
+void rotatePixels(char const* in, int inStride, char* out, int outStride, int width,
+                  int left, int top, int right, int bottom) {
+  for (int x = left; x < right; x++) {
+    char* column = out + (width - 1 - x) * outStride;
+    for (int y = top; y < bottom; y++) {
+      column[y] = in[y * inStride + x];
+    }
+  }
+}
+
+// Rotates width x height pixels read with stride inStride a quarter turn
+// counter-clockwise into out, which becomes height pixels wide. Reading a
+// column of the original for each output row misses the cache on every
+// pixel, so the image is instead moved in 8x8 tiles: eight loads of eight
+// bytes, a transpose in registers and eight stores.
+void rotateTiled(char const* in, int inStride, int width, int height, char* out) {
+  int tiledWidth = width - width % TILE;
+  int tiledHeight = height - height % TILE;
+  if (isLittleEndian()) {
+    for (int y = 0; y < tiledHeight; y += TILE) {
+      for (int x = 0; x < tiledWidth; x += TILE) {
+        uint64_t rows[TILE];
+        for (int i = 0; i < TILE; i++) {
+          memcpy(&rows[i], in + (y + i) * inStride + x, TILE);
+        }
+        transposeTile(rows);
+        for (int i = 0; i < TILE; i++) {
+          memcpy(out + (width - 1 - x - i) * height + y, &rows[i], TILE);
+        }
+      }
+    }
+  } else {
+    for (int y = 0; y < tiledHeight; y += TILE) {
+      for (int x = 0; x < tiledWidth; x += TILE) {
+        rotatePixels(in, inStride, out, height, width, x, y, x + TILE, y + TILE);
+      }
+    }
+  }
+  rotatePixels(in, inStride, out, height, width, tiledWidth, 0, width, height);
+  rotatePixels(in, inStride, out, height, width, 0, tiledHeight, tiledWidth, height);
+}
+
+}
+
 GreyscaleLuminanceSource::
 GreyscaleLuminanceSource(ArrayRef<char> greyData,
                          int dataWidth, int dataHeight,
@@ -70,11 +151,29 @@ ArrayRef<char> GreyscaleLuminanceSource::getMatrix() const {
 }
 
 Ref<LuminanceSource> GreyscaleLuminanceSource::rotateCounterClockwise() const {
-  // Intentionally flip the left, top, width, and height arguments as
-  // needed. dataWidth and dataHeight are always kept unrotated.
-  Ref<LuminanceSource> result ( 
-      new GreyscaleRotatedLuminanceSource(greyData_,
-                                          dataWidth_, dataHeight_,
-                                          top_, left_, getHeight(), getWidth()));
-  return result;
+  // Rotate the pixels once up front so that rows of the rotated image can be
+  // copied out as cheaply as the original's. GreyscaleRotatedLuminanceSource
+  // rotates on every getRow() instead.
+  int width = getWidth();
+  int height = getHeight();
+  ArrayRef<char> rotated (width * height);
+  if (width > 0 && height > 0) {
+    rotateTiled(&greyData_[top_ * dataWidth_ + left_], dataWidth_,
+                width, height, &rotated[0]);
+  }
+  return Ref<LuminanceSource>(new GreyscaleLuminanceSource(rotated, height, width, 0, 0, height, width));
+}
+
+Ref<LuminanceSource> GreyscaleLuminanceSource::scaleDown() const {
+  int width = getWidth() / 2;
+  int height = getHeight() / 2;
+  if (width == 0 || height == 0) {
+    throw IllegalArgumentException("Image too small to scale down.");
+  }
+  ArrayRef<char> scaled (width * height);
+  for (int y = 0; y < height; y++) {
+    char const* top = &greyData_[(top_ + 2 * y) * dataWidth_ + left_];
+    scaleDownRows(top, top + dataWidth_, width, &scaled[y * width]);
+  }
+  return Ref<LuminanceSource>(new GreyscaleLuminanceSource(scaled, width, height, 0, 0, width, height));
 }
@@ -46,6 +46,8 @@ public:
   }
 
   Ref<LuminanceSource> rotateCounterClockwise() const;
+  // Reads the pixels in place rather than copying them out first.
+  Ref<LuminanceSource> scaleDown() const;
 };
 
 }
@@ -21,6 +21,8 @@
 #include <zxing/common/HybridBinarizer.h>
 
 #include <zxing/common/IllegalArgumentException.h>
+#include <algorithm>
+#include <vector>
 
 using namespace std;
 using namespace zxing;
@@ -30,10 +32,58 @@ namespace {
   const int BLOCK_SIZE = 1 << BLOCK_SIZE_POWER; // ...0100...00
   const int BLOCK_SIZE_MASK = BLOCK_SIZE - 1;   // ...0011...11
   const int MINIMUM_DIMENSION = BLOCK_SIZE * 5;
+  const int MIN_DYNAMIC_RANGE = 24;
+  const int SAMPLE_SIZE = BLOCK_SIZE * BLOCK_SIZE / 2;
+
+  inline int cap(int value, int min, int max) {
+    return value < min ? min : value > max ? max : value;
+  }
+
+  // Thresholds the luminances a block of BLOCK_SIZE pixels square at a time,
+  // each against the average black point of the 5x5 blocks around it. The
+  // black points are also worked out as they are needed.
+  class BlackTiles : public BitMatrix::TileSource {
+  public:
+    BlackTiles(ArrayRef<char> const& luminances, int width, int height,
+               Ref<BlackPointHistory> const& history);
+    // Takes the thresholds from coarse, made for the image scaled down by
+    // scale, instead of working out black points of its own.
+    BlackTiles(ArrayRef<char> const& luminances, int width, int height,
+               Ref<BlackTiles> const& coarse, int scale);
+    virtual void fillTile(BitMatrix& matrix, int x, int y);
+
+  private:
+    void init(int width, int height);
+    int getBlockOffset(int block, int size) const;
+    int getThreshold(int x, int y);
+    int getBlackPoint(int x, int y);
+    int sampleBlock(int offset) const;
+    void thresholdBlock(BitMatrix& matrix, int x, int y,
+                        int left, int top, int right, int bottom);
+
+    ArrayRef<char> luminances_;
+    int width_;
+    int height_;
+    int subWidth_;
+    int subHeight_;
+    // -1 for blocks whose black point is still to be worked out.
+    std::vector<int> blackPoints_;
+    // The darkest and brightest pixels of blocks whose black point is
+    // known, or 0 and 255 where the contrast was too high to bother.
+    std::vector<unsigned char> darkest_;
+    std::vector<unsigned char> brightest_;
+    Ref<BlackPointHistory> history_;
+    Ref<BlackTiles> coarse_;
+    int scale_;
+  };
 }
 
 HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source) :
-  GlobalHistogramBinarizer(source), matrix_(NULL), cached_row_(NULL) {
+  GlobalHistogramBinarizer(source), matrix_(NULL), cached_row_(NULL), tiles_(NULL) {
+}
+
+HybridBinarizer::HybridBinarizer(Ref<LuminanceSource> source, Ref<BlackPointHistory> history) :
+  GlobalHistogramBinarizer(source, history), matrix_(NULL), cached_row_(NULL), tiles_(NULL) {
 }
 
 HybridBinarizer::~HybridBinarizer() {
@@ -46,11 +96,6 @@ HybridBinarizer::createBinarizer(Ref<LuminanceSource> source) {
 }
 
 
-/**
- * Calculates the final BitMatrix once for all requests. This could be called once from the
- * constructor instead, but there are some advantages to doing it lazily, such as making
- * profiling easier, and not doing heavy lifting when callers don't expect it.
- */
 Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
   if (matrix_) {
     return matrix_;
@@ -59,27 +104,8 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
   int width = source.getWidth();
   int height = source.getHeight();
   if (width >= MINIMUM_DIMENSION && height >= MINIMUM_DIMENSION) {
-    ArrayRef<char> luminances = source.getMatrix();
-    int subWidth = width >> BLOCK_SIZE_POWER;
-    if ((width & BLOCK_SIZE_MASK) != 0) {
-      subWidth++;
-    }
-    int subHeight = height >> BLOCK_SIZE_POWER;
-    if ((height & BLOCK_SIZE_MASK) != 0) {
-      subHeight++;
-    }
-    ArrayRef<int> blackPoints =
-      calculateBlackPoints(luminances, subWidth, subHeight, width, height);
-
-    Ref<BitMatrix> newMatrix (new BitMatrix(width, height));
-    calculateThresholdForBlock(luminances,
-                               subWidth,
-                               subHeight,
-                               width,
-                               height,
-                               blackPoints,
-                               newMatrix);
-    matrix_ = newMatrix;
+    tiles_ = new BlackTiles(source.getMatrix(), width, height, getHistory());
+    matrix_ = new BitMatrix(width, height, BLOCK_SIZE_POWER, tiles_);
   } else {
     // If the image is too small, fall back to the global histogram approach.
     matrix_ = GlobalHistogramBinarizer::getBlackMatrix();
@@ -87,140 +113,226 @@ Ref<BitMatrix> HybridBinarizer::getBlackMatrix() {
   return matrix_;
 }
 
-namespace {
-  inline int cap(int value, int min, int max) {
-    return value < min ? min : value > max ? max : value;
+Ref<BitMatrix> HybridBinarizer::getFineBlackMatrix(Ref<Binarizer> const& coarse, int scale) {
+  HybridBinarizer* hybrid = dynamic_cast<HybridBinarizer*>(&*coarse);
+  if (hybrid == 0) {
+    return getBlackMatrix();
   }
+  hybrid->getBlackMatrix();
+  if (hybrid->tiles_.empty()) {
+    return getBlackMatrix();
+  }
+  LuminanceSource& source = *getLuminanceSource();
+  int width = source.getWidth();
+  int height = source.getHeight();
+  Ref<BlackTiles> coarseTiles (static_cast<BlackTiles*>(&*hybrid->tiles_));
+  Ref<BitMatrix::TileSource> tiles (new BlackTiles(source.getMatrix(), width, height,
+                                                   coarseTiles, scale));
+  return Ref<BitMatrix>(new BitMatrix(width, height, BLOCK_SIZE_POWER, tiles));
 }
 
-void
-HybridBinarizer::calculateThresholdForBlock(ArrayRef<char> luminances,
-                                            int subWidth,
-                                            int subHeight,
-                                            int width,
-                                            int height,
-                                            ArrayRef<int> blackPoints,
-                                            Ref<BitMatrix> const& matrix) {
-  for (int y = 0; y < subHeight; y++) {
-    int yoffset = y << BLOCK_SIZE_POWER;
-    int maxYOffset = height - BLOCK_SIZE;
-    if (yoffset > maxYOffset) {
-      yoffset = maxYOffset;
-    }
-    for (int x = 0; x < subWidth; x++) {
-      int xoffset = x << BLOCK_SIZE_POWER;
-      int maxXOffset = width - BLOCK_SIZE;
-      if (xoffset > maxXOffset) {
-        xoffset = maxXOffset;
-      }
-      int left = cap(x, 2, subWidth - 3);
-      int top = cap(y, 2, subHeight - 3);
-      int sum = 0;
-      for (int z = -2; z <= 2; z++) {
-        int *blackRow = &blackPoints[(top + z) * subWidth];
-        sum += blackRow[left - 2];
-        sum += blackRow[left - 1];
-        sum += blackRow[left];
-        sum += blackRow[left + 1];
-        sum += blackRow[left + 2];
-      }
-      int average = sum / 25;
-      thresholdBlock(luminances, xoffset, yoffset, average, width, matrix);
+BlackTiles::BlackTiles(ArrayRef<char> const& luminances, int width, int height,
+                       Ref<BlackPointHistory> const& history)
+  : luminances_(luminances), width_(width), height_(height), history_(history), scale_(1) {
+  init(width, height);
+  blackPoints_.assign(subWidth_ * subHeight_, -1);
+  darkest_.resize(subWidth_ * subHeight_);
+  brightest_.resize(subWidth_ * subHeight_);
+  if (history_) {
+    history_->startFrame(width, height, subWidth_ * subHeight_);
+  }
+}
+
+BlackTiles::BlackTiles(ArrayRef<char> const& luminances, int width, int height,
+                       Ref<BlackTiles> const& coarse, int scale)
+  : luminances_(luminances), width_(width), height_(height), coarse_(coarse), scale_(scale) {
+  init(width, height);
+}
+
+void BlackTiles::init(int width, int height) {
+  subWidth_ = width >> BLOCK_SIZE_POWER;
+  if ((width & BLOCK_SIZE_MASK) != 0) {
+    subWidth_++;
+  }
+  subHeight_ = height >> BLOCK_SIZE_POWER;
+  if ((height & BLOCK_SIZE_MASK) != 0) {
+    subHeight_++;
+  }
+}
+
+void BlackTiles::fillTile(BitMatrix& matrix, int x, int y) {
+  int left = x << BLOCK_SIZE_POWER;
+  int top = y << BLOCK_SIZE_POWER;
+  int right = std::min(left + BLOCK_SIZE, width_);
+  int bottom = std::min(top + BLOCK_SIZE, height_);
+  // The last block of each row and column is moved back to fit inside the
+  // image, so it may cover part of the tile before it as well.
+  int lastX = x + 1 < subWidth_ && getBlockOffset(x + 1, width_) < right ? x + 1 : x;
+  int lastY = y + 1 < subHeight_ && getBlockOffset(y + 1, height_) < bottom ? y + 1 : y;
+  for (int blockY = y; blockY <= lastY; blockY++) {
+    for (int blockX = x; blockX <= lastX; blockX++) {
+      thresholdBlock(matrix, blockX, blockY, left, top, right, bottom);
     }
   }
 }
 
-void HybridBinarizer::thresholdBlock(ArrayRef<char> luminances,
-                                     int xoffset,
-                                     int yoffset,
-                                     int threshold,
-                                     int stride,
-                                     Ref<BitMatrix> const& matrix) {
-  for (int y = 0, offset = yoffset * stride + xoffset;
-       y < BLOCK_SIZE;
-       y++,  offset += stride) {
-    for (int x = 0; x < BLOCK_SIZE; x++) {
-      int pixel = luminances[offset + x] & 0xff;
-      if (pixel <= threshold) {
-        matrix->set(xoffset + x, yoffset + y);
+int BlackTiles::getBlockOffset(int block, int size) const {
+  return std::min(block << BLOCK_SIZE_POWER, size - BLOCK_SIZE);
+}
+
+// Sets the pixels of block x, y that lie inside the tile left, top, right,
+// bottom and are no brighter than the block's threshold.
+void BlackTiles::thresholdBlock(BitMatrix& matrix, int x, int y,
+                                int left, int top, int right, int bottom) {
+  int xoffset = getBlockOffset(x, width_);
+  int yoffset = getBlockOffset(y, height_);
+  int start = std::max(left, xoffset) - left;
+  int end = std::min(right, xoffset + BLOCK_SIZE) - left;
+  top = std::max(top, yoffset);
+  bottom = std::min(bottom, yoffset + BLOCK_SIZE);
+  if (start >= end || top >= bottom) {
+    return;
+  }
+  int threshold;
+  if (coarse_) {
+    threshold = coarse_->getThreshold(std::min(x / scale_, coarse_->subWidth_ - 1),
+                                      std::min(y / scale_, coarse_->subHeight_ - 1));
+  } else {
+    threshold = getThreshold(x, y);
+    // The window of getThreshold() always holds block x, y itself.
+    int block = y * subWidth_ + x;
+    if (threshold < darkest_[block]) {
+      return;
+    }
+    if (threshold >= brightest_[block]) {
+      unsigned int all = ((1u << end) - 1) & ~((1u << start) - 1);
+      for (int yy = top; yy < bottom; yy++) {
+        matrix.setBits(left, yy, all);
       }
+      return;
     }
   }
+  // Whether a pixel is black is as good as random, so work out a row of
+  // them without branching and set them together.
+  unsigned char const* pixels = (unsigned char const*) &luminances_[top * width_ + left];
+  for (int yy = top; yy < bottom; yy++, pixels += width_) {
+    unsigned int black = 0;
+    if (start == 0 && end == BLOCK_SIZE) {
+      for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+        black |= (unsigned int) (pixels[xx] <= threshold) << xx;
+      }
+    } else {
+      for (int xx = start; xx < end; xx++) {
+        black |= (unsigned int) (pixels[xx] <= threshold) << xx;
+      }
+    }
+    matrix.setBits(left, yy, black);
+  }
 }
 
-namespace {
-  inline int getBlackPointFromNeighbors(ArrayRef<int> blackPoints, int subWidth, int x, int y) {
-    return (blackPoints[(y-1)*subWidth+x] +
-            2*blackPoints[y*subWidth+x-1] +
-            blackPoints[(y-1)*subWidth+x-1]) >> 2;
+// The average black point of the 5x5 blocks around block x, y.
+int BlackTiles::getThreshold(int x, int y) {
+  int blackLeft = cap(x, 2, subWidth_ - 3) - 2;
+  int blackTop = cap(y, 2, subHeight_ - 3) - 2;
+  int sum = 0;
+  for (int blackY = blackTop; blackY < blackTop + 5; blackY++) {
+    int const* blackRow = &blackPoints_[blackY * subWidth_ + blackLeft];
+    for (int z = 0; z < 5; z++) {
+      sum += blackRow[z] >= 0 ? blackRow[z] : getBlackPoint(blackLeft + z, blackY);
+    }
   }
+  return sum / 25;
 }
 
-
-ArrayRef<int> HybridBinarizer::calculateBlackPoints(ArrayRef<char> luminances,
-                                                    int subWidth,
-                                                    int subHeight,
-                                                    int width,
-                                                    int height) {
-  const int minDynamicRange = 24;
-
-  ArrayRef<int> blackPoints (subHeight * subWidth);
-  for (int y = 0; y < subHeight; y++) {
-    int yoffset = y << BLOCK_SIZE_POWER;
-    int maxYOffset = height - BLOCK_SIZE;
-    if (yoffset > maxYOffset) {
-      yoffset = maxYOffset;
+// A block without enough contrast takes its black point from the blocks
+// above and to the left, which in turn may take theirs from further up and
+// left.
+int BlackTiles::getBlackPoint(int x, int y) {
+  int block = y * subWidth_ + x;
+  if (blackPoints_[block] >= 0) {
+    return blackPoints_[block];
+  }
+  int xoffset = getBlockOffset(x, width_);
+  int yoffset = getBlockOffset(y, height_);
+  int sample = 0;
+  if (history_) {
+    sample = sampleBlock(yoffset * width_ + xoffset);
+    int reused = history_->reuseBlackPoint(block, sample, SAMPLE_SIZE);
+    if (reused >= 0) {
+      // Pixels that were not sampled may have changed, so the block is
+      // thresholded pixel by pixel.
+      darkest_[block] = 0;
+      brightest_[block] = 0xFF;
+      blackPoints_[block] = reused;
+      return reused;
     }
-    for (int x = 0; x < subWidth; x++) {
-      int xoffset = x << BLOCK_SIZE_POWER;
-      int maxXOffset = width - BLOCK_SIZE;
-      if (xoffset > maxXOffset) {
-        xoffset = maxXOffset;
+  }
+  int sum = 0;
+  int min = 0xFF;
+  int max = 0;
+  for (int yy = 0, offset = yoffset * width_ + xoffset;
+       yy < BLOCK_SIZE;
+       yy++, offset += width_) {
+    for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+      int pixel = luminances_[offset + xx] & 0xFF;
+      sum += pixel;
+      // still looking for good contrast
+      if (pixel < min) {
+        min = pixel;
       }
-      int sum = 0;
-      int min = 0xFF;
-      int max = 0;
-      for (int yy = 0, offset = yoffset * width + xoffset;
-           yy < BLOCK_SIZE;
-           yy++, offset += width) {
-        for (int xx = 0; xx < BLOCK_SIZE; xx++) {
-          int pixel = luminances[offset + xx] & 0xFF;
-          sum += pixel;
-          // still looking for good contrast
-          if (pixel < min) {
-            min = pixel;
-          }
-          if (pixel > max) {
-            max = pixel;
-          }
-        }
+      if (pixel > max) {
+        max = pixel;
+      }
+    }
 
-        // short-circuit min/max tests once dynamic range is met
-        if (max - min > minDynamicRange) {
-          // finish the rest of the rows quickly
-          for (yy++, offset += width; yy < BLOCK_SIZE; yy++, offset += width) {
-            for (int xx = 0; xx < BLOCK_SIZE; xx += 2) {
-              sum += luminances[offset + xx] & 0xFF;
-              sum += luminances[offset + xx + 1] & 0xFF;
-            }
-          }
+    // short-circuit min/max tests once dynamic range is met
+    if (max - min > MIN_DYNAMIC_RANGE) {
+      // finish the rest of the rows quickly
+      for (yy++, offset += width_; yy < BLOCK_SIZE; yy++, offset += width_) {
+        for (int xx = 0; xx < BLOCK_SIZE; xx += 2) {
+          sum += luminances_[offset + xx] & 0xFF;
+          sum += luminances_[offset + xx + 1] & 0xFF;
         }
       }
-      // See
-      // http://groups.google.com/group/zxing/browse_thread/thread/d06efa2c35a7ddc0
-      int average = sum >> (BLOCK_SIZE_POWER * 2);
-      if (max - min <= minDynamicRange) {
-        average = min >> 1;
-        if (y > 0 && x > 0) {
-          int bp = getBlackPointFromNeighbors(blackPoints, subWidth, x, y);
-          if (min < bp) {
-            average = bp;
-          }
-        }
+    }
+  }
+  // See
+  // http://groups.google.com/group/zxing/browse_thread/thread/d06efa2c35a7ddc0
+  int average = sum >> (BLOCK_SIZE_POWER * 2);
+  if (max - min > MIN_DYNAMIC_RANGE) {
+    // min and max were not followed to the end.
+    darkest_[block] = 0;
+    brightest_[block] = 0xFF;
+  } else {
+    darkest_[block] = (unsigned char) min;
+    brightest_[block] = (unsigned char) max;
+    average = min >> 1;
+    if (y > 0 && x > 0) {
+      int bp = (getBlackPoint(x, y - 1) +
+                2 * getBlackPoint(x - 1, y) +
+                getBlackPoint(x - 1, y - 1)) >> 2;
+      if (min < bp) {
+        average = bp;
       }
-      blackPoints[y * subWidth + x] = average;
     }
   }
-  return blackPoints;
+  blackPoints_[block] = average;
+  if (history_) {
+    history_->storeBlackPoint(block, sample, average);
+  }
+  return average;
 }
 
+// Sums every other row of a block, to tell whether it changed since the
+// last frame.
+int BlackTiles::sampleBlock(int offset) const {
+  unsigned char const* pixels = (unsigned char const*) &luminances_[offset];
+  int sum = 0;
+  for (int yy = 1; yy < BLOCK_SIZE; yy += 2) {
+    unsigned char const* row = pixels + yy * width_;
+    for (int xx = 0; xx < BLOCK_SIZE; xx++) {
+      sum += row[xx];
+    }
+  }
+  return sum;
+}
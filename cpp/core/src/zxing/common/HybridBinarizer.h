@@ -32,34 +32,24 @@ namespace zxing {
 	 private:
     Ref<BitMatrix> matrix_;
 	  Ref<BitArray> cached_row_;
+	  // What fills in matrix_, unless the image is too small for blocks.
+	  Ref<BitMatrix::TileSource> tiles_;
 
 	public:
 		HybridBinarizer(Ref<LuminanceSource> source);
+		// For a frame of a video: blocks that look the same as in the frames
+		// before keep the black points they had then.
+		HybridBinarizer(Ref<LuminanceSource> source, Ref<BlackPointHistory> history);
 		virtual ~HybridBinarizer();
 		
+		// Thresholds each 8x8 tile of the matrix the first time it is read;
+		// see BitMatrix::getFilledTileCount().
 		virtual Ref<BitMatrix> getBlackMatrix();
+		// Thresholds each block against the threshold of the block of coarse
+		// that it falls in, if coarse is a HybridBinarizer too, so that no
+		// black points are worked out at full size.
+		virtual Ref<BitMatrix> getFineBlackMatrix(Ref<Binarizer> const& coarse, int scale);
 		Ref<Binarizer> createBinarizer(Ref<LuminanceSource> source);
-  private:
-    // We'll be using one-D arrays because C++ can't dynamically allocate 2D
-    // arrays
-    ArrayRef<int> calculateBlackPoints(ArrayRef<char> luminances,
-                                       int subWidth,
-                                       int subHeight,
-                                       int width,
-                                       int height);
-    void calculateThresholdForBlock(ArrayRef<char> luminances,
-                                    int subWidth,
-                                    int subHeight,
-                                    int width,
-                                    int height,
-                                    ArrayRef<int> blackPoints,
-                                    Ref<BitMatrix> const& matrix);
-    void thresholdBlock(ArrayRef<char>luminances,
-                        int xoffset,
-                        int yoffset,
-                        int threshold,
-                        int stride,
-                        Ref<BitMatrix> const& matrix);
 	};
 
 }
@@ -0,0 +1,143 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/ParallelSearch.h>
+
+#if ZXING_HAS_THREADS
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+#endif
+
+using zxing::ParallelSearch;
+
+namespace {
+
+int findInOrder(ParallelSearch::Task& task, int count) {
+  for (int i = 0; i < count; i++) {
+    if (task.test(0, i)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+#if ZXING_HAS_THREADS
+
+class Search {
+public:
+  Search(ParallelSearch::Task& task, int count, int batchSize)
+    : task_(task), count_(count), batchSize_(batchSize),
+      next_(0), best_(count), errorIndex_(count) {
+  }
+
+  void work(int worker) {
+    for (;;) {
+      int start = next_.fetch_add(batchSize_);
+      if (start >= count_) {
+        return;
+      }
+      int end = std::min(start + batchSize_, count_);
+      for (int i = start; i < end; i++) {
+        if (i >= best_.load()) {
+          return;
+        }
+        try {
+          if (task_.test(worker, i)) {
+            lower(i);
+            break;
+          }
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(errorMutex_);
+          if (i < errorIndex_) {
+            errorIndex_ = i;
+            error_ = std::current_exception();
+          }
+          lower(i);
+          break;
+        }
+      }
+    }
+  }
+
+  int result() {
+    int best = best_.load();
+    if (best == errorIndex_ && best < count_) {
+      std::rethrow_exception(error_);
+    }
+    return best < count_ ? best : -1;
+  }
+
+private:
+  void lower(int index) {
+    int best = best_.load();
+    while (index < best && !best_.compare_exchange_weak(best, index)) {
+    }
+  }
+
+  ParallelSearch::Task& task_;
+  int count_;
+  int batchSize_;
+  std::atomic<int> next_;
+  std::atomic<int> best_;
+  std::mutex errorMutex_;
+  int errorIndex_;
+  std::exception_ptr error_;
+};
+
+void runWorker(Search* search, int worker) {
+  search->work(worker);
+}
+
+#endif
+
+}
+
+bool ParallelSearch::isSupported() {
+  return ZXING_HAS_THREADS != 0;
+}
+
+int ParallelSearch::find(Task& task, int count, int threads, int batchSize) {
+#if ZXING_HAS_THREADS
+  if (threads > 1 && count > batchSize) {
+    Search search(task, count, batchSize);
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int worker = 1; worker < threads; worker++) {
+      try {
+        pool.push_back(std::thread(runWorker, &search, worker));
+      } catch (std::system_error const&) {
+        // Out of threads: carry on with the ones we have.
+        break;
+      }
+    }
+    search.work(0);
+    for (size_t i = 0; i < pool.size(); i++) {
+      pool[i].join();
+    }
+    return search.result();
+  }
+#else
+  (void)threads;
+  (void)batchSize;
+#endif
+  return findInOrder(task, count);
+}
@@ -0,0 +1,58 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __PARALLEL_SEARCH_H__
+#define __PARALLEL_SEARCH_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Threads need C++11; define NO_THREADS to always search on the calling
+// thread.
+#if !defined(NO_THREADS) && \
+  (__cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1700))
+#define ZXING_HAS_THREADS 1
+#else
+#define ZXING_HAS_THREADS 0
+#endif
+
+namespace zxing {
+
+// Finds the first index of a range that passes a test, testing several
+// indices at once on a pool of threads. The answer is always the one a
+// search in index order on a single thread would give.
+class ParallelSearch {
+public:
+  class Task {
+  public:
+    virtual ~Task() {}
+    // Tests index on behalf of the given worker, 0 being the calling
+    // thread. Different workers call this concurrently, so anything shared
+    // between them must only be read, and without touching reference counts.
+    virtual bool test(int worker, int index) = 0;
+  };
+
+  // Whether find() can use threads other than the calling one.
+  static bool isSupported();
+
+  // Returns the smallest index below count that passes task.test(), or -1.
+  // Up to threads workers claim batchSize consecutive indices at a time and
+  // skip those past the best match so far. An exception thrown by test()
+  // is rethrown here unless a smaller index matched.
+  static int find(Task& task, int count, int threads, int batchSize);
+};
+
+}
+
+#endif // __PARALLEL_SEARCH_H__
@@ -0,0 +1,179 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/PresenceGate.h>
+#include <algorithm>
+#include <cmath>
+
+using std::max;
+using std::min;
+using zxing::Ref;
+using zxing::ArrayRef;
+using zxing::LuminanceSource;
+using zxing::PresenceGate;
+
+PresenceGate::PresenceGate(int gridSize)
+  : gridSize_(gridSize < CELL_SIZE ? CELL_SIZE : gridSize), minEnergy_(2000), minDensity_(0.1f),
+    minCoherence_(0.7f), minPeriodicity_(0.4f), width_(0) {
+}
+
+void PresenceGate::setMinGradientEnergy(int energy) {
+  minEnergy_ = energy;
+}
+
+void PresenceGate::setMinTransitionDensity(float density) {
+  minDensity_ = density;
+}
+
+void PresenceGate::setMinCoherence(float coherence) {
+  minCoherence_ = coherence;
+}
+
+void PresenceGate::setMinPeriodicity(float periodicity) {
+  minPeriodicity_ = periodicity;
+}
+
+int PresenceGate::getMinGradientEnergy() const {
+  return minEnergy_;
+}
+
+float PresenceGate::getMinTransitionDensity() const {
+  return minDensity_;
+}
+
+float PresenceGate::getMinCoherence() const {
+  return minCoherence_;
+}
+
+float PresenceGate::getMinPeriodicity() const {
+  return minPeriodicity_;
+}
+
+bool PresenceGate::mayContainBarcode(LuminanceSource const& source) {
+  int width = source.getWidth();
+  int height = source.getHeight();
+  int stepX = (width + gridSize_ - 1) / gridSize_;
+  int stepY = (height + gridSize_ - 1) / gridSize_;
+  width_ = width / stepX;
+  int gridHeight = height / stepY;
+  if (width_ < CELL_SIZE || gridHeight < CELL_SIZE) {
+    // Too small to tell; leave it to the readers.
+    return true;
+  }
+
+  samples_.resize(width_ * gridHeight);
+  ArrayRef<char> row;
+  for (int y = 0; y < gridHeight; y++) {
+    row = source.getRow(y * stepY + stepY / 2, row);
+    int* samples = &samples_[y * width_];
+    for (int x = 0, offset = stepX / 2; x < width_; x++, offset += stepX) {
+      samples[x] = row[offset] & 0xFF;
+    }
+  }
+
+  // The last cell of each row and column is moved back to fit inside the
+  // grid, as HybridBinarizer does with its blocks.
+  for (int y = 0; y < gridHeight; y += CELL_SIZE) {
+    int top = min(y, gridHeight - CELL_SIZE);
+    for (int x = 0; x < width_; x += CELL_SIZE) {
+      int left = min(x, width_ - CELL_SIZE);
+      if (isCandidate(left, top, left + CELL_SIZE, top + CELL_SIZE)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+Ref<PresenceGate> PresenceGate::clone() const {
+  Ref<PresenceGate> copy (new PresenceGate(gridSize_));
+  copy->minEnergy_ = minEnergy_;
+  copy->minDensity_ = minDensity_;
+  copy->minCoherence_ = minCoherence_;
+  copy->minPeriodicity_ = minPeriodicity_;
+  return copy;
+}
+
+bool PresenceGate::isCandidate(int left, int top, int right, int bottom) const {
+  int sum = 0;
+  for (int y = top; y < bottom; y++) {
+    for (int x = left; x < right; x++) {
+      sum += samples_[y * width_ + x];
+    }
+  }
+  int mean = sum / ((right - left) * (bottom - top));
+
+  // The structure tensor of the cell: sums of the products of the steps to
+  // the right and down.
+  int xx = 0;
+  int yy = 0;
+  int xy = 0;
+  for (int y = top; y < bottom - 1; y++) {
+    int const* samples = &samples_[y * width_];
+    for (int x = left; x < right - 1; x++) {
+      int dx = samples[x + 1] - samples[x];
+      int dy = samples[x + width_] - samples[x];
+      xx += dx * dx;
+      yy += dy * dy;
+      xy += dx * dy;
+    }
+  }
+  int steps = (right - left - 1) * (bottom - top - 1);
+  if (xx + yy < minEnergy_ * steps) {
+    return false;
+  }
+
+  // Transitions across the mean, and the runs between them, along rows
+  // (across = 0) and then columns (across = 1).
+  int transitions[2] = {0, 0};
+  int runs = 0;
+  int longRuns = 0;
+  for (int across = 0; across < 2; across++) {
+    int lines = across == 0 ? bottom - top : right - left;
+    int length = across == 0 ? right - left : bottom - top;
+    int stride = across == 0 ? 1 : width_;
+    int lineStride = across == 0 ? width_ : 1;
+    for (int line = 0; line < lines; line++) {
+      int const* samples = &samples_[top * width_ + left + line * lineStride];
+      bool dark = samples[0] <= mean;
+      int runStart = -1;
+      for (int i = 1; i < length; i++) {
+        if ((samples[i * stride] <= mean) != dark) {
+          dark = !dark;
+          transitions[across]++;
+          // Runs cut off by the edge of the cell are not counted.
+          if (runStart >= 0) {
+            runs++;
+            longRuns += i - runStart > 1;
+          }
+          runStart = i;
+        }
+      }
+    }
+  }
+  int lineSteps = (right - left - 1) * (bottom - top);
+  float rowDensity = float(transitions[0]) / lineSteps;
+  float columnDensity = float(transitions[1]) / lineSteps;
+
+  float energy = float(xx + yy);
+  float coherence = (float) std::sqrt(float(xx - yy) * float(xx - yy) + 4.0f * float(xy) * float(xy)) / energy;
+  if (coherence >= minCoherence_ && max(rowDensity, columnDensity) >= minDensity_) {
+    return true;
+  }
+  return min(rowDensity, columnDensity) >= minDensity_ && runs > 0 &&
+    float(longRuns) / runs >= minPeriodicity_;
+}
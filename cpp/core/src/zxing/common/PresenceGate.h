@@ -0,0 +1,81 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __PRESENCE_GATE_H__
+#define __PRESENCE_GATE_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/LuminanceSource.h>
+#include <zxing/common/Counted.h>
+
+namespace zxing {
+
+// Tells from a grid of at most gridSize x gridSize luminances whether an
+// image may hold a barcode at all, so that frames of empty scenes need not
+// go through the readers. The grid is cut into cells of CELL_SIZE samples
+// square, and the image passes as soon as one cell looks like part of a
+// barcode:
+// - its luminance changes from sample to sample by enough on average
+//   (gradient energy),
+// - it crosses its own mean often enough along rows or columns
+//   (transition density), and
+// - either its gradients line up, as across the bars of a 1D barcode
+//   (orientation coherence), or it crosses its mean often enough both ways
+//   in runs mostly longer than one sample, as modules of a 2D barcode do
+//   and noise does not (periodicity).
+// Modules narrower than the spacing of the grid alias into noise, so 2D
+// barcodes that small are missed; 1D ones still line up.
+class PresenceGate : public Counted {
+public:
+  static const int CELL_SIZE = 16;
+
+  explicit PresenceGate(int gridSize = 256);
+
+  // The thresholds a cell has to reach; see above. Energy is the mean of
+  // the squared steps between neighbouring samples, density the share of
+  // steps that cross the cell's mean, and coherence and periodicity range
+  // from 0 to 1.
+  void setMinGradientEnergy(int energy);
+  void setMinTransitionDensity(float density);
+  void setMinCoherence(float coherence);
+  void setMinPeriodicity(float periodicity);
+  int getMinGradientEnergy() const;
+  float getMinTransitionDensity() const;
+  float getMinCoherence() const;
+  float getMinPeriodicity() const;
+
+  bool mayContainBarcode(LuminanceSource const& source);
+
+  // Returns a new gate with the same grid size and thresholds.
+  Ref<PresenceGate> clone() const;
+
+private:
+  bool isCandidate(int left, int top, int right, int bottom) const;
+
+  int gridSize_;
+  int minEnergy_;
+  float minDensity_;
+  float minCoherence_;
+  float minPeriodicity_;
+  // The samples of the last image, kept to save reallocating them.
+  std::vector<int> samples_;
+  int width_;
+};
+
+}
+
+#endif // __PRESENCE_GATE_H__
@@ -33,6 +33,12 @@ String::String(int capacity) {
   text_.reserve(capacity);
 }
 
+Ref<String> String::adopt(std::string& text) {
+  Ref<String> result(new String(0));
+  result->text_.swap(text);
+  return result;
+}
+
 const std::string& String::getText() const {
   return text_;
 }
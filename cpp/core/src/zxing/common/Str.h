@@ -36,6 +36,9 @@ private:
 public:
   explicit String(const std::string &text);
   explicit String(int);
+  // Takes over the characters of text without copying them, leaving text
+  // empty.
+  static Ref<String> adopt(std::string& text);
   char charAt(int) const;
   Ref<String> substring(int) const;
   const std::string& getText() const;
@@ -17,7 +17,24 @@
  */
 
 #include <zxing/common/StringUtils.h>
+#include <zxing/common/CharacterSetTables.h>
 #include <zxing/DecodeHints.h>
+#include <zxing/FormatException.h>
+#include <stdint.h>
+#include <string.h>
+#ifndef NO_ICONV
+#include <iconv.h>
+#endif
+
+// Required for compatibility. TODO: test on Symbian
+#ifdef ZXING_ICONV_CONST
+#undef ICONV_CONST
+#define ICONV_CONST const
+#endif
+
+#ifndef ICONV_CONST
+#define ICONV_CONST /**/
+#endif
 
 using namespace std;
 using namespace zxing;
@@ -34,6 +51,255 @@ char const* const StringUtils::UTF8 = "UTF-8";
 char const* const StringUtils::ISO88591 = "ISO8859-1";
 const bool StringUtils::ASSUME_SHIFT_JIS = false;
 
+namespace {
+
+// Number of leading bytes below 0x80, tested eight at a time so that plain
+// ASCII text costs a couple of operations per word.
+size_t asciiPrefixLength(char const* bytes, size_t length) {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    uint32_t a, b;
+    memcpy(&a, bytes + i, 4);
+    memcpy(&b, bytes + i + 4, 4);
+    if ((a | b) & 0x80808080u) {
+      break;
+    }
+  }
+  while (i < length && (bytes[i] & 0x80) == 0) {
+    i++;
+  }
+  return i;
+}
+
+// Writes c, which is at least 0x80, and returns the end of what was
+// written.
+char* putUTF8(char* out, unsigned int c) {
+  if (c < 0x800) {
+    *out++ = (char) (0xC0 | (c >> 6));
+  } else if (c < 0x10000) {
+    *out++ = (char) (0xE0 | (c >> 12));
+    *out++ = (char) (0x80 | ((c >> 6) & 0x3F));
+  } else {
+    *out++ = (char) (0xF0 | (c >> 18));
+    *out++ = (char) (0x80 | ((c >> 12) & 0x3F));
+    *out++ = (char) (0x80 | ((c >> 6) & 0x3F));
+  }
+  *out++ = (char) (0x80 | (c & 0x3F));
+  return out;
+}
+
+// Each decoder reads one character starting with a byte of 0x80 or above
+// and returns the number of bytes it used, or 0 if the bytes are invalid or
+// outside what the built-in tables cover.
+typedef size_t (*CharDecoder)(unsigned char const* bytes, size_t length,
+                              unsigned short const* upper, unsigned int& c);
+
+size_t decodeASCII(unsigned char const*, size_t, unsigned short const*, unsigned int&) {
+  return 0;
+}
+
+size_t decodeSingleByte(unsigned char const* bytes, size_t,
+                        unsigned short const* upper, unsigned int& c) {
+  c = upper ? upper[bytes[0] - 0x80] : bytes[0];
+  return c ? 1 : 0;
+}
+
+size_t decodeUTF8(unsigned char const* bytes, size_t length,
+                  unsigned short const*, unsigned int& c) {
+  int b = bytes[0];
+  size_t n;
+  unsigned int min;
+  if (b >= 0xC2 && b <= 0xDF) {
+    n = 2;
+    c = b & 0x1F;
+    min = 0x80;
+  } else if (b >= 0xE0 && b <= 0xEF) {
+    n = 3;
+    c = b & 0x0F;
+    min = 0x800;
+  } else if (b >= 0xF0 && b <= 0xF4) {
+    n = 4;
+    c = b & 0x07;
+    min = 0x10000;
+  } else {
+    return 0;
+  }
+  if (length < n) {
+    return 0;
+  }
+  for (size_t i = 1; i < n; i++) {
+    if ((bytes[i] & 0xC0) != 0x80) {
+      return 0;
+    }
+    c = (c << 6) | (bytes[i] & 0x3F);
+  }
+  if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+    return 0;
+  }
+  return n;
+}
+
+size_t decodeDoubleByte(unsigned short const* table, int lead, int trail, unsigned int& c) {
+  if (lead < 0xA1 || lead > 0xFE || trail < 0xA1 || trail > 0xFE) {
+    return 0;
+  }
+  c = table[(lead - 0xA1) * 94 + trail - 0xA1];
+  return c ? 2 : 0;
+}
+
+size_t decodeShiftJIS(unsigned char const* bytes, size_t length,
+                      unsigned short const*, unsigned int& c) {
+  int lead = bytes[0];
+  if (lead >= 0xA1 && lead <= 0xDF) {
+    // half-width katakana
+    c = 0xFF61 + lead - 0xA1;
+    return 1;
+  }
+  if (length < 2 || lead < 0x81 || (lead > 0x9F && lead < 0xE0) || lead > 0xEF) {
+    return 0;
+  }
+  int trail = bytes[1];
+  if (trail < 0x40 || trail == 0x7F || trail > 0xFC) {
+    return 0;
+  }
+  // Each lead byte covers two JIS X 0208 rows; map to the EUC form.
+  int row = ((lead < 0xA0 ? lead - 0x81 : lead - 0xC1) << 1) + (trail >= 0x9F ? 1 : 0);
+  int cell = trail >= 0x9F ? trail - 0x9F : trail - 0x40 - (trail > 0x7F ? 1 : 0);
+  return decodeDoubleByte(JIS_X_0208, 0xA1 + row, 0xA1 + cell, c);
+}
+
+size_t decodeEUCJP(unsigned char const* bytes, size_t length,
+                   unsigned short const*, unsigned int& c) {
+  if (length < 2) {
+    return 0;
+  }
+  if (bytes[0] == 0x8E) {
+    if (bytes[1] < 0xA1 || bytes[1] > 0xDF) {
+      return 0;
+    }
+    c = 0xFF61 + bytes[1] - 0xA1;
+    return 2;
+  }
+  // JIS X 0212 (0x8F prefix) is left to iconv
+  return decodeDoubleByte(JIS_X_0208, bytes[0], bytes[1], c);
+}
+
+size_t decodeGB2312(unsigned char const* bytes, size_t length,
+                    unsigned short const*, unsigned int& c) {
+  // GBK and GB18030 characters outside GB2312 are left to iconv
+  return length < 2 ? 0 : decodeDoubleByte(GB_2312, bytes[0], bytes[1], c);
+}
+
+bool findDecoder(char const* encoding, CharDecoder& decoder, unsigned short const*& upper) {
+  // Compare names in upper case without punctuation, so that "ISO8859_2",
+  // "ISO-8859-2" and "iso88592" all match.
+  char name[16];
+  size_t n = 0;
+  for (char const* p = encoding; *p; p++) {
+    char ch = *p;
+    if (ch >= 'a' && ch <= 'z') {
+      ch = (char) (ch - 'a' + 'A');
+    } else if (!((ch >= 'A' && ch <= 'Z') || (ch >= '0' && ch <= '9'))) {
+      continue;
+    }
+    if (n == sizeof(name) - 1) {
+      return false;
+    }
+    name[n++] = ch;
+  }
+  name[n] = '\0';
+
+  upper = 0;
+  if (!strcmp(name, "ASCII") || !strcmp(name, "USASCII")) {
+    decoder = decodeASCII;
+  } else if (!strcmp(name, "ISO88591") || !strcmp(name, "LATIN1")) {
+    decoder = decodeSingleByte;
+  } else if (!strcmp(name, "UTF8")) {
+    decoder = decodeUTF8;
+  } else if (!strcmp(name, "SHIFTJIS") || !strcmp(name, "SJIS")) {
+    decoder = decodeShiftJIS;
+  } else if (!strcmp(name, "EUCJP")) {
+    decoder = decodeEUCJP;
+  } else if (!strcmp(name, "GB2312") || !strcmp(name, "EUCCN") ||
+             !strcmp(name, "GBK") || !strcmp(name, "GB18030")) {
+    decoder = decodeGB2312;
+  } else {
+    for (SingleByteCharset const* charset = SINGLE_BYTE_CHARSETS; charset->name; charset++) {
+      if (!strcmp(name, charset->name)) {
+        decoder = decodeSingleByte;
+        upper = charset->upper;
+        return true;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+
+// No character takes more than three times as many bytes in UTF-8 as in
+// the encodings handled here, so the output is written in place and
+// trimmed afterwards.
+bool appendBuiltIn(string& result, char const* bytes, size_t length,
+                   CharDecoder decoder, unsigned short const* upper) {
+  unsigned char const* in = (unsigned char const*) bytes;
+  size_t start = result.size();
+  result.resize(start + 3 * length);
+  char* const begin = &result[0];
+  char* out = begin + start;
+  size_t i = 0;
+  while (i < length) {
+    if (in[i] < 0x80) {
+      size_t ascii = asciiPrefixLength(bytes + i, length - i);
+      memcpy(out, bytes + i, ascii);
+      out += ascii;
+      i += ascii;
+      if (i == length) {
+        break;
+      }
+    }
+    unsigned int c;
+    size_t used = decoder(in + i, length - i, upper, c);
+    if (used == 0) {
+      result.resize(start);
+      return false;
+    }
+    out = putUTF8(out, c);
+    i += used;
+  }
+  result.resize(out - begin);
+  return true;
+}
+
+#ifndef NO_ICONV
+// Returns 1 on success, 0 if the bytes could not be converted and -1 if
+// iconv does not know the encoding.
+int appendIconv(string& result, char const* bytes, size_t length, char const* encoding) {
+  iconv_t cd = iconv_open(StringUtils::UTF8, encoding);
+  if (cd == (iconv_t)-1) {
+    return -1;
+  }
+
+  size_t start = result.size();
+  result.resize(start + 4 * length);
+  ICONV_CONST char* fromPtr = (ICONV_CONST char*) bytes;
+  size_t nFrom = length;
+  char* toPtr = &result[start];
+  size_t nTo = 4 * length;
+  while (nFrom > 0) {
+    if (iconv(cd, &fromPtr, &nFrom, &toPtr, &nTo) == (size_t)(-1)) {
+      iconv_close(cd);
+      result.resize(start);
+      return 0;
+    }
+  }
+  iconv_close(cd);
+  result.resize(start + 4 * length - nTo);
+  return 1;
+}
+#endif
+
+}
+
 string
 StringUtils::guessEncoding(char* bytes, int length,
                            Hashtable const& hints) {
@@ -41,6 +307,9 @@ StringUtils::guessEncoding(char* bytes, int length,
   if (i != hints.end()) {
     return i->second;
   }
+  if (length > 0 && asciiPrefixLength(bytes, length) == (size_t) length) {
+    return ISO88591;
+  }
   typedef bool boolean;
   // For now, merely tries to distinguish ISO-8859-1, UTF-8 and Shift_JIS,
   // which should be by far the most common encodings.
@@ -196,3 +465,43 @@ StringUtils::guessEncoding(char* bytes, int length,
   // Otherwise, we take a wild guess with platform encoding
   return PLATFORM_DEFAULT_ENCODING;
 }
+
+void StringUtils::appendUTF8(string& result, char const* bytes, size_t length,
+                             char const* encoding) {
+  if (length == 0) {
+    return;
+  }
+  CharDecoder decoder;
+  unsigned short const* upper;
+  if (findDecoder(encoding, decoder, upper)) {
+    if (appendBuiltIn(result, bytes, length, decoder, upper)) {
+      return;
+    }
+#ifndef NO_ICONV
+    if (appendIconv(result, bytes, length, encoding) == 1) {
+      return;
+    }
+#endif
+    throw FormatException("error converting characters");
+  }
+#ifndef NO_ICONV
+  int converted = appendIconv(result, bytes, length, encoding);
+  if (converted == 0) {
+    throw FormatException("error converting characters");
+  }
+  if (converted == 1) {
+    return;
+  }
+#endif
+  result.append(bytes, length);
+}
+
+void StringUtils::convertToUTF8(string& text, char const* encoding) {
+  size_t ascii = asciiPrefixLength(text.data(), text.size());
+  if (ascii == text.size()) {
+    return;
+  }
+  string converted(text, 0, ascii);
+  appendUTF8(converted, text.data() + ascii, text.size() - ascii, encoding);
+  text.swap(converted);
+}
@@ -44,6 +44,19 @@ public:
   typedef std::map<DecodeHintType, std::string> Hashtable;
 
   static std::string guessEncoding(char* bytes, int length, Hashtable const& hints);
+
+  // Appends length bytes in the given encoding to result, converted to
+  // UTF-8. The ISO-8859 family, the common Windows code pages, Shift_JIS,
+  // EUC-JP, GB2312 and UTF-8 itself are decoded with built-in tables; other
+  // encodings go through iconv when it is available and are appended
+  // unchanged when they are unknown. Throws FormatException if the bytes
+  // are not valid in the encoding.
+  static void appendUTF8(std::string& result, char const* bytes, size_t length,
+                         char const* encoding);
+
+  // Converts text from the given ASCII-compatible encoding to UTF-8 in
+  // place; text that is all ASCII is left untouched.
+  static void convertToUTF8(std::string& text, char const* encoding);
 };
 
 }
@@ -0,0 +1,233 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/detector/RegionProposer.h>
+#include <algorithm>
+
+using std::vector;
+using std::max;
+using std::min;
+using zxing::Ref;
+using zxing::BitArray;
+using zxing::BitMatrix;
+using zxing::CandidateRegion;
+using zxing::RegionProposer;
+
+// VC++
+using zxing::Span;
+
+namespace {
+
+int bitCount(unsigned int i) {
+  // HD, Figure 5-2
+  i = i - ((i >> 1) & 0x55555555);
+  i = (i & 0x33333333) + ((i >> 2) & 0x33333333);
+  i = (i + (i >> 4)) & 0x0F0F0F0F;
+  i = i + (i >> 8);
+  i = i + (i >> 16);
+  return i & 0x3F;
+}
+
+int areaOf(Ref<CandidateRegion> const& region) {
+  return (region->getRight() - region->getLeft()) * (region->getBottom() - region->getTop());
+}
+
+// Busy cells joined into one region: the cells they span, inclusive, and
+// their transitions.
+struct Blob {
+  int left;
+  int top;
+  int right;
+  int bottom;
+  int cells;
+  int across;
+  int down;
+};
+
+bool overlap(Blob const& a, Blob const& b) {
+  return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+void merge(Blob& into, Blob const& from) {
+  into.left = min(into.left, from.left);
+  into.top = min(into.top, from.top);
+  into.right = max(into.right, from.right);
+  into.bottom = max(into.bottom, from.bottom);
+  into.cells += from.cells;
+  into.across += from.across;
+  into.down += from.down;
+}
+
+bool isLarger(Ref<CandidateRegion> const& a, Ref<CandidateRegion> const& b) {
+  return areaOf(a) > areaOf(b);
+}
+
+}
+
+CandidateRegion::CandidateRegion(int left, int top, int right, int bottom, bool oneDimensional)
+  : left_(left), top_(top), right_(right), bottom_(bottom), oneDimensional_(oneDimensional) {
+}
+
+int CandidateRegion::getLeft() const {
+  return left_;
+}
+
+int CandidateRegion::getTop() const {
+  return top_;
+}
+
+int CandidateRegion::getRight() const {
+  return right_;
+}
+
+int CandidateRegion::getBottom() const {
+  return bottom_;
+}
+
+bool CandidateRegion::isOneDimensional() const {
+  return oneDimensional_;
+}
+
+RegionProposer::RegionProposer(Ref<BitMatrix> image)
+  : image_(image),
+    cellsWide_((image->getWidth() + CELL_SIZE - 1) / CELL_SIZE),
+    cellsHigh_((image->getHeight() + CELL_SIZE - 1) / CELL_SIZE) {
+}
+
+// Counts transitions a word of bitsPerWord pixels at a time: along a row
+// they are the bits that differ from the bit before, and down a column the
+// bits that differ from the row below. Rows are not sampled, because down a
+// column that would only see the edges between modules that happen to fall
+// right below a sampled row, and miss whole rows of them.
+void RegionProposer::countTransitions() {
+  across_.assign(cellsWide_ * cellsHigh_, 0);
+  down_.assign(cellsWide_ * cellsHigh_, 0);
+  int width = image_->getWidth();
+  int height = image_->getHeight();
+  int words = (width + BitMatrix::bitsPerWord - 1) / BitMatrix::bitsPerWord;
+  Ref<BitArray> row = image_->getRow(0, Ref<BitArray>());
+  Ref<BitArray> below;
+  for (int y = 0; y < height; y++) {
+    // The last row of a cell is not compared with the first of the next, so
+    // that the edge of a busy cell does not make the one above it busy.
+    bool lastInCell = y + 1 == height || (y + 1) % CELL_SIZE == 0;
+    if (y + 1 < height) {
+      below = image_->getRow(y + 1, below);
+    }
+    Span<int> bits = row->getBitArray();
+    Span<int> belowBits = lastInCell ? bits : below->getBitArray();
+    int* across = &across_[(y / CELL_SIZE) * cellsWide_];
+    int* down = &down_[(y / CELL_SIZE) * cellsWide_];
+    unsigned int last = bits[0] & 1;
+    for (int i = 0; i < words; i++) {
+      unsigned int word = bits[i];
+      int cell = i * BitMatrix::bitsPerWord / CELL_SIZE;
+      // Pixels past the right edge are all 0, so the edge itself may count
+      // as a transition; one per row does not matter.
+      across[cell] += bitCount(word ^ ((word << 1) | last));
+      if (!lastInCell) {
+        down[cell] += bitCount(word ^ (unsigned int) belowBits[i]);
+      }
+      last = word >> (BitMatrix::bitsPerWord - 1);
+    }
+    std::swap(row, below);
+  }
+}
+
+vector<Ref<CandidateRegion> > RegionProposer::propose() {
+  countTransitions();
+  int cells = cellsWide_ * cellsHigh_;
+  // 0 for cells with too few transitions, 1 for those not yet in a region.
+  vector<char> busy (cells);
+  for (int i = 0; i < cells; i++) {
+    busy[i] = across_[i] + down_[i] >= MIN_TRANSITIONS;
+  }
+
+  vector<Blob> blobs;
+  vector<int> stack;
+  for (int start = 0; start < cells; start++) {
+    if (!busy[start]) {
+      continue;
+    }
+    busy[start] = 0;
+    stack.push_back(start);
+    Blob blob = {cellsWide_, cellsHigh_, 0, 0, 0, 0, 0};
+    while (!stack.empty()) {
+      int cell = stack.back();
+      stack.pop_back();
+      int x = cell % cellsWide_;
+      int y = cell / cellsWide_;
+      blob.cells++;
+      blob.across += across_[cell];
+      blob.down += down_[cell];
+      blob.left = min(blob.left, x);
+      blob.top = min(blob.top, y);
+      blob.right = max(blob.right, x);
+      blob.bottom = max(blob.bottom, y);
+      for (int ny = max(0, y - 1); ny <= min(cellsHigh_ - 1, y + 1); ny++) {
+        for (int nx = max(0, x - 1); nx <= min(cellsWide_ - 1, x + 1); nx++) {
+          int neighbour = ny * cellsWide_ + nx;
+          if (busy[neighbour]) {
+            busy[neighbour] = 0;
+            stack.push_back(neighbour);
+          }
+        }
+      }
+    }
+    blob.left = max(0, blob.left - 1);
+    blob.top = max(0, blob.top - 1);
+    blob.right = min(cellsWide_ - 1, blob.right + 1);
+    blob.bottom = min(cellsHigh_ - 1, blob.bottom + 1);
+    blobs.push_back(blob);
+  }
+
+  // A symbol with a quiet stretch inside, such as the middle of a QR code
+  // between its finder patterns, may fall apart into several blobs; grown,
+  // they overlap again.
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < blobs.size(); i++) {
+      for (size_t j = i + 1; j < blobs.size(); j++) {
+        if (overlap(blobs[i], blobs[j])) {
+          merge(blobs[i], blobs[j]);
+          blobs.erase(blobs.begin() + j);
+          j--;
+          merged = true;
+        }
+      }
+    }
+  }
+
+  vector<Ref<CandidateRegion> > regions;
+  for (size_t i = 0; i < blobs.size(); i++) {
+    Blob const& blob = blobs[i];
+    if (blob.cells < MIN_CELLS) {
+      continue;
+    }
+    bool oneDimensional = blob.across >= ORIENTATION_RATIO * blob.down ||
+      blob.down >= ORIENTATION_RATIO * blob.across;
+    regions.push_back(Ref<CandidateRegion>(new CandidateRegion(
+      blob.left * CELL_SIZE,
+      blob.top * CELL_SIZE,
+      min(image_->getWidth(), (blob.right + 1) * CELL_SIZE),
+      min(image_->getHeight(), (blob.bottom + 1) * CELL_SIZE),
+      oneDimensional)));
+  }
+  std::stable_sort(regions.begin(), regions.end(), isLarger);
+  return regions;
+}
@@ -0,0 +1,82 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __REGION_PROPOSER_H__
+#define __REGION_PROPOSER_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+#include <zxing/common/BitMatrix.h>
+#include <zxing/common/Counted.h>
+
+namespace zxing {
+
+// A part of an image that may hold a barcode, in pixels; right and bottom
+// are exclusive.
+class CandidateRegion : public Counted {
+public:
+  CandidateRegion(int left, int top, int right, int bottom, bool oneDimensional);
+  int getLeft() const;
+  int getTop() const;
+  int getRight() const;
+  int getBottom() const;
+  // Whether its black and white alternate along one direction much more
+  // than along the other, as across the bars of a 1D barcode. 2D barcodes,
+  // and 1D ones turned by about 45 degrees, alternate along both.
+  bool isOneDimensional() const;
+
+private:
+  int left_;
+  int top_;
+  int right_;
+  int bottom_;
+  bool oneDimensional_;
+};
+
+// Finds the regions of a black matrix that are busy with black and white
+// transitions. The matrix is cut into cells of CELL_SIZE pixels square, and
+// cells with enough transitions are joined with their neighbours, diagonals
+// included, into regions.
+class RegionProposer {
+public:
+  static const int CELL_SIZE = 32;
+  // Per cell, counting both directions: on average two transitions per row.
+  static const int MIN_TRANSITIONS = 2 * CELL_SIZE;
+  // Regions of fewer cells are too small to hold a readable barcode.
+  static const int MIN_CELLS = 2;
+  // One direction with this many times the transitions of the other makes
+  // a region one dimensional.
+  static const int ORIENTATION_RATIO = 3;
+
+  RegionProposer(Ref<BitMatrix> image);
+  // Largest first, each grown by a cell on every side for quiet zones and
+  // the edges of symbols that fell short of filling their cells.
+  std::vector<Ref<CandidateRegion> > propose();
+
+private:
+  void countTransitions();
+
+  Ref<BitMatrix> image_;
+  int cellsWide_;
+  int cellsHigh_;
+  // Transitions along rows and along columns, by cell.
+  std::vector<int> across_;
+  std::vector<int> down_;
+};
+
+}
+
+#endif // __REGION_PROPOSER_H__
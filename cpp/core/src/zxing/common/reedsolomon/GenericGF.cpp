@@ -28,30 +28,64 @@ using zxing::GenericGF;
 using zxing::GenericGFPoly;
 using zxing::Ref;
 
-Ref<GenericGF> GenericGF::AZTEC_DATA_12(new GenericGF(0x1069, 4096, 1));
-Ref<GenericGF> GenericGF::AZTEC_DATA_10(new GenericGF(0x409, 1024, 1));
-Ref<GenericGF> GenericGF::AZTEC_DATA_6(new GenericGF(0x43, 64, 1));
-Ref<GenericGF> GenericGF::AZTEC_PARAM(new GenericGF(0x13, 16, 1));
-Ref<GenericGF> GenericGF::QR_CODE_FIELD_256(new GenericGF(0x011D, 256, 0));
-Ref<GenericGF> GenericGF::DATA_MATRIX_FIELD_256(new GenericGF(0x012D, 256, 1));
-Ref<GenericGF> GenericGF::AZTEC_DATA_8 = DATA_MATRIX_FIELD_256;
-Ref<GenericGF> GenericGF::MAXICODE_FIELD_64 = AZTEC_DATA_6;
-  
 namespace {
-  int INITIALIZATION_THRESHOLD = 0;
+
+// Fields, and the polynomials they share, are used by every decoder on any
+// thread.
+Ref<GenericGF> makeField(int primitive, int size, int b) {
+  Ref<GenericGF> field (new GenericGF(primitive, size, b));
+  field->makePermanent();
+  Ref<GenericGFPoly> zero = field->getZero();
+  Ref<GenericGFPoly> one = field->getOne();
+  zero->makePermanent();
+  zero->getCoefficients()->makePermanent();
+  one->makePermanent();
+  one->getCoefficients()->makePermanent();
+  return field;
 }
-  
-GenericGF::GenericGF(int primitive_, int size_, int b)
-  : size(size_), primitive(primitive_), generatorBase(b), initialized(false) {
-  if (size <= INITIALIZATION_THRESHOLD) {
-    initialize();
-  }
+
+}
+
+Ref<GenericGF> GenericGF::AZTEC_DATA_12() {
+  static const Ref<GenericGF> field(makeField(0x1069, 4096, 1));
+  return field;
+}
+
+Ref<GenericGF> GenericGF::AZTEC_DATA_10() {
+  static const Ref<GenericGF> field(makeField(0x409, 1024, 1));
+  return field;
+}
+
+Ref<GenericGF> GenericGF::AZTEC_DATA_8() {
+  return DATA_MATRIX_FIELD_256();
+}
+
+Ref<GenericGF> GenericGF::AZTEC_DATA_6() {
+  static const Ref<GenericGF> field(makeField(0x43, 64, 1));
+  return field;
+}
+
+Ref<GenericGF> GenericGF::AZTEC_PARAM() {
+  static const Ref<GenericGF> field(makeField(0x13, 16, 1));
+  return field;
+}
+
+Ref<GenericGF> GenericGF::QR_CODE_FIELD_256() {
+  static const Ref<GenericGF> field(makeField(0x011D, 256, 0));
+  return field;
+}
+
+Ref<GenericGF> GenericGF::DATA_MATRIX_FIELD_256() {
+  static const Ref<GenericGF> field(makeField(0x012D, 256, 1));
+  return field;
+}
+
+Ref<GenericGF> GenericGF::MAXICODE_FIELD_64() {
+  return AZTEC_DATA_6();
 }
   
-void GenericGF::initialize() {
-  expTable.resize(size);
-  logTable.resize(size);
-    
+GenericGF::GenericGF(int primitive_, int size_, int b)
+  : expTable(size_), logTable(size_), size(size_), primitive(primitive_), generatorBase(b) {
   int x = 1;
     
   for (int i = 0; i < size; i++) {
@@ -67,40 +101,29 @@ void GenericGF::initialize() {
   }
   //logTable[0] == 0 but this should never be used
   zero =
-    Ref<GenericGFPoly>(new GenericGFPoly(Ref<GenericGF>(this), ArrayRef<int>(new Array<int>(1))));
+    Ref<GenericGFPoly>(new GenericGFPoly(Ref<GenericGF>(this), ArrayRef<int>(1)));
   zero->getCoefficients()[0] = 0;
   one =
-    Ref<GenericGFPoly>(new GenericGFPoly(Ref<GenericGF>(this), ArrayRef<int>(new Array<int>(1))));
+    Ref<GenericGFPoly>(new GenericGFPoly(Ref<GenericGF>(this), ArrayRef<int>(1)));
   one->getCoefficients()[0] = 1;
-  initialized = true;
-}
-  
-void GenericGF::checkInit() {
-  if (!initialized) {
-    initialize();
-  }
 }
   
 Ref<GenericGFPoly> GenericGF::getZero() {
-  checkInit();
   return zero;
 }
   
 Ref<GenericGFPoly> GenericGF::getOne() {
-  checkInit();
   return one;
 }
   
 Ref<GenericGFPoly> GenericGF::buildMonomial(int degree, int coefficient) {
-  checkInit();
-    
   if (degree < 0) {
     throw IllegalArgumentException("Degree must be non-negative");
   }
   if (coefficient == 0) {
     return zero;
   }
-  ArrayRef<int> coefficients(new Array<int>(degree + 1));
+  ArrayRef<int> coefficients(degree + 1);
   coefficients[0] = coefficient;
     
   return Ref<GenericGFPoly>(new GenericGFPoly(Ref<GenericGF>(this), coefficients));
@@ -111,12 +134,10 @@ int GenericGF::addOrSubtract(int a, int b) {
 }
   
 int GenericGF::exp(int a) {
-  checkInit();
   return expTable[a];
 }
   
 int GenericGF::log(int a) {
-  checkInit();
   if (a == 0) {
     throw IllegalArgumentException("cannot give log(0)");
   }
@@ -124,7 +145,6 @@ int GenericGF::log(int a) {
 }
   
 int GenericGF::inverse(int a) {
-  checkInit();
   if (a == 0) {
     throw IllegalArgumentException("Cannot calculate the inverse of 0");
   }
@@ -132,8 +152,6 @@ int GenericGF::inverse(int a) {
 }
   
 int GenericGF::multiply(int a, int b) {
-  checkInit();
-    
   if (a == 0 || b == 0) {
     return 0;
   }
@@ -38,20 +38,17 @@ namespace zxing {
     int size;
     int primitive;
     int generatorBase;
-    bool initialized;
-    
-    void initialize();
-    void checkInit();
     
   public:
-    static Ref<GenericGF> AZTEC_DATA_12;
-    static Ref<GenericGF> AZTEC_DATA_10;
-    static Ref<GenericGF> AZTEC_DATA_8;
-    static Ref<GenericGF> AZTEC_DATA_6;
-    static Ref<GenericGF> AZTEC_PARAM;
-    static Ref<GenericGF> QR_CODE_FIELD_256;
-    static Ref<GenericGF> DATA_MATRIX_FIELD_256;
-    static Ref<GenericGF> MAXICODE_FIELD_64;
+    // The predefined fields are created, and their tables built, on first use.
+    static Ref<GenericGF> AZTEC_DATA_12();
+    static Ref<GenericGF> AZTEC_DATA_10();
+    static Ref<GenericGF> AZTEC_DATA_8();
+    static Ref<GenericGF> AZTEC_DATA_6();
+    static Ref<GenericGF> AZTEC_PARAM();
+    static Ref<GenericGF> QR_CODE_FIELD_256();
+    static Ref<GenericGF> DATA_MATRIX_FIELD_256();
+    static Ref<GenericGF> MAXICODE_FIELD_64();
     
     GenericGF(int primitive, int size, int b);
     
@@ -21,6 +21,7 @@
 
 #include <zxing/datamatrix/DataMatrixReader.h>
 #include <zxing/datamatrix/detector/Detector.h>
+#include <zxing/NotFoundException.h>
 #include <iostream>
 
 namespace zxing {
@@ -33,13 +34,17 @@ DataMatrixReader::DataMatrixReader() :
 }
 
 Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  (void)hints;
-  Detector detector(image->getBlackMatrix());
-  Ref<DetectorResult> detectorResult(detector.detect());
-  ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
-
-
-  Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+  Ref<DecoderResult> decoderResult;
+  ArrayRef< Ref<ResultPoint> > points;
+  if (hints.getPureBarcode()) {
+    decoderResult = decoder_.decode(extractPureBits(image->getBlackMatrix()));
+    points = new Array< Ref<ResultPoint> >();
+  } else {
+    Detector detector(image->getBlackMatrix());
+    Ref<DetectorResult> detectorResult(detector.detect());
+    points = detectorResult->getPoints();
+    decoderResult = decoder_.decode(detectorResult->getBits());
+  }
 
   Ref<Result> result(
     new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat::DATA_MATRIX));
@@ -47,6 +52,75 @@ Ref<Result> DataMatrixReader::decode(Ref<BinaryBitmap> image, DecodeHints hints)
   return result;
 }
 
+/**
+ * This method detects a code in a "pure" image -- that is, pure monochrome image
+ * which contains only an unrotated, unskewed, image of a code, with some white border
+ * around it. This is a specialized method that works exceptionally fast in this special
+ * case.
+ */
+Ref<BitMatrix> DataMatrixReader::extractPureBits(Ref<BitMatrix> image) {
+  ArrayRef<int> leftTopBlack = image->getTopLeftOnBit();
+  ArrayRef<int> rightBottomBlack = image->getBottomRightOnBit();
+  if (!leftTopBlack || !rightBottomBlack) {
+    throw NotFoundException("DataMatrixReader::extractPureBits: no black pixels");
+  }
+
+  int nModuleSize = moduleSize(leftTopBlack, image);
+
+  int top = leftTopBlack[1];
+  int bottom = rightBottomBlack[1];
+  int left = leftTopBlack[0];
+  int right = rightBottomBlack[0];
+
+  int matrixWidth = (right - left + 1) / nModuleSize;
+  int matrixHeight = (bottom - top + 1) / nModuleSize;
+  if (matrixWidth <= 0 || matrixHeight <= 0) {
+    throw NotFoundException("DataMatrixReader::extractPureBits: no matrix found");
+  }
+
+  // Push in the "border" by half the module width so that we start
+  // sampling in the middle of the module. Just in case the image is a
+  // little off, this will help recover.
+  int nudge = nModuleSize >> 1;
+  top += nudge;
+  left += nudge;
+
+  // Now just read off the bits
+  Ref<BitMatrix> bits(new BitMatrix(matrixWidth, matrixHeight));
+  for (int y = 0; y < matrixHeight; y++) {
+    int iOffset = top + y * nModuleSize;
+    for (int x = 0; x < matrixWidth; x++) {
+      if (image->get(left + x * nModuleSize, iOffset)) {
+        bits->set(x, y);
+      }
+    }
+  }
+  return bits;
+}
+
+int DataMatrixReader::moduleSize(ArrayRef<int> leftTopBlack, Ref<BitMatrix> image) {
+  // The top edge starts with a one module wide black timing mark
+  int width = image->getWidth();
+  int x = leftTopBlack[0];
+  int y = leftTopBlack[1];
+  while (x < width && image->get(x, y)) {
+    x++;
+  }
+  if (x == width) {
+    throw NotFoundException("DataMatrixReader::moduleSize: not found");
+  }
+
+  int moduleSize = x - leftTopBlack[0];
+  if (moduleSize == 0) {
+    throw NotFoundException("DataMatrixReader::moduleSize: is zero");
+  }
+  return moduleSize;
+}
+
+Ref<Reader> DataMatrixReader::cloneReader() const {
+  return Ref<Reader>(new DataMatrixReader());
+}
+
 DataMatrixReader::~DataMatrixReader() {
 }
 
@@ -32,9 +32,13 @@ class DataMatrixReader : public Reader {
 private:
   Decoder decoder_;
 
+  static Ref<BitMatrix> extractPureBits(Ref<BitMatrix> image);
+  static int moduleSize(ArrayRef<int> leftTopBlack, Ref<BitMatrix> image);
+
 public:
   DataMatrixReader();
   virtual Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  virtual Ref<Reader> cloneReader() const;
   virtual ~DataMatrixReader();
 
 };
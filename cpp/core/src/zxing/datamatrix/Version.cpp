@@ -61,9 +61,6 @@ ECBlocks::~ECBlocks() {
   }
 }
 
-vector<Ref<Version> > Version::VERSIONS;
-static int N_VERSIONS = Version::buildVersions();
-
 Version::Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
 		int dataRegionSizeColumns, ECBlocks* ecBlocks) : versionNumber_(versionNumber), 
 		symbolSizeRows_(symbolSizeRows), symbolSizeColumns_(symbolSizeColumns), 
@@ -120,8 +117,9 @@ Ref<Version> Version::getVersionForDimensions(int numRows, int numColumns) {
     // TODO(bbrown): This is doing a linear search through the array of versions.
     // If we interleave the rectangular versions with the square versions we could
     // do a binary search.
-    for (int i = 0; i < N_VERSIONS; ++i){
-      Ref<Version> version(VERSIONS[i]);
+    vector<Ref<Version> > const& versions = allVersions();
+    for (size_t i = 0; i < versions.size(); ++i){
+      Ref<Version> version(versions[i]);
       if (version->getSymbolSizeRows() == numRows && version->getSymbolSizeColumns() == numColumns) {
         return version;
       }
@@ -129,10 +127,17 @@ Ref<Version> Version::getVersionForDimensions(int numRows, int numColumns) {
     throw ReaderException("Error version not found");
   }
 
+// Built on first use rather than during static initialization.
+vector<Ref<Version> > const& Version::allVersions() {
+  static const vector<Ref<Version> > versions = buildVersions();
+  return versions;
+}
+
 /**
  * See ISO 16022:2006 5.5.1 Table 7
  */
-int Version::buildVersions() {
+vector<Ref<Version> > Version::buildVersions() {
+  vector<Ref<Version> > VERSIONS;
   VERSIONS.push_back(Ref<Version>(new Version(1, 10, 10, 8, 8,
             					  new ECBlocks(5, new ECB(1, 3)))));
   VERSIONS.push_back(Ref<Version>(new Version(2, 12, 12, 10, 10,
@@ -193,7 +198,11 @@ int Version::buildVersions() {
 					              new ECBlocks(24, new ECB(1, 32)))));
   VERSIONS.push_back(Ref<Version>(new Version(30, 16, 48, 14, 22,
 					              new ECBlocks(28, new ECB(1, 49)))));
-  return (int) VERSIONS.size();
+  // Handed out to decoders on any thread.
+  for (size_t i = 0; i < VERSIONS.size(); i++) {
+    VERSIONS[i]->makePermanent();
+  }
+  return VERSIONS;
 }
 }
 }
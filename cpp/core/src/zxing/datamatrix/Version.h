@@ -1,5 +1,5 @@
-#ifndef __VERSION_H__
-#define __VERSION_H__
+#ifndef __VERSION_DM_H__
+#define __VERSION_DM_H__
 
 /*
  *  Version.h
@@ -62,10 +62,10 @@ private:
   int totalCodewords_;
   Version(int versionNumber, int symbolSizeRows, int symbolSizeColumns, int dataRegionSizeRows,
 		  int dataRegionSizeColumns, ECBlocks *ecBlocks);
+  static std::vector<Ref<Version> > buildVersions();
+  static std::vector<Ref<Version> > const& allVersions();
 
 public:
-  static std::vector<Ref<Version> > VERSIONS;
-  
   ~Version();
   int getVersionNumber();
   int getSymbolSizeRows();
@@ -74,8 +74,7 @@ public:
   int getDataRegionSizeColumns();
   int getTotalCodewords();
   ECBlocks* getECBlocks();
-  static int  buildVersions();  
-  Ref<Version> getVersionForDimensions(int numRows, int numColumns);
+  static Ref<Version> getVersionForDimensions(int numRows, int numColumns);
   
 private:
   Version(const Version&);
@@ -84,4 +83,4 @@ private:
 }
 }
 
-#endif // __VERSION_H__
+#endif // __VERSION_DM_H__
@@ -50,7 +50,7 @@ Ref<Version> BitMatrixParser::readVersion(Ref<BitMatrix> bitMatrix) {
   int numRows = bitMatrix->getHeight();
   int numColumns = bitMatrix->getWidth();
 
-  Ref<Version> version = parsedVersion_->getVersionForDimensions(numRows, numColumns);
+  Ref<Version> version = Version::getVersionForDimensions(numRows, numColumns);
   if (version != 0) {
     return version;
   }
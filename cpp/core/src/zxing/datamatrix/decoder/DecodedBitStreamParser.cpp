@@ -23,38 +23,99 @@
 #include <zxing/datamatrix/decoder/DecodedBitStreamParser.h>
 #include <iostream>
 #include <zxing/common/DecoderResult.h>
+#include <zxing/common/StringUtils.h>
 
 namespace zxing {
 namespace datamatrix {
 
 using namespace std;
 
-const char DecodedBitStreamParser::C40_BASIC_SET_CHARS[] = {
+namespace {
+
+/**
+ * See ISO 16022:2006, Annex C Table C.1
+ * The C40 Basic Character Set (*'s used for placeholders for the shift values)
+ */
+const char C40_BASIC_SET_CHARS[] = {
     '*', '*', '*', ' ', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
     'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N',
     'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z'
 };
-  
-const char DecodedBitStreamParser::C40_SHIFT2_SET_CHARS[] = {
+
+const char C40_SHIFT2_SET_CHARS[] = {
     '!', '"', '#', '$', '%', '&', '\'', '(', ')', '*', '+', ',', '-', '.',
     '/', ':', ';', '<', '=', '>', '?', '@', '[', '\\', ']', '^', '_'
 };
-  
-const char DecodedBitStreamParser::TEXT_BASIC_SET_CHARS[] = {
+
+/**
+ * See ISO 16022:2006, Annex C Table C.2
+ * The Text Basic Character Set (*'s used for placeholders for the shift values)
+ */
+const char TEXT_BASIC_SET_CHARS[] = {
     '*', '*', '*', ' ', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9',
     'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n',
     'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'
 };
-  
-const char DecodedBitStreamParser::TEXT_SHIFT3_SET_CHARS[] = {
+
+const char TEXT_SHIFT3_SET_CHARS[] = {
     '\'', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N',
     'O', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '{', '|', '}', '~', (char) 127
 };
 
+// Entries of the C40 and Text tables below C40_SHIFT are characters.
+const int C40_SHIFT = 256;  // C40_SHIFT + n selects set n for the next value
+const int C40_FNC1 = 260;
+const int C40_UPPER_SHIFT = 261;
+const int C40_INVALID = 262;
+
+// A value decodes through one of four sets: the basic set and shifts 1 to
+// 3. The first value of a triple can reach 40, which only shifts 1 and 3
+// of C40 define.
+typedef short C40Set[41];
+
+struct C40Tables {
+  C40Set sets[2][4];
+
+  C40Tables() {
+    for (int text = 0; text < 2; text++) {
+      C40Set* set = sets[text];
+      char const* basic = text ? TEXT_BASIC_SET_CHARS : C40_BASIC_SET_CHARS;
+      for (int value = 0; value <= 40; value++) {
+        if (value < 3) {
+          set[0][value] = (short) (C40_SHIFT + value + 1);
+        } else {
+          set[0][value] = (short) (value < 40 ? basic[value] : C40_INVALID);
+        }
+        set[1][value] = (short) value;
+        if (value < 27) {
+          set[2][value] = C40_SHIFT2_SET_CHARS[value];
+        } else {
+          set[2][value] = (short) (value == 27 ? C40_FNC1 : value == 30 ? C40_UPPER_SHIFT : C40_INVALID);
+        }
+        if (text) {
+          set[3][value] = (short) (value < 32 ? (unsigned char) TEXT_SHIFT3_SET_CHARS[value] : C40_INVALID);
+        } else {
+          set[3][value] = (short) (value + 96);
+        }
+      }
+    }
+  }
+};
+
+C40Set const* c40Sets(bool text) {
+  static const C40Tables tables;
+  return tables.sets[text ? 1 : 0];
+}
+
+}
+
 Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<char> bytes) {
-  Ref<BitSource> bits(new BitSource(bytes));
-  ostringstream result;
-  ostringstream resultTrailer;
+  BitSource bits(bytes);
+  string result;
+  // Two digits per ASCII codeword, or a Latin-1 character that takes two
+  // bytes in UTF-8, is the most a data codeword usually decodes to.
+  result.reserve(bytes->size() * 2);
+  string resultTrailer;
   vector<char> byteSegments;
   int mode = ASCII_ENCODE;
   do {
@@ -63,10 +124,10 @@ Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<char> bytes) {
     } else {
       switch (mode) {
         case C40_ENCODE:
-          decodeC40Segment(bits, result);
+          decodeC40OrTextSegment(bits, result, false);
           break;
         case TEXT_ENCODE:
-          decodeTextSegment(bits, result);
+          decodeC40OrTextSegment(bits, result, true);
           break;
         case ANSIX12_ENCODE:
           decodeAnsiX12Segment(bits, result);
@@ -82,42 +143,38 @@ Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<char> bytes) {
       }
       mode = ASCII_ENCODE;
     }
-  } while (mode != PAD_ENCODE && bits->available() > 0);
+  } while (mode != PAD_ENCODE && bits.available() > 0);
 
-  if (resultTrailer.str().size() > 0) {
-    result << resultTrailer.str();
-  }
-  ArrayRef<char> rawBytes(bytes);
-  Ref<String> text(new String(result.str()));
-  return Ref<DecoderResult>(new DecoderResult(rawBytes, text));
+  result += resultTrailer;
+  // Upper shifted and Base 256 characters are ISO-8859-1
+  common::StringUtils::convertToUTF8(result, common::StringUtils::ISO88591);
+  return Ref<DecoderResult>(new DecoderResult(bytes, String::adopt(result)));
 }
 
-int DecodedBitStreamParser::decodeAsciiSegment(Ref<BitSource> bits, ostringstream & result,
-  ostringstream & resultTrailer) {
+int DecodedBitStreamParser::decodeAsciiSegment(BitSource& bits, string & result,
+  string & resultTrailer) {
   bool upperShift = false;
   do {
-    int oneByte = bits->readBits(8);
+    int oneByte = bits.readBits(8);
     if (oneByte == 0) {
       throw FormatException("Not enough bits to decode");
     } else if (oneByte <= 128) {  // ASCII data (ASCII value + 1)
       oneByte = upperShift ? (oneByte + 128) : oneByte;
       // upperShift = false;
-      result << (char) (oneByte - 1);
+      result += (char) (oneByte - 1);
       return ASCII_ENCODE;
     } else if (oneByte == 129) {  // Pad
       return PAD_ENCODE;
     } else if (oneByte <= 229) {  // 2-digit data 00-99 (Numeric Value + 130)
       int value = oneByte - 130;
-      if (value < 10) { // padd with '0' for single digit values
-        result << '0';
-      }
-      result << value;
+      result += (char) ('0' + value / 10);
+      result += (char) ('0' + value % 10);
     } else if (oneByte == 230) {  // Latch to C40 encodation
       return C40_ENCODE;
     } else if (oneByte == 231) {  // Latch to Base 256 encodation
       return BASE256_ENCODE;
     } else if (oneByte == 232) {  // FNC1
-      result << ((char) 29); // translate as ASCII 29
+      result += (char) 29; // translate as ASCII 29
     } else if (oneByte == 233 || oneByte == 234) {
       // Structured Append, Reader Programming
       // Ignore these symbols for now
@@ -125,11 +182,11 @@ int DecodedBitStreamParser::decodeAsciiSegment(Ref<BitSource> bits, ostringstrea
     } else if (oneByte == 235) {  // Upper Shift (shift to Extended ASCII)
       upperShift = true;
     } else if (oneByte == 236) {  // 05 Macro
-        result << ("[)>RS05GS");
-        resultTrailer << ("RSEOT");
+        result += "[)>RS05GS";
+        resultTrailer += "RSEOT";
     } else if (oneByte == 237) {  // 06 Macro
-      result << ("[)>RS06GS");
-      resultTrailer <<  ("RSEOT");
+      result += "[)>RS06GS";
+      resultTrailer += "RSEOT";
     } else if (oneByte == 238) {  // Latch to ANSI X12 encodation
       return ANSIX12_ENCODE;
     } else if (oneByte == 239) {  // Latch to Text encodation
@@ -142,205 +199,90 @@ int DecodedBitStreamParser::decodeAsciiSegment(Ref<BitSource> bits, ostringstrea
       // Ignore this symbol for now
     } else if (oneByte >= 242) { // Not to be used in ASCII encodation
       // ... but work around encoders that end with 254, latch back to ASCII
-      if (oneByte != 254 || bits->available() != 0) {
+      if (oneByte != 254 || bits.available() != 0) {
         throw FormatException("Not to be used in ASCII encodation");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
   return ASCII_ENCODE;
 }
 
-void DecodedBitStreamParser::decodeC40Segment(Ref<BitSource> bits, ostringstream & result) {
-  // Three C40 values are encoded in a 16-bit value as
+void DecodedBitStreamParser::decodeC40OrTextSegment(BitSource& bits, string & result, bool text) {
+  // Three C40 or Text values are encoded in a 16-bit value as
   // (1600 * C1) + (40 * C2) + C3 + 1
   // TODO(bbrown): The Upper Shift with C40 doesn't work in the 4 value scenario all the time
+  C40Set const* sets = c40Sets(text);
   bool upperShift = false;
 
   int cValues[3];
   int shift = 0;
   do {
     // If there is only one byte left then it will be encoded as ASCII
-    if (bits->available() == 8) {
+    if (bits.available() == 8) {
       return;
     }
-    int firstByte = bits->readBits(8);
+    int firstByte = bits.readBits(8);
     if (firstByte == 254) {  // Unlatch codeword
       return;
     }
 
-    parseTwoBytes(firstByte, bits->readBits(8), cValues);
+    parseTwoBytes(firstByte, bits.readBits(8), cValues);
 
     for (int i = 0; i < 3; i++) {
-      int cValue = cValues[i];
-      switch (shift) {
-        case 0:
-          if (cValue < 3) {
-            shift = cValue + 1;
-          } else {
-            if (upperShift) {
-              result << (char) (C40_BASIC_SET_CHARS[cValue] + 128);
-              upperShift = false;
-            } else {
-              result << C40_BASIC_SET_CHARS[cValue];
-            }
-          }
-          break;
-        case 1:
-          if (upperShift) {
-            result << (char) (cValue + 128);
-            upperShift = false;
-          } else {
-            result << (char) cValue;
-          }
-          shift = 0;
-          break;
-        case 2:
-          if (cValue < 27) {
-            if (upperShift) {
-              result << (char) (C40_SHIFT2_SET_CHARS[cValue] + 128);
-              upperShift = false;
-            } else {
-              result << C40_SHIFT2_SET_CHARS[cValue];
-            }
-          } else if (cValue == 27) {  // FNC1
-            result << ((char) 29); // translate as ASCII 29
-          } else if (cValue == 30) {  // Upper Shift
-            upperShift = true;
-          } else {
-            throw FormatException("decodeC40Segment: Upper Shift");
-          }
-          shift = 0;
-          break;
-        case 3:
-          if (upperShift) {
-            result << (char) (cValue + 224);
-            upperShift = false;
-          } else {
-            result << (char) (cValue + 96);
-          }
-          shift = 0;
-          break;
-        default:
-          throw FormatException("decodeC40Segment: no case");
-      }
-    }
-  } while (bits->available() > 0);
-}
-
-void DecodedBitStreamParser::decodeTextSegment(Ref<BitSource> bits, ostringstream & result) {
-  // Three Text values are encoded in a 16-bit value as
-  // (1600 * C1) + (40 * C2) + C3 + 1
-  // TODO(bbrown): The Upper Shift with Text doesn't work in the 4 value scenario all the time
-  bool upperShift = false;
-
-  int cValues[3];
-  int shift = 0;
-  do {
-    // If there is only one byte left then it will be encoded as ASCII
-    if (bits->available() == 8) {
-      return;
-    }
-    int firstByte = bits->readBits(8);
-    if (firstByte == 254) {  // Unlatch codeword
-      return;
-    }
-
-    parseTwoBytes(firstByte, bits->readBits(8), cValues);
-
-    for (int i = 0; i < 3; i++) {
-      int cValue = cValues[i];
-      switch (shift) {
-        case 0:
-          if (cValue < 3) {
-            shift = cValue + 1;
-          } else {
-            if (upperShift) {
-              result << (char) (TEXT_BASIC_SET_CHARS[cValue] + 128);
-              upperShift = false;
-            } else {
-              result << (TEXT_BASIC_SET_CHARS[cValue]);
-            }
-          }
-          break;
-        case 1:
-          if (upperShift) {
-            result << (char) (cValue + 128);
-            upperShift = false;
-          } else {
-            result << (char) (cValue);
-          }
-          shift = 0;
-          break;
-        case 2:
-          // Shift 2 for Text is the same encoding as C40
-          if (cValue < 27) {
-            if (upperShift) {
-              result << (char) (C40_SHIFT2_SET_CHARS[cValue] + 128);
-              upperShift = false;
-            } else {
-              result << (C40_SHIFT2_SET_CHARS[cValue]);
-            }
-          } else if (cValue == 27) {  // FNC1
-            result << ((char) 29); // translate as ASCII 29
-          } else if (cValue == 30) {  // Upper Shift
-            upperShift = true;
-          } else {
-            throw FormatException("decodeTextSegment: Upper Shift");
-          }
-          shift = 0;
-          break;
-        case 3:
-          if (upperShift) {
-            result << (char) (TEXT_SHIFT3_SET_CHARS[cValue] + 128);
-            upperShift = false;
-          } else {
-            result << (TEXT_SHIFT3_SET_CHARS[cValue]);
-          }
-          shift = 0;
-          break;
-        default:
-          throw FormatException("decodeTextSegment: no case");
+      int entry = sets[shift][cValues[i]];
+      shift = 0;
+      if (entry < C40_SHIFT) {
+        result += (char) (upperShift ? entry + 128 : entry);
+        upperShift = false;
+      } else if (entry < C40_FNC1) {
+        shift = entry - C40_SHIFT;
+      } else if (entry == C40_FNC1) {
+        result += (char) 29; // translate as ASCII 29
+      } else if (entry == C40_UPPER_SHIFT) {
+        upperShift = true;
+      } else {
+        throw FormatException(text ? "decodeTextSegment: invalid value" : "decodeC40Segment: invalid value");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
 
-void DecodedBitStreamParser::decodeAnsiX12Segment(Ref<BitSource> bits, ostringstream & result) {
+void DecodedBitStreamParser::decodeAnsiX12Segment(BitSource& bits, string & result) {
   // Three ANSI X12 values are encoded in a 16-bit value as
   // (1600 * C1) + (40 * C2) + C3 + 1
 
   int cValues[3];
   do {
     // If there is only one byte left then it will be encoded as ASCII
-    if (bits->available() == 8) {
+    if (bits.available() == 8) {
       return;
     }
-    int firstByte = bits->readBits(8);
+    int firstByte = bits.readBits(8);
     if (firstByte == 254) {  // Unlatch codeword
       return;
     }
 
-    parseTwoBytes(firstByte, bits->readBits(8), cValues);
+    parseTwoBytes(firstByte, bits.readBits(8), cValues);
 
     for (int i = 0; i < 3; i++) {
       int cValue = cValues[i];
       if (cValue == 0) {  // X12 segment terminator <CR>
-        result << '\r';
+        result += '\r';
       } else if (cValue == 1) {  // X12 segment separator *
-        result << '*';
+        result += '*';
       } else if (cValue == 2) {  // X12 sub-element separator >
-        result << '>';
+        result += '>';
       } else if (cValue == 3) {  // space
-        result << ' ';
+        result += ' ';
       } else if (cValue < 14) {  // 0 - 9
-        result << (char) (cValue + 44);
+        result += (char) (cValue + 44);
       } else if (cValue < 40) {  // A - Z
-        result << (char) (cValue + 51);
+        result += (char) (cValue + 51);
       } else {
         throw FormatException("decodeAnsiX12Segment: no case");
       }
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
 
 void DecodedBitStreamParser::parseTwoBytes(int firstByte, int secondByte, int* result) {
@@ -353,22 +295,22 @@ void DecodedBitStreamParser::parseTwoBytes(int firstByte, int secondByte, int* r
   result[2] = fullBitValue - temp * 40;
 }
   
-void DecodedBitStreamParser::decodeEdifactSegment(Ref<BitSource> bits, ostringstream & result) {
+void DecodedBitStreamParser::decodeEdifactSegment(BitSource& bits, string & result) {
   do {
     // If there is only two or less bytes left then it will be encoded as ASCII
-    if (bits->available() <= 16) {
+    if (bits.available() <= 16) {
       return;
     }
 
     for (int i = 0; i < 4; i++) {
-      int edifactValue = bits->readBits(6);
+      int edifactValue = bits.readBits(6);
 
       // Check for the unlatch character
       if (edifactValue == 0x1f) {  // 011111
         // Read rest of byte, which should be 0, and stop
-        int bitsLeft = 8 - bits->getBitOffset();
+        int bitsLeft = 8 - bits.getBitOffset();
         if (bitsLeft != 8) {
-          bits->readBits(bitsLeft);
+          bits.readBits(bitsLeft);
         }
         return;
       }
@@ -376,22 +318,22 @@ void DecodedBitStreamParser::decodeEdifactSegment(Ref<BitSource> bits, ostringst
       if ((edifactValue & 0x20) == 0) {  // no 1 in the leading (6th) bit
         edifactValue |= 0x40;  // Add a leading 01 to the 6 bit binary value
       }
-      result << (char)(edifactValue);
+      result += (char)(edifactValue);
     }
-  } while (bits->available() > 0);
+  } while (bits.available() > 0);
 }
   
-void DecodedBitStreamParser::decodeBase256Segment(Ref<BitSource> bits, ostringstream& result, vector<char> byteSegments) {
+void DecodedBitStreamParser::decodeBase256Segment(BitSource& bits, string& result, vector<char>& byteSegments) {
   // Figure out how long the Base 256 Segment is.
-  int codewordPosition = 1 + bits->getByteOffset(); // position is 1-indexed
-  int d1 = unrandomize255State(bits->readBits(8), codewordPosition++);
+  int codewordPosition = 1 + bits.getByteOffset(); // position is 1-indexed
+  int d1 = unrandomize255State(bits.readBits(8), codewordPosition++);
   int count;
   if (d1 == 0) {  // Read the remainder of the symbol
-    count = bits->available() / 8;
+    count = bits.available() / 8;
   } else if (d1 < 250) {
     count = d1;
   } else {
-    count = 250 * (d1 - 249) + unrandomize255State(bits->readBits(8), codewordPosition++);
+    count = 250 * (d1 - 249) + unrandomize255State(bits.readBits(8), codewordPosition++);
   }
 
   // We're seeing NegativeArraySizeException errors from users.
@@ -399,18 +341,16 @@ void DecodedBitStreamParser::decodeBase256Segment(Ref<BitSource> bits, ostringst
     throw FormatException("NegativeArraySizeException");
   }
 
-  char* bytes = new char[count];
   for (int i = 0; i < count; i++) {
     // Have seen this particular error in the wild, such as at
     // http://www.bcgen.com/demo/IDAutomationStreamingDataMatrix.aspx?MODE=3&D=Fred&PFMT=3&PT=F&X=0.3&O=0&LM=0.2
-    if (bits->available() < 8) {
+    if (bits.available() < 8) {
       throw FormatException("byteSegments");
     }
-    bytes[i] = unrandomize255State(bits->readBits(8), codewordPosition++);
-    byteSegments.push_back(bytes[i]);
-    result << (char)bytes[i];
+    char byte = unrandomize255State(bits.readBits(8), codewordPosition++);
+    byteSegments.push_back(byte);
+    result += byte;
   }
 }
 }
 }
-
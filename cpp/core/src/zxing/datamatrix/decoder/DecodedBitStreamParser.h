@@ -22,7 +22,7 @@
  */
 
 #include <string>
-#include <sstream>
+#include <vector>
 #include <zxing/common/Array.h>
 #include <zxing/common/BitSource.h>
 #include <zxing/common/Counted.h>
@@ -42,44 +42,26 @@ private:
   static const int EDIFACT_ENCODE = 5;
   static const int BASE256_ENCODE = 6;
     
-  /**
-   * See ISO 16022:2006, Annex C Table C.1
-   * The C40 Basic Character Set (*'s used for placeholders for the shift values)
-   */
-  static const char C40_BASIC_SET_CHARS[];
-  
-  static const char C40_SHIFT2_SET_CHARS[];  
-  /**
-   * See ISO 16022:2006, Annex C Table C.2
-   * The Text Basic Character Set (*'s used for placeholders for the shift values)
-   */
-  static const char TEXT_BASIC_SET_CHARS[];
-  
-  static const char TEXT_SHIFT3_SET_CHARS[];  
   /**
    * See ISO 16022:2006, 5.2.3 and Annex C, Table C.2
    */
-  int decodeAsciiSegment(Ref<BitSource> bits, std::ostringstream &result, std::ostringstream &resultTrailer);
-  /**
-   * See ISO 16022:2006, 5.2.5 and Annex C, Table C.1
-   */
-  void decodeC40Segment(Ref<BitSource> bits, std::ostringstream &result);
+  int decodeAsciiSegment(BitSource& bits, std::string &result, std::string &resultTrailer);
   /**
-   * See ISO 16022:2006, 5.2.6 and Annex C, Table C.2
+   * See ISO 16022:2006, 5.2.5 and 5.2.6, Annex C Tables C.1 and C.2
    */
-  void decodeTextSegment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeC40OrTextSegment(BitSource& bits, std::string &result, bool text);
   /**
    * See ISO 16022:2006, 5.2.7
    */
-  void decodeAnsiX12Segment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeAnsiX12Segment(BitSource& bits, std::string &result);
   /**
    * See ISO 16022:2006, 5.2.8 and Annex C Table C.3
    */
-  void decodeEdifactSegment(Ref<BitSource> bits, std::ostringstream &result);
+  void decodeEdifactSegment(BitSource& bits, std::string &result);
   /**
    * See ISO 16022:2006, 5.2.9 and Annex B, B.2
    */
-  void decodeBase256Segment(Ref<BitSource> bits, std::ostringstream &result, std::vector<char> byteSegments);
+  void decodeBase256Segment(BitSource& bits, std::string &result, std::vector<char>& byteSegments);
 
   void parseTwoBytes(int firstByte, int secondByte, int* result);
   /**
@@ -91,7 +73,6 @@ private:
     int tempVariable = randomizedBase256Codeword - pseudoRandomNumber;
     return (char) (tempVariable >= 0 ? tempVariable : (tempVariable + 256));
   };
-  void append(std::ostream &ost, const char *bufIn, size_t nIn, const char *src);
 
 public:
   DecodedBitStreamParser() { };
@@ -35,7 +35,7 @@ using zxing::datamatrix::Decoder;
 using zxing::ArrayRef;
 using zxing::BitMatrix;
 
-Decoder::Decoder() : rsDecoder_(GenericGF::DATA_MATRIX_FIELD_256) {}
+Decoder::Decoder() : rsDecoder_(GenericGF::DATA_MATRIX_FIELD_256()) {}
 
 void Decoder::correctErrors(ArrayRef<char> codewordBytes, int numDataCodewords) {
   int numCodewords = codewordBytes->size();
@@ -16,6 +16,7 @@
 
 #include <zxing/multi/ByQuadrantReader.h>
 #include <zxing/ReaderException.h>
+#include <zxing/multi/RegionSearch.h>
 
 namespace zxing {
 namespace multi {
@@ -29,46 +30,28 @@ Ref<Result> ByQuadrantReader::decode(Ref<BinaryBitmap> image){
 }
 
 Ref<Result> ByQuadrantReader::decode(Ref<BinaryBitmap> image, DecodeHints hints){
-  int width = image->getWidth();
-  int height = image->getHeight();
-  int halfWidth = width / 2;
-  int halfHeight = height / 2;
-  Ref<BinaryBitmap> topLeft = image->crop(0, 0, halfWidth, halfHeight);
-  try {
-    return delegate_.decode(topLeft, hints);
-  } catch (ReaderException const& re) {
-    (void)re;
-    // continue
-  }
-
-  Ref<BinaryBitmap> topRight = image->crop(halfWidth, 0, halfWidth, halfHeight);
-  try {
-    return delegate_.decode(topRight, hints);
-  } catch (ReaderException const& re) {
-    (void)re;
-    // continue
-  }
-
-  Ref<BinaryBitmap> bottomLeft = image->crop(0, halfHeight, halfWidth, halfHeight);
-  try {
-    return delegate_.decode(bottomLeft, hints);
-  } catch (ReaderException const& re) {
-    (void)re;
-    // continue
-  }
-
-  Ref<BinaryBitmap> bottomRight = image->crop(halfWidth, halfHeight, halfWidth, halfHeight);
-  try {
-    return delegate_.decode(bottomRight, hints);
-  } catch (ReaderException const& re) {
-    (void)re;
-    // continue
-  }
-
+  // The quadrants are windows of the image, or of the region of interest
+  // asked for, rather than crops of it, so that they share its
+  // binarization.
+  int left, top, right, bottom;
+  hints.getRegionOfInterest(image->getWidth(), image->getHeight(), left, top, right, bottom);
+  int halfWidth = (right - left) / 2;
+  int halfHeight = (bottom - top) / 2;
   int quarterWidth = halfWidth / 2;
   int quarterHeight = halfHeight / 2;
-  Ref<BinaryBitmap> center = image->crop(quarterWidth, quarterHeight, halfWidth, halfHeight);
-  return delegate_.decode(center, hints);
+  RegionSearch search (delegate_, image, hints);
+  // Top left, top right, bottom left, bottom right and center.
+  search.add(left, top, left + halfWidth, top + halfHeight);
+  search.add(left + halfWidth, top, left + 2 * halfWidth, top + halfHeight);
+  search.add(left, top + halfHeight, left + halfWidth, top + 2 * halfHeight);
+  search.add(left + halfWidth, top + halfHeight, left + 2 * halfWidth, top + 2 * halfHeight);
+  search.add(left + quarterWidth, top + quarterHeight,
+             left + quarterWidth + halfWidth, top + quarterHeight + halfHeight);
+  int first = search.decodeFirst();
+  if (first < 0) {
+    throw ReaderException("No code detected");
+  }
+  return search.getResult(first);
 }
 
 } // End zxing::multi namespace
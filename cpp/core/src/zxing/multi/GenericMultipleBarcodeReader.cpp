@@ -18,10 +18,16 @@
 #include <zxing/multi/GenericMultipleBarcodeReader.h>
 #include <zxing/ReaderException.h>
 #include <zxing/ResultPoint.h>
+#include <zxing/multi/RegionSearch.h>
+#include <algorithm>
 
 using std::vector;
 using zxing::Ref;
 using zxing::Result;
+using zxing::ArrayRef;
+using zxing::ResultPoint;
+using zxing::multi::RegionSearch;
+using zxing::multi::ResultSet;
 using zxing::multi::GenericMultipleBarcodeReader;
 
 // VC++
@@ -29,6 +35,31 @@ using zxing::Reader;
 using zxing::BinaryBitmap;
 using zxing::DecodeHints;
 
+namespace {
+
+// A part of the image, right and bottom exclusive, with the path to it:
+// which part of which part of the image it is.
+struct Region {
+  int left;
+  int top;
+  int right;
+  int bottom;
+  vector<int> path;
+};
+
+struct Found {
+  vector<int> path;
+  Ref<Result> result;
+};
+
+// Depth first order: a part before the parts around the barcode in it, and
+// those in the order they are tried.
+bool isEarlier(Found const& a, Found const& b) {
+  return a.path < b.path;
+}
+
+}
+
 GenericMultipleBarcodeReader::GenericMultipleBarcodeReader(Reader& delegate)
     : delegate_(delegate) {}
 
@@ -36,102 +67,91 @@ GenericMultipleBarcodeReader::~GenericMultipleBarcodeReader(){}
 
 vector<Ref<Result> > GenericMultipleBarcodeReader::decodeMultiple(Ref<BinaryBitmap> image,
                                                                   DecodeHints hints) {
-  vector<Ref<Result> > results;
-  doDecodeMultiple(image, hints, results, 0, 0, 0);
-  if (results.empty()){
-    throw ReaderException("No code detected");
-  }
-  return results;
-}
-
-void GenericMultipleBarcodeReader::doDecodeMultiple(Ref<BinaryBitmap> image, 
-                                                    DecodeHints hints,
-                                                    vector<Ref<Result> >& results,
-                                                    int xOffset,
-                                                    int yOffset,
-                                                    int currentDepth) {
-  if (currentDepth > MAX_DEPTH) {
-    return;
-  }
-  Ref<Result> result;
-  try {
-    result = delegate_.decode(image, hints);
-  } catch (ReaderException const& ignored) {
-    (void)ignored;
-    return;
-  }
-  bool alreadyFound = false;
-  for (unsigned int i = 0; i < results.size(); i++) {
-    Ref<Result> existingResult = results[i];
-    if (existingResult->getText()->getText() == result->getText()->getText()) {
-      alreadyFound = true;
-      break;
+  vector<Region> regions (1);
+  Region& whole = regions[0];
+  hints.getRegionOfInterest(image->getWidth(), image->getHeight(),
+                            whole.left, whole.top, whole.right, whole.bottom);
+  vector<Found> found;
+  RegionSearch search (delegate_, image, hints);
+  for (int depth = 0; depth <= MAX_DEPTH && !regions.empty(); depth++) {
+    search.clear();
+    for (size_t i = 0; i < regions.size(); i++) {
+      search.add(regions[i].left, regions[i].top, regions[i].right, regions[i].bottom);
     }
-  }
-  if (!alreadyFound) {
-    results.push_back(translateResultPoints(result, xOffset, yOffset));
-  }
-  
-  ArrayRef< Ref<ResultPoint> > resultPoints = result->getResultPoints();
-  if (resultPoints->empty()) {
-    return;
-  }
+    search.decodeAll();
 
-  int width = image->getWidth();
-  int height = image->getHeight();
-  float minX = float(width);
-  float minY = float(height);
-  float maxX = 0.0f;
-  float maxY = 0.0f;
-  for (int i = 0; i < resultPoints->size(); i++) {
-    Ref<ResultPoint> point = resultPoints[i];
-    float x = point->getX();
-    float y = point->getY();
-    if (x < minX) {
-      minX = x;
-    }
-    if (y < minY) {
-      minY = y;
-    }
-    if (x > maxX) {
-      maxX = x;
-    }
-    if (y > maxY) {
-      maxY = y;
-    }
-  }
+    vector<Region> next;
+    for (size_t i = 0; i < regions.size(); i++) {
+      Ref<Result> const& result = search.getResult((int) i);
+      if (!result) {
+        continue;
+      }
+      Region const& region = regions[i];
+      Found f;
+      f.path = region.path;
+      f.result = result;
+      found.push_back(f);
+      ArrayRef< Ref<ResultPoint> > resultPoints = result->getResultPoints();
+      if (depth == MAX_DEPTH || resultPoints->empty()) {
+        continue;
+      }
 
-  // Decode left of barcode
-  if (minX > MIN_DIMENSION_TO_RECUR) {
-    doDecodeMultiple(image->crop(0, 0, (int) minX, height), 
-                     hints, results, xOffset, yOffset, currentDepth+1);
-  }
-  // Decode above barcode
-  if (minY > MIN_DIMENSION_TO_RECUR) {
-    doDecodeMultiple(image->crop(0, 0, width, (int) minY), 
-                     hints, results, xOffset, yOffset, currentDepth+1);
-  }
-  // Decode right of barcode
-  if (maxX < width - MIN_DIMENSION_TO_RECUR) {
-    doDecodeMultiple(image->crop((int) maxX, 0, width - (int) maxX, height), 
-                     hints, results, xOffset + (int) maxX, yOffset, currentDepth+1);
-  }
-  // Decode below barcode
-  if (maxY < height - MIN_DIMENSION_TO_RECUR) {
-    doDecodeMultiple(image->crop(0, (int) maxY, width, height - (int) maxY), 
-                     hints, results, xOffset, yOffset + (int) maxY, currentDepth+1);
+      // Points are in the whole image; readers that do not keep to the
+      // region of interest may find a barcode outside the region.
+      float minX = float(region.right);
+      float minY = float(region.bottom);
+      float maxX = float(region.left);
+      float maxY = float(region.top);
+      for (int j = 0; j < resultPoints->size(); j++) {
+        float x = std::min(std::max(resultPoints[j]->getX(), float(region.left)), float(region.right));
+        float y = std::min(std::max(resultPoints[j]->getY(), float(region.top)), float(region.bottom));
+        minX = std::min(minX, x);
+        minY = std::min(minY, y);
+        maxX = std::max(maxX, x);
+        maxY = std::max(maxY, y);
+      }
+
+      Region part (region);
+      part.path.push_back(0);
+      // Left of barcode
+      if (minX - region.left > MIN_DIMENSION_TO_RECUR) {
+        part.path.back() = 0;
+        part.right = (int) minX;
+        next.push_back(part);
+        part.right = region.right;
+      }
+      // Above barcode
+      if (minY - region.top > MIN_DIMENSION_TO_RECUR) {
+        part.path.back() = 1;
+        part.bottom = (int) minY;
+        next.push_back(part);
+        part.bottom = region.bottom;
+      }
+      // Right of barcode
+      if (maxX < region.right - MIN_DIMENSION_TO_RECUR) {
+        part.path.back() = 2;
+        part.left = (int) maxX;
+        next.push_back(part);
+        part.left = region.left;
+      }
+      // Below barcode
+      if (maxY < region.bottom - MIN_DIMENSION_TO_RECUR) {
+        part.path.back() = 3;
+        part.top = (int) maxY;
+        next.push_back(part);
+      }
+    }
+    regions.swap(next);
   }
-}
 
-Ref<Result> GenericMultipleBarcodeReader::translateResultPoints(Ref<Result> result, int xOffset, int yOffset){
-    ArrayRef< Ref<ResultPoint> > oldResultPoints = result->getResultPoints();
-  if (oldResultPoints->empty()) {
-    return result;
+  // Paths are unique, so the order is too, however the searches ran.
+  std::sort(found.begin(), found.end(), isEarlier);
+  ResultSet results;
+  for (size_t i = 0; i < found.size(); i++) {
+    results.add(found[i].result);
   }
-  ArrayRef< Ref<ResultPoint> > newResultPoints;
-  for (int i = 0; i < oldResultPoints->size(); i++) {
-    Ref<ResultPoint> oldPoint = oldResultPoints[i];
-    newResultPoints->values().push_back(Ref<ResultPoint>(new ResultPoint(oldPoint->getX() + xOffset, oldPoint->getY() + yOffset)));
+  if (results.empty()) {
+    throw ReaderException("No code detected");
   }
-  return Ref<Result>(new Result(result->getText(), result->getRawBytes(), newResultPoints, result->getBarcodeFormat()));
+  return results.getResults();
 }
@@ -24,17 +24,13 @@
 namespace zxing {
 namespace multi {
 
+// Decodes the image, then the parts of it left of, above, right of and
+// below each barcode found, down to MAX_DEPTH levels. The parts of a level
+// are decoded together, on several threads if the hints ask for them (see
+// RegionSearch), and the results are returned in the order decoding them
+// one at a time, depth first, would find them.
 class GenericMultipleBarcodeReader : public MultipleBarcodeReader {
  private:
-  static Ref<Result> translateResultPoints(Ref<Result> result, 
-                                           int xOffset, 
-                                           int yOffset);
-  void doDecodeMultiple(Ref<BinaryBitmap> image, 
-                        DecodeHints hints, 
-                        std::vector<Ref<Result> >& results, 
-                        int xOffset, 
-                        int yOffset,
-                        int currentDepth);
   Reader& delegate_;
   static const int MIN_DIMENSION_TO_RECUR = 100;
   static const int MAX_DEPTH = 4;
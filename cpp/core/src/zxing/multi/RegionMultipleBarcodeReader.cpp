@@ -0,0 +1,84 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/multi/RegionMultipleBarcodeReader.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/detector/RegionProposer.h>
+#include <zxing/multi/RegionSearch.h>
+
+using std::vector;
+using zxing::Ref;
+using zxing::Result;
+using zxing::CandidateRegion;
+using zxing::RegionProposer;
+using zxing::multi::RegionMultipleBarcodeReader;
+using zxing::multi::RegionSearch;
+using zxing::multi::ResultSet;
+
+// VC++
+using zxing::Reader;
+using zxing::BinaryBitmap;
+using zxing::DecodeHints;
+
+namespace {
+
+const DecodeHints TWOD_HINT(
+  DecodeHints::QR_CODE_HINT |
+  DecodeHints::DATA_MATRIX_HINT |
+  DecodeHints::AZTEC_HINT |
+  DecodeHints::PDF_417_HINT |
+  DecodeHints::MAXICODE_HINT
+  );
+
+}
+
+RegionMultipleBarcodeReader::RegionMultipleBarcodeReader(Reader& delegate)
+    : delegate_(delegate) {}
+
+RegionMultipleBarcodeReader::~RegionMultipleBarcodeReader(){}
+
+vector<Ref<Result> > RegionMultipleBarcodeReader::decodeMultiple(Ref<BinaryBitmap> image,
+                                                                 DecodeHints hints) {
+  if (!hints.hasFormats()) {
+    hints = hints | DecodeHints::DEFAULT_HINT;
+  }
+  vector<Ref<CandidateRegion> > regions = RegionProposer(image->getBlackMatrix()).propose();
+  RegionSearch search (delegate_, image, hints);
+  for (size_t i = 0; i < regions.size(); i++) {
+    Ref<CandidateRegion> region = regions[i];
+    DecodeHints regionHints (hints);
+    regionHints.retainFormats(region->isOneDimensional() ? DecodeHints::ONED_HINT : TWOD_HINT);
+    if (!regionHints.hasFormats()) {
+      continue;
+    }
+    regionHints.setRegionOfInterest(region->getLeft(), region->getTop(),
+                                    region->getRight() - region->getLeft(),
+                                    region->getBottom() - region->getTop());
+    search.add(regionHints);
+  }
+  search.decodeAll();
+  ResultSet results;
+  for (int i = 0; i < search.size(); i++) {
+    if (search.getResult(i)) {
+      results.add(search.getResult(i));
+    }
+  }
+  if (results.empty()) {
+    throw ReaderException("No code detected");
+  }
+  return results.getResults();
+}
@@ -0,0 +1,45 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __REGION_MULTIPLE_BARCODE_READER_H__
+#define __REGION_MULTIPLE_BARCODE_READER_H__
+
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/multi/MultipleBarcodeReader.h>
+#include <zxing/Reader.h>
+
+namespace zxing {
+namespace multi {
+
+// Decodes each region a RegionProposer finds in the black matrix, largest
+// first, by passing it to the delegate as the region of interest. One
+// dimensional regions are only tried with the 1D formats among those asked
+// for, the others only with the 2D formats, where GenericMultipleBarcodeReader
+// would instead decode the whole image again around each barcode it finds.
+class RegionMultipleBarcodeReader : public MultipleBarcodeReader {
+ private:
+  Reader& delegate_;
+
+ public:
+  RegionMultipleBarcodeReader(Reader& delegate);
+  virtual ~RegionMultipleBarcodeReader();
+  virtual std::vector<Ref<Result> > decodeMultiple(Ref<BinaryBitmap> image, DecodeHints hints);
+};
+
+}
+}
+
+#endif // __REGION_MULTIPLE_BARCODE_READER_H__
@@ -0,0 +1,125 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/multi/RegionSearch.h>
+#include <zxing/ReaderException.h>
+
+using std::vector;
+using zxing::Ref;
+using zxing::Result;
+using zxing::ParallelSearch;
+using zxing::multi::RegionSearch;
+using zxing::multi::ResultSet;
+
+// VC++
+using zxing::Reader;
+using zxing::BinaryBitmap;
+using zxing::DecodeHints;
+using zxing::ReaderException;
+
+RegionSearch::RegionSearch(Reader& reader, Ref<BinaryBitmap> const& image, DecodeHints const& hints)
+  : hints_(hints), readers_(1, &reader), images_(1, image), stopAtFirst_(false) {
+}
+
+void RegionSearch::add(DecodeHints const& hints) {
+  regions_.push_back(hints);
+  results_.push_back(Ref<Result>());
+}
+
+void RegionSearch::add(int left, int top, int right, int bottom) {
+  DecodeHints hints (hints_);
+  hints.setRegionOfInterest(left, top, right - left, bottom - top);
+  add(hints);
+}
+
+void RegionSearch::clear() {
+  regions_.clear();
+  results_.clear();
+}
+
+int RegionSearch::size() const {
+  return (int) regions_.size();
+}
+
+int RegionSearch::decodeFirst() {
+  stopAtFirst_ = true;
+  int workers = getWorkers();
+  return ParallelSearch::find(*this, size(), workers, 1);
+}
+
+void RegionSearch::decodeAll() {
+  stopAtFirst_ = false;
+  int workers = getWorkers();
+  ParallelSearch::find(*this, size(), workers, 1);
+}
+
+Ref<Result> const& RegionSearch::getResult(int index) const {
+  return results_[index];
+}
+
+// Clones readers and bitmaps for up to one worker per region, here on the
+// calling thread, and has the regions each decoded on one thread.
+int RegionSearch::getWorkers() {
+  int threads = hints_.getThreads() < size() ? hints_.getThreads() : size();
+  if (threads < 2 || !ParallelSearch::isSupported() ||
+      hints_.getResultPointCallback() || hints_.getAlsoInverted()) {
+    return 1;
+  }
+  while ((int) readers_.size() < threads) {
+    Ref<Reader> copy (readers_[0]->cloneReader());
+    if (!copy) {
+      break;
+    }
+    readerCopies_.push_back(copy);
+    readers_.push_back(copy);
+    images_.push_back(images_[0]->clone());
+  }
+  int workers = (int) readers_.size() < threads ? (int) readers_.size() : threads;
+  if (workers > 1) {
+    for (size_t i = 0; i < regions_.size(); i++) {
+      regions_[i].setThreads(1);
+    }
+  }
+  return workers;
+}
+
+bool RegionSearch::test(int worker, int index) {
+  try {
+    results_[index] = readers_[worker]->decode(images_[worker], regions_[index]);
+    return stopAtFirst_;
+  } catch (ReaderException const& ignored) {
+    (void)ignored;
+    return false;
+  }
+}
+
+bool ResultSet::add(Ref<Result> const& result) {
+  std::pair<int, std::string> key (result->getBarcodeFormat(), result->getText()->getText());
+  if (!keys_.insert(key).second) {
+    return false;
+  }
+  results_.push_back(result);
+  return true;
+}
+
+bool ResultSet::empty() const {
+  return results_.empty();
+}
+
+vector<Ref<Result> > const& ResultSet::getResults() const {
+  return results_;
+}
@@ -0,0 +1,89 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __REGION_SEARCH_H__
+#define __REGION_SEARCH_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include <zxing/Reader.h>
+#include <zxing/common/ParallelSearch.h>
+
+namespace zxing {
+namespace multi {
+
+// Decodes regions of an image with one reader, each region being the region
+// of interest of its own hints. Given threads (see DecodeHints::setThreads)
+// and a reader that can be cloned (see Reader::cloneReader), several regions
+// are decoded at once, each worker with its own copy of the reader and of
+// the bitmap, and the results are those of decoding the regions in order.
+// Hints with a ResultPointCallback, which workers would share, or asking to
+// also try inverted images, which share the luminances of the bitmap, are
+// decoded on the calling thread.
+class RegionSearch : private ParallelSearch::Task {
+public:
+  RegionSearch(Reader& reader, Ref<BinaryBitmap> const& image, DecodeHints const& hints);
+
+  // Adds a region to decode: hints are those given above, restricted to it.
+  void add(DecodeHints const& hints);
+  void add(int left, int top, int right, int bottom);
+  // Forgets the regions and their results but keeps the workers, and with
+  // them the bitmaps they have binarized.
+  void clear();
+  int size() const;
+
+  // Decodes the regions in order up to the first that decodes, which it
+  // returns, or -1.
+  int decodeFirst();
+  // Decodes every region.
+  void decodeAll();
+  // Empty for regions that did not decode or were skipped.
+  Ref<Result> const& getResult(int index) const;
+
+private:
+  int getWorkers();
+  bool test(int worker, int index);
+
+  DecodeHints hints_;
+  std::vector<Reader*> readers_;
+  std::vector<Ref<Reader> > readerCopies_;
+  std::vector<Ref<BinaryBitmap> > images_;
+  std::vector<DecodeHints> regions_;
+  std::vector<Ref<Result> > results_;
+  bool stopAtFirst_;
+};
+
+// Results in the order added, less those with the format and text of an
+// earlier one.
+class ResultSet {
+public:
+  // Returns whether result was new.
+  bool add(Ref<Result> const& result);
+  bool empty() const;
+  std::vector<Ref<Result> > const& getResults() const;
+
+private:
+  std::set<std::pair<int, std::string> > keys_;
+  std::vector<Ref<Result> > results_;
+};
+
+}
+}
+
+#endif // __REGION_SEARCH_H__
@@ -18,6 +18,7 @@
 #include <zxing/ZXing.h>
 #include <zxing/oned/CodaBarReader.h>
 #include <zxing/oned/OneDResultPoint.h>
+#include <zxing/oned/PatternLookup.h>
 #include <zxing/common/Array.h>
 #include <zxing/ReaderException.h>
 #include <zxing/NotFoundException.h>
@@ -34,6 +35,7 @@ using zxing::ChecksumException;
 using zxing::Ref;
 using zxing::Result;
 using zxing::oned::CodaBarReader;
+using zxing::oned::PatternLookup;
 
 // VC++
 using zxing::BitArray;
@@ -63,6 +65,13 @@ namespace {
 
   // some industries use a checksum standard but this is not part of the original codabar standard
   // for more information see : http://www.mecsw.com/specs/codabar.html
+
+  // Character index by encoding.
+  vector<signed char> const& characterIndices() {
+    static const vector<signed char> indices(
+      PatternLookup::invert(CHARACTER_ENCODINGS, ZXING_ARRAY_LEN(CHARACTER_ENCODINGS), 7));
+    return indices;
+  }
 }
 
 // These values are critical for determining how permissive the decoding
@@ -76,7 +85,11 @@ const int CodaBarReader::PADDING =
 CodaBarReader::CodaBarReader() 
   : counters(80, 0), counterLength(0) {}
 
-Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<zxing::oned::OneDReader> CodaBarReader::clone() const {
+  return Ref<OneDReader>(new CodaBarReader());
+}
+
+Ref<Result> CodaBarReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
 
   { // Arrays.fill(counters, 0);
     int size = (int) counters.size();
@@ -233,7 +246,7 @@ void CodaBarReader::validatePattern(int start)  {
  * uses our builtin "counters" member for storage.
  * @param row row to count from
  */
-void CodaBarReader::setCounters(Ref<BitArray> row)  {
+void CodaBarReader::setCounters(Ref<BitArray> const& row)  {
   counterLength = 0;
   // Start from the first white bit.
   int i = row->getNextUnset(0);
@@ -331,10 +344,5 @@ int CodaBarReader::toNarrowWidePattern(int position) {
     }
   }
 
-  for (int i = 0; i < ZXING_ARRAY_LEN(CHARACTER_ENCODINGS); i++) {
-    if (CHARACTER_ENCODINGS[i] == pattern) {
-      return i;
-    }
-  }
-  return -1;
+  return characterIndices()[pattern];
 }
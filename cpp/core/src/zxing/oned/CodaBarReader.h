@@ -36,13 +36,14 @@ private:
 
 public:
   CodaBarReader();
+  Ref<OneDReader> clone() const;
 
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
   
   void validatePattern(int start);
 
 private:
-  void setCounters(Ref<BitArray> row);
+  void setCounters(Ref<BitArray> const& row);
   void counterAppend(int e);
   int findStartPattern();
   
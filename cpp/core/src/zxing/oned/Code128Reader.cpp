@@ -18,6 +18,7 @@
 #include <zxing/ZXing.h>
 #include <zxing/oned/Code128Reader.h>
 #include <zxing/oned/OneDResultPoint.h>
+#include <zxing/oned/PatternLookup.h>
 #include <zxing/common/Array.h>
 #include <zxing/ReaderException.h>
 #include <zxing/NotFoundException.h>
@@ -35,6 +36,8 @@ using zxing::ChecksumException;
 using zxing::Ref;
 using zxing::Result;
 using zxing::oned::Code128Reader;
+using zxing::oned::PatternLookup;
+using zxing::oned::RowVotes;
 
 // VC++
 using zxing::BitArray;
@@ -172,11 +175,20 @@ const int CODE_PATTERNS[CODE_PATTERNS_LENGTH][6] = {
   {2, 3, 3, 1, 1, 1}
 };
 
+PatternLookup const& codeLookup() {
+  static const PatternLookup lookup(CODE_PATTERNS[0], CODE_PATTERNS_LENGTH, 6);
+  return lookup;
+}
+
 }
 
 Code128Reader::Code128Reader(){}
 
-vector<int> Code128Reader::findStartPattern(Ref<BitArray> row){
+Ref<zxing::oned::OneDReader> Code128Reader::clone() const {
+  return Ref<OneDReader>(new Code128Reader());
+}
+
+vector<int> Code128Reader::findStartPattern(Ref<BitArray> const& row){
   int width = row->getSize();
   int rowOffset = row->getNextSet(0);
 
@@ -226,9 +238,29 @@ vector<int> Code128Reader::findStartPattern(Ref<BitArray> row){
   throw NotFoundException();
 }
 
-int Code128Reader::decodeCode(Ref<BitArray> row, vector<int>& counters, int rowOffset) {
+int Code128Reader::decodeCode(Ref<BitArray> const& row, vector<int>& counters, int rowOffset) {
   recordPattern(row, rowOffset, counters);
-  int bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
+  int variance;
+  int bestMatch = matchCode(counters, variance);
+  // TODO We're overlooking the fact that the STOP pattern has 7 values, not 6.
+  if (bestMatch >= 0) {
+    return bestMatch;
+  } else {
+    throw NotFoundException();
+  }
+}
+
+int Code128Reader::matchCode(vector<int>& counters, int& bestVariance) {
+  // Counters that round to a code match it better than any other code, so
+  // the loop below is only needed when they don't.
+  int code = codeLookup().lookup(counters);
+  if (code >= 0) {
+    bestVariance = patternMatchVariance(counters, CODE_PATTERNS[code], MAX_INDIVIDUAL_VARIANCE);
+    if (bestVariance < MAX_AVG_VARIANCE) {
+      return code;
+    }
+  }
+  bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
   int bestMatch = -1;
   for (int d = 0; d < CODE_PATTERNS_LENGTH; d++) {
     int const* const pattern = CODE_PATTERNS[d];
@@ -238,19 +270,73 @@ int Code128Reader::decodeCode(Ref<BitArray> row, vector<int>& counters, int rowO
       bestMatch = d;
     }
   }
-  // TODO We're overlooking the fact that the STOP pattern has 7 values, not 6.
-  if (bestMatch >= 0) {
-    return bestMatch;
-  } else {
+  return bestMatch;
+}
+
+Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
+  vector<int> startPatternInfo (findStartPattern(row));
+  vector<int> codes (1, startPatternInfo[2]);
+  vector<char> rawCodes(20, 0);
+
+  int lastStart = startPatternInfo[0];
+  int nextStart = startPatternInfo[1];
+  vector<int> counters (6, 0);
+
+  for (;;) {
+    int code = decodeCode(row, counters, nextStart);
+
+    // Advance to where the next code will to start
+    lastStart = nextStart;
+    for (int i = 0, e = (int) counters.size(); i < e; i++) {
+      nextStart += counters[i];
+    }
+
+    if (code == CODE_STOP) {
+      break;
+    }
+    codes.push_back(code);
+  }
+
+  // Check for ample whitespace following pattern, but, to do this we first need to remember that
+  // we fudged decoding CODE_STOP since it actually has 7 bars, not 6. There is a black bar left
+  // to read off. Would be slightly better to properly read. Here we just skip it:
+  nextStart = row->getNextUnset(nextStart);
+  if (!row->isRange(nextStart,
+                    std::min(row->getSize(), nextStart + (nextStart - lastStart) / 2),
+                    false)) {
     throw NotFoundException();
   }
+
+  string result;
+  decodeCodes(codes, result);
+
+  float left = (float) (startPatternInfo[1] + startPatternInfo[0]) / 2.0f;
+  float right = (float) (nextStart + lastStart) / 2.0f;
+
+  int rawCodesSize = (int) rawCodes.size();
+  ArrayRef<char> rawBytes (rawCodesSize);
+  for (int i = 0; i < rawCodesSize; i++) {
+    rawBytes[i] = rawCodes[i];
+  }
+
+  ArrayRef< Ref<ResultPoint> > resultPoints(2);
+  resultPoints[0] =
+      Ref<OneDResultPoint>(new OneDResultPoint(left, (float) rowNumber));
+  resultPoints[1] =
+      Ref<OneDResultPoint>(new OneDResultPoint(right, (float) rowNumber));
+
+  return Ref<Result>(new Result(String::adopt(result), rawBytes, resultPoints,
+                                BarcodeFormat::CODE_128));
 }
 
-Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
+void Code128Reader::decodeCodes(vector<int> const& codes, string& result) {
   // boolean convertFNC1 = hints != null && hints.containsKey(DecodeHintType.ASSUME_GS1);
   boolean convertFNC1 = false;
-  vector<int> startPatternInfo (findStartPattern(row));
-  int startCode = startPatternInfo[2];
+  int codeCount = (int) codes.size();
+  if (codeCount < 2) {
+    throw NotFoundException();
+  }
+  int startCode = codes[0];
   int codeSet;
   switch (startCode) {
     case CODE_START_A:
@@ -266,59 +352,31 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
       throw FormatException();
   }
 
-  bool done = false;
-  bool isNextShifted = false;
-
-  string result;
-  vector<char> rawCodes(20, 0);
-
-  int lastStart = startPatternInfo[0];
-  int nextStart = startPatternInfo[1];
-  vector<int> counters (6, 0);
-
-  int lastCode = 0;
-  int code = 0;
+  // The last code is the checksum
   int checksumTotal = startCode;
-  int multiplier = 0;
-  bool lastCharacterWasPrintable = true;
+  for (int i = 1; i < codeCount; i++) {
+    // Take care of illegal start codes
+    if (codes[i] >= CODE_START_A) {
+      throw FormatException();
+    }
+    if (i < codeCount - 1) {
+      checksumTotal += i * codes[i];
+    }
+  }
+  if (checksumTotal % 103 != codes[codeCount - 1]) {
+    throw ChecksumException();
+  }
+
+  bool isNextShifted = false;
 
   std::ostringstream oss;
 
-  while (!done) {
+  for (int i = 1; i < codeCount - 1; i++) {
+    int code = codes[i];
 
     bool unshift = isNextShifted;
     isNextShifted = false;
 
-    // Save off last code
-    lastCode = code;
-
-    code = decodeCode(row, counters, nextStart);
-
-    // Remember whether the last code was printable or not (excluding CODE_STOP)
-    if (code != CODE_STOP) {
-      lastCharacterWasPrintable = true;
-    }
-
-    // Add to checksum computation (if not CODE_STOP of course)
-    if (code != CODE_STOP) {
-      multiplier++;
-      checksumTotal += multiplier * code;
-    }
-
-    // Advance to where the next code will to start
-    lastStart = nextStart;
-    for (int i = 0, e = (int) counters.size(); i < e; i++) {
-      nextStart += counters[i];
-    }
-
-    // Take care of illegal start codes
-    switch (code) {
-      case CODE_START_A:
-      case CODE_START_B:
-      case CODE_START_C:
-        throw FormatException();
-    }
-
     switch (codeSet) {
 
       case CODE_CODE_A:
@@ -327,11 +385,6 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
         } else if (code < 96) {
           result.append(1, (char) (code - 64));
         } else {
-          // Don't let CODE_STOP, which always appears, affect whether whether we think the
-          // last code was printable or not.
-          if (code != CODE_STOP) {
-            lastCharacterWasPrintable = false;
-          }
           switch (code) {
             case CODE_FNC_1:
               if (convertFNC1) {
@@ -360,9 +413,6 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
             case CODE_CODE_C:
               codeSet = CODE_CODE_C;
               break;
-            case CODE_STOP:
-              done = true;
-              break;
           }
         }
         break;
@@ -370,9 +420,6 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
         if (code < 96) {
           result.append(1, (char) (' ' + code));
         } else {
-          if (code != CODE_STOP) {
-            lastCharacterWasPrintable = false;
-          }
           switch (code) {
             case CODE_FNC_1:
             case CODE_FNC_2:
@@ -390,9 +437,6 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
             case CODE_CODE_C:
               codeSet = CODE_CODE_C;
               break;
-            case CODE_STOP:
-              done = true;
-              break;
           }
         }
         break;
@@ -406,9 +450,6 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
           oss << code;
           result.append(oss.str());
         } else {
-          if (code != CODE_STOP) {
-            lastCharacterWasPrintable = false;
-          }
           switch (code) {
             case CODE_FNC_1:
               // do nothing?
@@ -419,9 +460,6 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
             case CODE_CODE_B:
               codeSet = CODE_CODE_B;
               break;
-            case CODE_STOP:
-              done = true;
-              break;
           }
         }
         break;
@@ -431,60 +469,149 @@ Ref<Result> Code128Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
     if (unshift) {
       codeSet = codeSet == CODE_CODE_A ? CODE_CODE_B : CODE_CODE_A;
     }
-    
   }
 
-  // Check for ample whitespace following pattern, but, to do this we first need to remember that
-  // we fudged decoding CODE_STOP since it actually has 7 bars, not 6. There is a black bar left
-  // to read off. Would be slightly better to properly read. Here we just skip it:
-  nextStart = row->getNextUnset(nextStart);
-  if (!row->isRange(nextStart,
-                    std::min(row->getSize(), nextStart + (nextStart - lastStart) / 2),
-                    false)) {
+  if (result.length() == 0) {
+    // false positive
     throw NotFoundException();
   }
+}
 
-  // Pull out from sum the value of the penultimate check code
-  checksumTotal -= multiplier * lastCode;
-  // lastCode is the checksum then:
-  if (checksumTotal % 103 != lastCode) {
-    throw ChecksumException();
+Code128Reader::Range Code128Reader::findStopPattern(Ref<BitArray> const& row, int rowOffset) {
+  // The stop code is the CODE_STOP pattern followed by a bar two modules
+  // wide, and then whitespace half as wide as the code.
+  const int STOP_PATTERN[] = {2, 3, 3, 1, 1, 1, 2};
+  const int patternLength = 7;
+  vector<int> counters (patternLength, 0);
+  int width = row->getSize();
+  rowOffset = row->getNextSet(rowOffset);
+  int counterPosition = 0;
+  int patternStart = rowOffset;
+  bool isWhite = false;
+  for (int i = rowOffset; i < width; i++) {
+    if (row->get(i) ^ isWhite) {
+      counters[counterPosition]++;
+    } else {
+      if (counterPosition == patternLength - 1) {
+        if (patternMatchVariance(counters, STOP_PATTERN, MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE &&
+            row->isRange(i, std::min(width, i + (i - patternStart) / 2), false)) {
+          return Range(patternStart, i);
+        }
+        patternStart += counters[0] + counters[1];
+        for (int y = 2; y < patternLength; y++) {
+          counters[y - 2] = counters[y];
+        }
+        counters[patternLength - 2] = 0;
+        counters[patternLength - 1] = 0;
+        counterPosition--;
+      } else {
+        counterPosition++;
+      }
+      counters[counterPosition] = 1;
+      isWhite = !isWhite;
+    }
   }
+  throw NotFoundException();
+}
 
-  // Need to pull out the check digits from string
-  int resultLength = (int) result.length();
-  if (resultLength == 0) {
-    // false positive
-    throw NotFoundException();
+void Code128Reader::voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes) {
+  // Codes are 11 modules wide and the stop code 13. To place the codes
+  // between the start and stop codes, measure the module size over as many
+  // codes after the start code as read.
+  vector<int> startPatternInfo;
+  Range stopRange;
+  int codeEnd;
+  int codesRead = 1;
+  vector<int> counters (6, 0);
+  try {
+    startPatternInfo = findStartPattern(row);
+    codeEnd = startPatternInfo[1];
+    stopRange = findStopPattern(row, codeEnd);
+  } catch (NotFoundException const& nfe) {
+    (void)nfe;
+    return;
+  }
+  try {
+    for (;;) {
+      int code = decodeCode(row, counters, codeEnd);
+      int next = codeEnd + counters[0] + counters[1] + counters[2] +
+        counters[3] + counters[4] + counters[5];
+      if (code == CODE_STOP || next > stopRange[0]) {
+        break;
+      }
+      codeEnd = next;
+      codesRead++;
+    }
+  } catch (NotFoundException const& nfe) {
+    (void)nfe;
   }
 
-  // Only bother if the result had at least one character, and if the checksum digit happened to
-  // be a printable character. If it was just interpreted as a control code, nothing to remove.
-  if (resultLength > 0 && lastCharacterWasPrintable) {
-    if (codeSet == CODE_CODE_C) {
-      result.erase(resultLength - 2, resultLength);
-    } else {
-      result.erase(resultLength - 1, resultLength);
+  int start = startPatternInfo[0];
+  float guess = (codeEnd - start + stopRange[1] - stopRange[0]) / (11.0f * codesRead + 13);
+  float codes = ((stopRange[1] - start) / guess - 13) / 11;
+  int codeCount = (int) (codes + 0.5f);
+  if (codeCount < 3 || fabs(codes - codeCount) > 0.3f) {
+    return;
+  }
+  float moduleSize = (stopRange[1] - start) / (11.0f * codeCount + 13);
+
+  int layout = RowVotes::layout(BarcodeFormat::CODE_128, codeCount);
+  votes.addRow(layout, codeCount, rowNumber, (startPatternInfo[0] + startPatternInfo[1]) / 2.0f,
+               (stopRange[0] + stopRange[1]) / 2.0f);
+  for (int position = 0; position < codeCount; position++) {
+    int x = findEdge(row, start + 11 * position * moduleSize, std::max(1, (int) moduleSize), true);
+    if (x < 0) {
+      continue;
+    }
+    try {
+      recordPattern(row, x, counters);
+    } catch (NotFoundException const& nfe) {
+      (void)nfe;
+      continue;
+    }
+    int total = counters[0] + counters[1] + counters[2] + counters[3] + counters[4] + counters[5];
+    if (total < 9 * moduleSize || total > 13 * moduleSize) {
+      continue;
+    }
+    int variance;
+    int code = matchCode(counters, variance);
+    if (code >= 0) {
+      votes.add(layout, position, code, MAX_AVG_VARIANCE - variance);
     }
   }
+}
 
-  float left = (float) (startPatternInfo[1] + startPatternInfo[0]) / 2.0f;
-  float right = (float) (nextStart + lastStart) / 2.0f;
+namespace {
 
-  int rawCodesSize = (int) rawCodes.size();
-  ArrayRef<char> rawBytes (rawCodesSize);
-  for (int i = 0; i < rawCodesSize; i++) {
-    rawBytes[i] = rawCodes[i];
+class CodeCheck : public zxing::oned::RowVotes::Check {
+public:
+  bool accept(vector<int> const& codes) {
+    text.clear();
+    try {
+      Code128Reader::decodeCodes(codes, text);
+    } catch (zxing::ReaderException const& re) {
+      (void)re;
+      return false;
+    }
+    return true;
   }
 
-  ArrayRef< Ref<ResultPoint> > resultPoints(2);
-  resultPoints[0] =
-      Ref<OneDResultPoint>(new OneDResultPoint(left, (float) rowNumber));
-  resultPoints[1] =
-      Ref<OneDResultPoint>(new OneDResultPoint(right, (float) rowNumber));
+  string text;
+};
 
-  return Ref<Result>(new Result(Ref<String>(new String(result)), rawBytes, resultPoints,
-                                BarcodeFormat::CODE_128));
+}
+
+Ref<Result> Code128Reader::decodeVotes(RowVotes const& votes) {
+  vector<int> layouts = votes.getLayouts(BarcodeFormat::CODE_128);
+  for (size_t i = 0; i < layouts.size(); i++) {
+    CodeCheck check;
+    vector<int> codes;
+    if (votes.elect(layouts[i], check, codes)) {
+      return Ref<Result>(new Result(String::adopt(check.text), ArrayRef<char>(),
+                                    votes.getResultPoints(layouts[i]), BarcodeFormat::CODE_128));
+    }
+  }
+  return Ref<Result>();
 }
 
 Code128Reader::~Code128Reader(){}
@@ -29,14 +29,23 @@ private:
   static const int MAX_AVG_VARIANCE;
   static const int MAX_INDIVIDUAL_VARIANCE;
 
-  static std::vector<int> findStartPattern(Ref<BitArray> row);
-  static int decodeCode(Ref<BitArray> row,
+  static std::vector<int> findStartPattern(Ref<BitArray> const& row);
+  static int decodeCode(Ref<BitArray> const& row,
                         std::vector<int>& counters,
                         int rowOffset);
+  static int matchCode(std::vector<int>& counters, int& variance);
+  static Range findStopPattern(Ref<BitArray> const& row, int rowOffset);
 			
 public:
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
+  void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+  Ref<Result> decodeVotes(RowVotes const& votes);
+
+  // Appends the text of a start code, data codes and checksum; throws a
+  // ReaderException if they are not a valid barcode.
+  static void decodeCodes(std::vector<int> const& codes, std::string& result);
   Code128Reader();
+  Ref<OneDReader> clone() const;
   ~Code128Reader();
 
   BarcodeFormat getBarcodeFormat();
@@ -18,6 +18,7 @@
 #include "Code39Reader.h"
 #include <zxing/oned/OneDResultPoint.h>
 #include <zxing/common/Array.h>
+#include <zxing/oned/PatternLookup.h>
 #include <zxing/ReaderException.h>
 #include <zxing/NotFoundException.h>
 #include <zxing/ChecksumException.h>
@@ -31,6 +32,7 @@ using zxing::String;
 using zxing::NotFoundException;
 using zxing::ChecksumException;
 using zxing::oned::Code39Reader;
+using zxing::oned::PatternLookup;
 
 // VC++
 using zxing::BitArray;
@@ -58,6 +60,13 @@ namespace {
     "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-. *$/+%";
 
   std::string alphabet_string (ALPHABET_STRING);
+
+  // Character index by encoding.
+  vector<signed char> const& characterIndices() {
+    static const vector<signed char> indices(
+      PatternLookup::invert(CHARACTER_ENCODINGS, CHARACTER_ENCODINGS_LEN, 9));
+    return indices;
+  }
 }
 
 void Code39Reader::init(bool usingCheckDigit_, bool extendedMode_) {
@@ -91,7 +100,11 @@ Code39Reader::Code39Reader(bool usingCheckDigit_, bool extendedMode_) {
   init(usingCheckDigit_, extendedMode_);
 }
 
-Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<zxing::oned::OneDReader> Code39Reader::clone() const {
+  return Ref<OneDReader>(new Code39Reader(usingCheckDigit, extendedMode));
+}
+
+Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   std::vector<int>& theCounters (counters);
   { // Arrays.fill(counters, 0);
     int size = (int) theCounters.size();
@@ -174,7 +187,7 @@ Ref<Result> Code39Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
     );
 }
 
-vector<int> Code39Reader::findAsteriskPattern(Ref<BitArray> row, vector<int>& counters){
+vector<int> Code39Reader::findAsteriskPattern(Ref<BitArray> const& row, vector<int>& counters){
   int width = row->getSize();
   int rowOffset = row->getNextSet(0);
 
@@ -262,12 +275,11 @@ int Code39Reader::toNarrowWidePattern(vector<int>& counters){
 }
 
 char Code39Reader::patternToChar(int pattern){
-  for (int i = 0; i < CHARACTER_ENCODINGS_LEN; i++) {
-    if (CHARACTER_ENCODINGS[i] == pattern) {
-      return ALPHABET[i];
-    }
+  int i = pattern >= 0 && pattern < (1 << 9) ? characterIndices()[pattern] : -1;
+  if (i < 0) {
+    throw ReaderException("");
   }
-  throw ReaderException("");
+  return ALPHABET[i];
 }
 
 Ref<String> Code39Reader::decodeExtended(std::string encoded){
@@ -323,6 +335,6 @@ Ref<String> Code39Reader::decodeExtended(std::string encoded){
       tmpDecoded.append(1, c);
     }
   }
-  Ref<String> decoded(new String(tmpDecoded));
+  Ref<String> decoded(String::adopt(tmpDecoded));
   return decoded;
 }
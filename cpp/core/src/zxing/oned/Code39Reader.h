@@ -41,7 +41,7 @@ private:
 			
   void init(bool usingCheckDigit = false, bool extendedMode = false);
 
-  static std::vector<int> findAsteriskPattern(Ref<BitArray> row,
+  static std::vector<int> findAsteriskPattern(Ref<BitArray> const& row,
                                               std::vector<int>& counters);
   static int toNarrowWidePattern(std::vector<int>& counters);
   static char patternToChar(int pattern);
@@ -53,8 +53,9 @@ public:
   Code39Reader();
   Code39Reader(bool usingCheckDigit_);
   Code39Reader(bool usingCheckDigit_, bool extendedMode_);
+  Ref<OneDReader> clone() const;
 			
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
 };
 
 }
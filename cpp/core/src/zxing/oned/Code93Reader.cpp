@@ -18,6 +18,7 @@
 #include "Code93Reader.h"
 #include <zxing/oned/OneDResultPoint.h>
 #include <zxing/common/Array.h>
+#include <zxing/oned/PatternLookup.h>
 #include <zxing/ReaderException.h>
 #include <zxing/FormatException.h>
 #include <zxing/NotFoundException.h>
@@ -33,6 +34,7 @@ using zxing::String;
 using zxing::NotFoundException;
 using zxing::ChecksumException;
 using zxing::oned::Code93Reader;
+using zxing::oned::PatternLookup;
 
 // VC++
 using zxing::BitArray;
@@ -57,6 +59,13 @@ namespace {
   int const CHARACTER_ENCODINGS_LENGTH = 
     (int)sizeof(CHARACTER_ENCODINGS)/sizeof(CHARACTER_ENCODINGS[0]);
   const int ASTERISK_ENCODING = CHARACTER_ENCODINGS[47];
+
+  // Character index by encoding.
+  vector<signed char> const& characterIndices() {
+    static const vector<signed char> indices(
+      PatternLookup::invert(CHARACTER_ENCODINGS, CHARACTER_ENCODINGS_LENGTH, 9));
+    return indices;
+  }
 }
 
 Code93Reader::Code93Reader() {
@@ -64,7 +73,11 @@ Code93Reader::Code93Reader() {
   counters.resize(6);
 }
 
-Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<zxing::oned::OneDReader> Code93Reader::clone() const {
+  return Ref<OneDReader>(new Code93Reader());
+}
+
+Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   Range start (findAsteriskPattern(row));
   // Read off white space    
   int nextStart = row->getNextSet(start[1]);
@@ -129,7 +142,7 @@ Ref<Result> Code93Reader::decodeRow(int rowNumber, Ref<BitArray> row) {
                        BarcodeFormat::CODE_93));
 }
 
-Code93Reader::Range Code93Reader::findAsteriskPattern(Ref<BitArray> row)  {
+Code93Reader::Range Code93Reader::findAsteriskPattern(Ref<BitArray> const& row)  {
   int width = row->getSize();
   int rowOffset = row->getNextSet(0);
 
@@ -197,12 +210,11 @@ int Code93Reader::toPattern(vector<int>& counters) {
 }
 
 char Code93Reader::patternToChar(int pattern)  {
-  for (int i = 0; i < CHARACTER_ENCODINGS_LENGTH; i++) {
-    if (CHARACTER_ENCODINGS[i] == pattern) {
-      return ALPHABET[i];
-    }
+  int i = pattern >= 0 && pattern < (1 << 9) ? characterIndices()[pattern] : -1;
+  if (i < 0) {
+    throw NotFoundException();
   }
-  throw NotFoundException();
+  return ALPHABET[i];
 }
 
 Ref<String> Code93Reader::decodeExtended(string const& encoded)  {
@@ -261,7 +273,7 @@ Ref<String> Code93Reader::decodeExtended(string const& encoded)  {
       decoded.append(1, c);
     }
   }
-  return Ref<String>(new String(decoded));
+  return String::adopt(decoded);
 }
 
 void Code93Reader::checkChecksums(string const& result) {
@@ -35,13 +35,14 @@ namespace oned {
 class Code93Reader : public OneDReader {
 public:
   Code93Reader();
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+  Ref<OneDReader> clone() const;
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
 
 private:
   std::string decodeRowResult;
   std::vector<int> counters;
 
-  Range findAsteriskPattern(Ref<BitArray> row);
+  Range findAsteriskPattern(Ref<BitArray> const& row);
 
   static int toPattern(std::vector<int>& counters);
   static char patternToChar(int pattern);
@@ -21,7 +21,9 @@
 using std::vector;
 using zxing::Ref;
 using zxing::BitArray;
+using zxing::Result;
 using zxing::oned::EAN13Reader;
+using zxing::oned::RowVotes;
 
 namespace {
   const int FIRST_DIGIT_ENCODINGS[10] = {
@@ -31,7 +33,11 @@ namespace {
 
 EAN13Reader::EAN13Reader() : decodeMiddleCounters(4, 0) { }
 
-int EAN13Reader::decodeMiddle(Ref<BitArray> row,
+Ref<zxing::oned::OneDReader> EAN13Reader::clone() const {
+  return Ref<OneDReader>(new EAN13Reader());
+}
+
+int EAN13Reader::decodeMiddle(Ref<BitArray> const& row,
                               Range const& startRange,
                               std::string& resultString) {
   vector<int>& counters (decodeMiddleCounters);
@@ -69,6 +75,28 @@ int EAN13Reader::decodeMiddle(Ref<BitArray> row,
   return rowOffset;
 }
 
+void EAN13Reader::voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes) {
+  voteDigits(rowNumber, row, votes, 6, L_AND_G_PATTERNS);
+}
+
+Ref<Result> EAN13Reader::decodeVotes(RowVotes const& votes) {
+  return decodeDigitVotes(votes, 12);
+}
+
+void EAN13Reader::appendVotedText(vector<int> const& digits, std::string& text) {
+  int lgPatternFound = 0;
+  for (int x = 0; x < 6; x++) {
+    text.append(1, (char) ('0' + digits[x] % 10));
+    if (digits[x] >= 10) {
+      lgPatternFound |= 1 << (5 - x);
+    }
+  }
+  determineFirstDigit(text, lgPatternFound);
+  for (int x = 6; x < 12; x++) {
+    text.append(1, (char) ('0' + digits[x]));
+  }
+}
+
 void EAN13Reader::determineFirstDigit(std::string& resultString, int lgPatternFound) {
   // std::cerr << "K " << resultString << " " << lgPatternFound << " " <<FIRST_DIGIT_ENCODINGS << std::endl;
   for (int d = 0; d < 10; d++) {
@@ -35,11 +35,16 @@ private:
 
 public:
   EAN13Reader();
+  Ref<OneDReader> clone() const;
 
-  int decodeMiddle(Ref<BitArray> row,
+  int decodeMiddle(Ref<BitArray> const& row,
                    Range const& startRange,
                    std::string& resultString);
 
+  void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+  Ref<Result> decodeVotes(RowVotes const& votes);
+  void appendVotedText(std::vector<int> const& digits, std::string& text);
+
   BarcodeFormat getBarcodeFormat();
 };
 
@@ -20,6 +20,7 @@
 
 using std::vector;
 using zxing::oned::EAN8Reader;
+using zxing::oned::RowVotes;
 
 // VC++
 using zxing::Ref;
@@ -27,7 +28,11 @@ using zxing::BitArray;
 
 EAN8Reader::EAN8Reader() : decodeMiddleCounters(4, 0) {}
 
-int EAN8Reader::decodeMiddle(Ref<BitArray> row,
+Ref<zxing::oned::OneDReader> EAN8Reader::clone() const {
+  return Ref<OneDReader>(new EAN8Reader());
+}
+
+int EAN8Reader::decodeMiddle(Ref<BitArray> const& row,
                              Range const& startRange,
                              std::string& result){
   vector<int>& counters (decodeMiddleCounters);
@@ -60,6 +65,14 @@ int EAN8Reader::decodeMiddle(Ref<BitArray> row,
   return rowOffset;
 }
 
+void EAN8Reader::voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes) {
+  voteDigits(rowNumber, row, votes, 4, L_PATTERNS);
+}
+
+Ref<zxing::Result> EAN8Reader::decodeVotes(RowVotes const& votes) {
+  return decodeDigitVotes(votes, 8);
+}
+
 zxing::BarcodeFormat EAN8Reader::getBarcodeFormat(){
   return BarcodeFormat::EAN_8;
 }
@@ -33,11 +33,15 @@ class EAN8Reader : public UPCEANReader {
 
  public:
   EAN8Reader();
+  Ref<OneDReader> clone() const;
 
-  int decodeMiddle(Ref<BitArray> row,
+  int decodeMiddle(Ref<BitArray> const& row,
                    Range const& startRange,
                    std::string& resultString);
 
+  void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+  Ref<Result> decodeVotes(RowVotes const& votes);
+
   BarcodeFormat getBarcodeFormat();
 };
 
@@ -0,0 +1,109 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/EdgeRow.h>
+#include <algorithm>
+#include <stdlib.h>
+
+using std::vector;
+using zxing::ArrayRef;
+using zxing::BitArray;
+using zxing::oned::EdgeRow;
+
+namespace {
+
+// Changes in luminance between neighbouring pixels weaker than this are
+// noise.
+const int MIN_EDGE_STRENGTH = 16;
+// Edges weaker than this fraction of the strongest in the row are noise.
+const int EDGE_STRENGTH_DIVISOR = 5;
+
+}
+
+EdgeRow::EdgeRow() : width_(0), firstBlack_(false) {
+}
+
+void EdgeRow::find(ArrayRef<char> const& luminances, int width) {
+  width_ = width;
+  edges_.clear();
+  firstBlack_ = false;
+  if (width < 2) {
+    return;
+  }
+
+  // gradient_[x] is the change from pixel x - 1 to pixel x, positive where
+  // the row gets lighter; pixel x covers [x, x + 1), so the change is at x.
+  // A difference over two pixels would smooth noise but blur together bars
+  // little more than a pixel wide.
+  char const* pixels = &luminances[0];
+  gradient_.resize(width + 1);
+  gradient_[0] = 0;
+  gradient_[width] = 0;
+  int strongest = 0;
+  for (int x = 1; x < width; x++) {
+    int change = (pixels[x] & 0xff) - (pixels[x - 1] & 0xff);
+    gradient_[x] = change;
+    strongest = std::max(strongest, abs(change));
+  }
+  int threshold = std::max(MIN_EDGE_STRENGTH, strongest / EDGE_STRENGTH_DIVISOR);
+
+  // Each peak of the gradient is an edge. Edges must alternate between
+  // getting lighter and getting darker; of two in the same direction, the
+  // stronger one is kept.
+  int lastChange = 0;
+  for (int x = 1; x < width; x++) {
+    int before = gradient_[x - 1];
+    int change = gradient_[x];
+    int after = gradient_[x + 1];
+    if (abs(change) < threshold ||
+        (change > 0 ? change <= before || change < after : change >= before || change > after)) {
+      continue;
+    }
+    // The centroid of the peak and its neighbours in the same direction,
+    // which is exact for a sharp edge that partly covers a pixel.
+    if ((before > 0) != (change > 0)) {
+      before = 0;
+    }
+    if ((after > 0) != (change > 0)) {
+      after = 0;
+    }
+    float edge = x + (float) (after - before) / (before + change + after);
+    if (lastChange != 0 && (change > 0) == (lastChange > 0)) {
+      if (abs(change) > abs(lastChange)) {
+        edges_.back() = edge;
+        lastChange = change;
+      }
+      continue;
+    }
+    if (lastChange == 0) {
+      firstBlack_ = change > 0;
+    }
+    edges_.push_back(edge);
+    lastChange = change;
+  }
+}
+
+void EdgeRow::render(int scale, BitArray& row) const {
+  row.clear();
+  for (int run = firstBlack_ ? 0 : 1; run < getRunCount(); run += 2) {
+    int start = (int) (getRunStart(run) * scale + 0.5f);
+    int end = std::min(row.getSize(), (int) (getRunEnd(run) * scale + 0.5f));
+    if (end > start) {
+      row.setRange(start, end);
+    }
+  }
+}
@@ -0,0 +1,63 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __EDGE_ROW_H__
+#define __EDGE_ROW_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/common/Array.h>
+#include <zxing/common/BitArray.h>
+#include <vector>
+
+namespace zxing {
+namespace oned {
+
+// The bar edges of a row of luminances, found where the change in
+// luminance peaks rather than where it crosses a threshold, and placed
+// between pixels at the centroid of the peak. Unlike a binarized row, this
+// keeps bars that blur or a low resolution leave too faint to cross a
+// threshold, and measures bar widths to a fraction of a pixel.
+class EdgeRow {
+public:
+  EdgeRow();
+
+  // Finds the edges of luminances[0, width), replacing any found before.
+  void find(ArrayRef<char> const& luminances, int width);
+
+  int getWidth() const {return width_;}
+  // Runs of black or white, alternating, from the first pixel to the last.
+  int getRunCount() const {return (int) edges_.size() + 1;}
+  bool isBlack(int run) const {return ((run & 1) == 0) == firstBlack_;}
+  float getRunStart(int run) const {return run == 0 ? 0 : edges_[run - 1];}
+  float getRunEnd(int run) const {
+    return run == (int) edges_.size() ? (float) width_ : edges_[run];
+  }
+
+  // Draws the runs into row, which must hold scale bits per pixel, so that
+  // readers of binarized rows see the edges to 1 / scale of a pixel.
+  void render(int scale, BitArray& row) const;
+
+private:
+  int width_;
+  bool firstBlack_;
+  std::vector<float> edges_;
+  std::vector<int> gradient_;
+};
+
+}
+}
+
+#endif // __EDGE_ROW_H__
@@ -43,9 +43,10 @@ namespace {
 const int W = 3; // Pixel width of a wide line
 const int N = 1; // Pixed width of a narrow line
 
-const int DEFAULT_ALLOWED_LENGTHS_[] =
+const int DEFAULT_ALLOWED_LENGTHS[] =
 { 48, 44, 24, 20, 18, 16, 14, 12, 10, 8, 6 };
-const ArrayRef<int> DEFAULT_ALLOWED_LENGTHS (new Array<int>(VECTOR_INIT(DEFAULT_ALLOWED_LENGTHS_)));
+const int DEFAULT_ALLOWED_LENGTHS_COUNT =
+  sizeof(DEFAULT_ALLOWED_LENGTHS) / sizeof(DEFAULT_ALLOWED_LENGTHS[0]);
 
 /**
  * Start/end guard pattern.
@@ -80,8 +81,12 @@ const int PATTERNS[][5] = {
 ITFReader::ITFReader() : narrowLineWidth(-1) {
 }
 
+Ref<zxing::oned::OneDReader> ITFReader::clone() const {
+  return Ref<OneDReader>(new ITFReader());
+}
+
 
-Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   // Find out where the Middle section (payload) starts & ends
 
   Range startRange = decodeStart(row);
@@ -89,20 +94,16 @@ Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row) {
 
   std::string result;
   decodeMiddle(row, startRange[1], endRange[0], result);
-  Ref<String> resultString(new String(result));
+  Ref<String> resultString(String::adopt(result));
 
-  ArrayRef<int> allowedLengths;
-  // Java hints stuff missing
-  if (!allowedLengths) {
-    allowedLengths = DEFAULT_ALLOWED_LENGTHS;
-  }
+  // Java hints stuff missing, so the default lengths always apply
 
   // To avoid false positives with 2D barcodes (and other patterns), make
   // an assumption that the decoded string must be 6, 10 or 14 digits.
   int length = resultString->size();
   bool lengthOK = false;
-  for (int i = 0, e = allowedLengths->size(); i < e; i++) {
-    if (length == allowedLengths[i]) {
+  for (int i = 0; i < DEFAULT_ALLOWED_LENGTHS_COUNT; i++) {
+    if (length == DEFAULT_ALLOWED_LENGTHS[i]) {
       lengthOK = true;
       break;
     }
@@ -126,7 +127,7 @@ Ref<Result> ITFReader::decodeRow(int rowNumber, Ref<BitArray> row) {
  * @param resultString {@link StringBuffer} to append decoded chars to
  * @throws ReaderException if decoding could not complete successfully
  */
-void ITFReader::decodeMiddle(Ref<BitArray> row,
+void ITFReader::decodeMiddle(Ref<BitArray> const& row,
                              int payloadStart,
                              int payloadEnd,
                              std::string& resultString) {
@@ -169,7 +170,7 @@ void ITFReader::decodeMiddle(Ref<BitArray> row,
  *         'start block'
  * @throws ReaderException
  */
-ITFReader::Range ITFReader::decodeStart(Ref<BitArray> row) {
+ITFReader::Range ITFReader::decodeStart(Ref<BitArray> const& row) {
   int endStart = skipWhiteSpace(row);
   Range startPattern = findGuardPattern(row, endStart, START_PATTERN);
 
@@ -191,7 +192,7 @@ ITFReader::Range ITFReader::decodeStart(Ref<BitArray> row) {
  * @throws ReaderException
  */
 
-ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> row) {
+ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> const& row) {
   // For convenience, reverse the row and then
   // search from 'the start' for the end block
   BitArray::Reverse r (row);
@@ -229,7 +230,7 @@ ITFReader::Range ITFReader::decodeEnd(Ref<BitArray> row) {
  * @param startPattern index into row of the start or end pattern.
  * @throws ReaderException if the quiet zone cannot be found, a ReaderException is thrown.
  */
-void ITFReader::validateQuietZone(Ref<BitArray> row, int startPattern) {
+void ITFReader::validateQuietZone(Ref<BitArray> const& row, int startPattern) {
   int quietCount = this->narrowLineWidth * 10;  // expect to find this many pixels of quiet zone
 
   for (int i = startPattern - 1; quietCount > 0 && i >= 0; i--) {
@@ -251,7 +252,7 @@ void ITFReader::validateQuietZone(Ref<BitArray> row, int startPattern) {
  * @return index of the first black line.
  * @throws ReaderException Throws exception if no black lines are found in the row
  */
-int ITFReader::skipWhiteSpace(Ref<BitArray> row) {
+int ITFReader::skipWhiteSpace(Ref<BitArray> const& row) {
   int width = row->getSize();
   int endStart = row->getNextSet(0);
   if (endStart == width) {
@@ -269,7 +270,7 @@ int ITFReader::skipWhiteSpace(Ref<BitArray> row) {
  *         ints
  * @throws ReaderException if pattern is not found
  */
-ITFReader::Range ITFReader::findGuardPattern(Ref<BitArray> row,
+ITFReader::Range ITFReader::findGuardPattern(Ref<BitArray> const& row,
                                              int rowOffset,
                                              vector<int> const& pattern) {
   // TODO: This is very similar to implementation in UPCEANReader. Consider if they can be
@@ -17,45 +17,70 @@
 
 #include <zxing/ZXing.h>
 #include <zxing/oned/MultiFormatOneDReader.h>
+#ifndef NO_UPC_EAN
 #include <zxing/oned/MultiFormatUPCEANReader.h>
+#endif
+#ifndef NO_CODE_39
 #include <zxing/oned/Code39Reader.h>
+#endif
+#ifndef NO_CODE_128
 #include <zxing/oned/Code128Reader.h>
+#endif
+#ifndef NO_CODE_93
 #include <zxing/oned/Code93Reader.h>
+#endif
+#ifndef NO_CODABAR
 #include <zxing/oned/CodaBarReader.h>
+#endif
+#ifndef NO_ITF
 #include <zxing/oned/ITFReader.h>
+#endif
 #include <zxing/ReaderException.h>
 #include <zxing/NotFoundException.h>
 
 using zxing::Ref;
 using zxing::Result;
 using zxing::oned::MultiFormatOneDReader;
+using zxing::oned::RowVotes;
 
 // VC++
 using zxing::DecodeHints;
 using zxing::BitArray;
 
-MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
+MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints_) : readers(), hints(hints_) {
+#ifndef NO_UPC_EAN
   if (hints.containsFormat(BarcodeFormat::EAN_13) ||
       hints.containsFormat(BarcodeFormat::EAN_8) ||
       hints.containsFormat(BarcodeFormat::UPC_A) ||
       hints.containsFormat(BarcodeFormat::UPC_E)) {
     readers.push_back(Ref<OneDReader>(new MultiFormatUPCEANReader(hints)));
   }
+#endif
+#ifndef NO_CODE_39
   if (hints.containsFormat(BarcodeFormat::CODE_39)) {
     readers.push_back(Ref<OneDReader>(new Code39Reader()));
   }
+#endif
+#ifndef NO_CODE_93
   if (hints.containsFormat(BarcodeFormat::CODE_93)) {
     readers.push_back(Ref<OneDReader>(new Code93Reader()));
   }
+#endif
+#ifndef NO_CODE_128
   if (hints.containsFormat(BarcodeFormat::CODE_128)) {
     readers.push_back(Ref<OneDReader>(new Code128Reader()));
   }
+#endif
+#ifndef NO_ITF
   if (hints.containsFormat(BarcodeFormat::ITF)) {
     readers.push_back(Ref<OneDReader>(new ITFReader()));
   }
+#endif
+#ifndef NO_CODABAR
   if (hints.containsFormat(BarcodeFormat::CODABAR)) {
     readers.push_back(Ref<OneDReader>(new CodaBarReader()));
   }
+#endif
 /*
   if (hints.containsFormat(BarcodeFormat::RSS_14)) {
     readers.push_back(Ref<OneDReader>(new RSS14Reader()));
@@ -67,20 +92,36 @@ MultiFormatOneDReader::MultiFormatOneDReader(DecodeHints hints) : readers() {
   }
 */
   if (readers.size() == 0) {
+#ifndef NO_UPC_EAN
     readers.push_back(Ref<OneDReader>(new MultiFormatUPCEANReader(hints)));
+#endif
+#ifndef NO_CODE_39
     readers.push_back(Ref<OneDReader>(new Code39Reader()));
+#endif
+#ifndef NO_CODABAR
     readers.push_back(Ref<OneDReader>(new CodaBarReader()));
+#endif
+#ifndef NO_CODE_93
     readers.push_back(Ref<OneDReader>(new Code93Reader()));
+#endif
+#ifndef NO_CODE_128
     readers.push_back(Ref<OneDReader>(new Code128Reader()));
+#endif
+#ifndef NO_ITF
     readers.push_back(Ref<OneDReader>(new ITFReader()));
+#endif
     // readers.push_back(Ref<OneDReader>(new RSS14Reader()));
     // readers.push_back(Ref<OneDReader>(new RSS14ExpandedReader()));
   }
 }
 
+Ref<zxing::oned::OneDReader> MultiFormatOneDReader::clone() const {
+  return Ref<OneDReader>(new MultiFormatOneDReader(hints));
+}
+
 #include <typeinfo>
 
-Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   int size = (int) readers.size();
   for (int i = 0; i < size; i++) {
     OneDReader* reader = readers[i];
@@ -94,3 +135,19 @@ Ref<Result> MultiFormatOneDReader::decodeRow(int rowNumber, Ref<BitArray> row) {
   }
   throw NotFoundException();
 }
+
+void MultiFormatOneDReader::voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes) {
+  for (int i = 0, size = (int) readers.size(); i < size; i++) {
+    readers[i]->voteRow(rowNumber, row, votes);
+  }
+}
+
+Ref<Result> MultiFormatOneDReader::decodeVotes(RowVotes const& votes) {
+  for (int i = 0, size = (int) readers.size(); i < size; i++) {
+    Ref<Result> result = readers[i]->decodeVotes(votes);
+    if (result) {
+      return result;
+    }
+  }
+  return Ref<Result>();
+}
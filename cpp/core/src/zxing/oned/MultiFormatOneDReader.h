@@ -27,10 +27,14 @@ namespace zxing {
 
     private:
       std::vector<Ref<OneDReader> > readers;
+      DecodeHints hints;
     public:
-      MultiFormatOneDReader(DecodeHints hints);
+      MultiFormatOneDReader(DecodeHints hints_);
+      Ref<OneDReader> clone() const;
 
-      Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+      Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
+      void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+      Ref<Result> decodeVotes(RowVotes const& votes);
     };
   }
 }
@@ -34,12 +34,13 @@ using zxing::NotFoundException;
 using zxing::Ref;
 using zxing::Result;
 using zxing::oned::MultiFormatUPCEANReader;
+using zxing::oned::RowVotes;
     
 // VC++
 using zxing::DecodeHints;
 using zxing::BitArray;
 
-MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints) : readers() {
+MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints_) : readers(), hints(hints_) {
   if (hints.containsFormat(BarcodeFormat::EAN_13)) {
     readers.push_back(Ref<UPCEANReader>(new EAN13Reader()));
   } else if (hints.containsFormat(BarcodeFormat::UPC_A)) {
@@ -59,13 +60,17 @@ MultiFormatUPCEANReader::MultiFormatUPCEANReader(DecodeHints hints) : readers()
   }
 }
 
+Ref<zxing::oned::OneDReader> MultiFormatUPCEANReader::clone() const {
+  return Ref<OneDReader>(new MultiFormatUPCEANReader(hints));
+}
+
 #include <typeinfo>
 
-Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   // Compute this location once and reuse it on multiple implementations
   UPCEANReader::Range startGuardPattern = UPCEANReader::findStartGuardPattern(row);
   for (int i = 0, e = (int) readers.size(); i < e; i++) {
-    Ref<UPCEANReader> reader = readers[i];
+    Ref<UPCEANReader> const& reader = readers[i];
     Ref<Result> result;
     try {
       result = reader->decodeRow(rowNumber, row, startGuardPattern);
@@ -74,37 +79,57 @@ Ref<Result> MultiFormatUPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row)
       continue;
     }
 
-    // Special case: a 12-digit code encoded in UPC-A is identical
-    // to a "0" followed by those 12 digits encoded as EAN-13. Each
-    // will recognize such a code, UPC-A as a 12-digit string and
-    // EAN-13 as a 13-digit string starting with "0".  Individually
-    // these are correct and their readers will both read such a
-    // code and correctly call it EAN-13, or UPC-A, respectively.
-    //
-    // In this case, if we've been looking for both types, we'd like
-    // to call it a UPC-A code. But for efficiency we only run the
-    // EAN-13 decoder to also read UPC-A. So we special case it
-    // here, and convert an EAN-13 result to a UPC-A result if
-    // appropriate.
-    bool ean13MayBeUPCA =
-      result->getBarcodeFormat() == BarcodeFormat::EAN_13 &&
-      result->getText()->charAt(0) == '0';
+    return preferUPCA(result);
+  }
 
-    // Note: doesn't match Java which uses hints
+  throw NotFoundException();
+}
 
-    bool canReturnUPCA = true;
+void MultiFormatUPCEANReader::voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes) {
+  for (int i = 0, e = (int) readers.size(); i < e; i++) {
+    readers[i]->voteRow(rowNumber, row, votes);
+  }
+}
 
-    if (ean13MayBeUPCA && canReturnUPCA) {
-      // Transfer the metdata across
-      Ref<Result> resultUPCA (new Result(result->getText()->substring(1),
-                                         result->getRawBytes(),
-                                         result->getResultPoints(),
-                                         BarcodeFormat::UPC_A));
-      // needs java metadata stuff
-      return resultUPCA;
+Ref<Result> MultiFormatUPCEANReader::decodeVotes(RowVotes const& votes) {
+  for (int i = 0, e = (int) readers.size(); i < e; i++) {
+    Ref<Result> result = readers[i]->decodeVotes(votes);
+    if (result) {
+      return preferUPCA(result);
     }
-    return result;
   }
+  return Ref<Result>();
+}
 
-  throw NotFoundException();
+Ref<Result> MultiFormatUPCEANReader::preferUPCA(Ref<Result> const& result) {
+  // Special case: a 12-digit code encoded in UPC-A is identical
+  // to a "0" followed by those 12 digits encoded as EAN-13. Each
+  // will recognize such a code, UPC-A as a 12-digit string and
+  // EAN-13 as a 13-digit string starting with "0".  Individually
+  // these are correct and their readers will both read such a
+  // code and correctly call it EAN-13, or UPC-A, respectively.
+  //
+  // In this case, if we've been looking for both types, we'd like
+  // to call it a UPC-A code. But for efficiency we only run the
+  // EAN-13 decoder to also read UPC-A. So we special case it
+  // here, and convert an EAN-13 result to a UPC-A result if
+  // appropriate.
+  bool ean13MayBeUPCA =
+    result->getBarcodeFormat() == BarcodeFormat::EAN_13 &&
+    result->getText()->charAt(0) == '0';
+
+  // Note: doesn't match Java which uses hints
+
+  bool canReturnUPCA = true;
+
+  if (ean13MayBeUPCA && canReturnUPCA) {
+    // Transfer the metdata across
+    Ref<Result> resultUPCA (new Result(result->getText()->substring(1),
+                                       result->getRawBytes(),
+                                       result->getResultPoints(),
+                                       BarcodeFormat::UPC_A));
+    // needs java metadata stuff
+    return resultUPCA;
+  }
+  return result;
 }
@@ -30,9 +30,14 @@ class UPCEANReader;
 class MultiFormatUPCEANReader : public OneDReader {
 private:
     std::vector< Ref<UPCEANReader> > readers;
+    DecodeHints hints;
+    static Ref<Result> preferUPCA(Ref<Result> const& result);
 public:
-    MultiFormatUPCEANReader(DecodeHints hints);
-    Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
+    MultiFormatUPCEANReader(DecodeHints hints_);
+    Ref<OneDReader> clone() const;
+    Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
+    void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+    Ref<Result> decodeVotes(RowVotes const& votes);
 };
 
 }
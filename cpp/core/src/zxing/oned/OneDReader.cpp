@@ -19,20 +19,34 @@
 #include <zxing/oned/OneDReader.h>
 #include <zxing/ReaderException.h>
 #include <zxing/oned/OneDResultPoint.h>
+#include <zxing/oned/EdgeRow.h>
 #include <zxing/NotFoundException.h>
+#include <zxing/common/GlobalHistogramBinarizer.h>
+#include <zxing/common/ParallelSearch.h>
+#include <algorithm>
 #include <math.h>
 #include <limits.h>
 
 using std::vector;
 using zxing::Ref;
+using zxing::ArrayRef;
 using zxing::Result;
+using zxing::ResultPoint;
 using zxing::NotFoundException;
+using zxing::ReaderException;
+using zxing::ParallelSearch;
+using zxing::GlobalHistogramBinarizer;
 using zxing::oned::OneDReader;
+using zxing::oned::EdgeRow;
+using zxing::oned::OneDResultPoint;
+using zxing::oned::RowVotes;
 
 // VC++
 using zxing::BinaryBitmap;
 using zxing::BitArray;
 using zxing::DecodeHints;
+using zxing::LuminanceSource;
+using zxing::Reader;
 
 OneDReader::OneDReader() {}
 
@@ -40,13 +54,37 @@ Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
   try {
     return doDecode(image, hints);
   } catch (NotFoundException const& nfe) {
+    vector<int> const& angles = hints.getScanAngles();
+    if (!angles.empty()) {
+      // A row of the rotated image is a line at 90 degrees, so trying
+      // harder scans those lines rather than rotating the image.
+      if (hints.getTryHarder() &&
+          std::find(angles.begin(), angles.end(), 90) == angles.end() &&
+          std::find(angles.begin(), angles.end(), -90) == angles.end()) {
+        vector<int> withColumns (angles);
+        withColumns.push_back(90);
+        hints.setScanAngles(withColumns);
+      }
+      Ref<Result> result = doDecodeAngled(image, hints);
+      if (result) {
+        return result;
+      }
+      throw nfe;
+    }
     // std::cerr << "trying harder" << std::endl;
     bool tryHarder = hints.getTryHarder();
     if (tryHarder && image->isRotateSupported()) {
       // std::cerr << "v rotate" << std::endl;
       Ref<BinaryBitmap> rotatedImage(image->rotateCounterClockwise());
       // std::cerr << "^ rotate" << std::endl;
-      Ref<Result> result = doDecode(rotatedImage, hints);
+      DecodeHints rotatedHints(hints);
+      if (hints.hasRegionOfInterest()) {
+        // Rotating counter clockwise maps (x, y) to (y, width - 1 - x)
+        int left, top, right, bottom;
+        hints.getRegionOfInterest(image->getWidth(), image->getHeight(), left, top, right, bottom);
+        rotatedHints.setRegionOfInterest(top, image->getWidth() - right, bottom - top, right - left);
+      }
+      Ref<Result> result = doDecode(rotatedImage, rotatedHints);
       // Doesn't have java metadata stuff
       ArrayRef< Ref<ResultPoint> >& points (result->getResultPoints());
       if (points && !points->empty()) {
@@ -64,54 +102,70 @@ Ref<Result> OneDReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
   }
 }
 
-#include <typeinfo>
+namespace {
 
-Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
-  int width = image->getWidth();
-  int height = image->getHeight();
-  Ref<BitArray> row(new BitArray(width));
+// Rows or lines a worker claims at a time when scanning in parallel.
+const int ROWS_PER_BATCH = 4;
 
-  int middle = height >> 1;
-  bool tryHarder = hints.getTryHarder();
-  int rowStep = std::max(1, height >> (tryHarder ? 8 : 5));
-  using namespace std;
-  // cerr << "rS " << rowStep << " " << height << " " << tryHarder << endl;
-  int maxLines;
-  if (tryHarder) {
-    maxLines = height; // Look at the whole image, not just the center
-  } else {
-    maxLines = 15; // 15 rows spaced 1/32 apart is roughly the middle half of the image
-  }
+// Bits per pixel of rows drawn from sub-pixel edges.
+const int EDGE_SCALE = 4;
 
-  for (int x = 0; x < maxLines; x++) {
-
-    // Scanning from the middle out. Determine which row we're looking at next:
-    int rowStepsAboveOrBelow = (x + 1) >> 1;
-    bool isAbove = (x & 0x01) == 0; // i.e. is x even?
-    int rowNumber = middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
-    if (false) {
-      std::cerr << "rN "
-                << rowNumber << " "
-                << height << " "
-                << middle << " "
-                << rowStep << " "
-                << isAbove << " "
-                << rowStepsAboveOrBelow
-                << std::endl;
-    }
-    if (rowNumber < 0 || rowNumber >= height) {
-      // Oops, if we run off the top or bottom, stop
-      break;
+const double PI = 3.14159265358979323846;
+
+// Scanning from the middle out: the x'th row to look at.
+int scanRowNumber(int middle, int rowStep, int x) {
+  int rowStepsAboveOrBelow = (x + 1) >> 1;
+  bool isAbove = (x & 0x01) == 0; // i.e. is x even?
+  return middle + rowStep * (isAbove ? rowStepsAboveOrBelow : -rowStepsAboveOrBelow);
+}
+
+// Adds up to threads - 1 copies of reader for extra workers to use; readers
+// that cannot be copied only scan on the calling thread.
+void cloneReaders(OneDReader const& reader, int threads, vector< Ref<OneDReader> >& copies) {
+  if (threads > 1 && ParallelSearch::isSupported()) {
+    for (int i = 1; i < threads; i++) {
+      Ref<OneDReader> copy(reader.clone());
+      if (!copy) {
+        break;
+      }
+      copies.push_back(copy);
     }
+  }
+}
 
-    // Estimate black point for this row and load it:
-    try {
-      row = image->getBlackRow(rowNumber, row);
-    } catch (NotFoundException const& ignored) {
-      (void)ignored;
-      continue;
+// Decodes the x'th of a series of binarized rows. Each worker has its own
+// reader and row, so workers share nothing but what they only read.
+class RowSearch : public ParallelSearch::Task {
+public:
+  RowSearch(int workers, bool vote)
+    : readers(workers), rows(workers), votes(vote ? 2 * workers : 0),
+      results(workers), resultIndices(workers, -1) {
+  }
+
+  Ref<Result> getResult(int x) const {
+    for (size_t i = 0; i < results.size(); i++) {
+      if (resultIndices[i] == x) {
+        return results[i];
+      }
     }
+    return Ref<Result>();
+  }
+
+  // Moves the result points found along the worker's row, which was
+  // reversed or not, to where they are in the image.
+  virtual void placePoints(int worker, int x, ArrayRef< Ref<ResultPoint> >& points,
+                           bool reversed) = 0;
 
+  vector<OneDReader*> readers;
+  vector< Ref<BitArray> > rows;
+  // For row consensus, what each worker could read of the rows it did not
+  // decode: votes[2 * worker] as read and votes[2 * worker + 1] reversed.
+  vector<RowVotes> votes;
+
+protected:
+  // Looks for a barcode on row, as read and then reversed; row has scale
+  // bits per pixel.
+  bool decode(int worker, int x, int rowNumber, Ref<BitArray> const& row, int scale) {
     // While we have the image data in a BitArray, it's fairly cheap to reverse it in place to
     // handle decoding upside down barcodes.
     for (int attempt = 0; attempt < 2; attempt++) {
@@ -123,32 +177,369 @@ Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
 
       try {
         // Look for a barcode
-        // std::cerr << "rn " << rowNumber << " " << typeid(*this).name() << std::endl;
-        Ref<Result> result = decodeRow(rowNumber, row);
+        Ref<Result> result = readers[worker]->decodeRow(rowNumber, row);
         // We found our barcode
-        if (attempt == 1) {
-          // But it was upside down, so note that
-          // result.putMetadata(ResultMetadataType.ORIENTATION, new Integer(180));
-          // And remember to flip the result points horizontally.
-          ArrayRef< Ref<ResultPoint> > points(result->getResultPoints());
-          if (points) {
-            points[0] = Ref<ResultPoint>(new OneDResultPoint(width - points[0]->getX() - 1,
-                                                             points[0]->getY()));
-            points[1] = Ref<ResultPoint>(new OneDResultPoint(width - points[1]->getX() - 1,
-                                                             points[1]->getY()));
-            
+        ArrayRef< Ref<ResultPoint> > points(result->getResultPoints());
+        if (scale > 1 && points) {
+          for (int i = 0; i < points->size(); i++) {
+            points[i] = Ref<ResultPoint>(new OneDResultPoint((points[i]->getX() + 0.5f) / scale - 0.5f,
+                                                             points[i]->getY()));
           }
         }
-        return result;
+        placePoints(worker, x, points, attempt == 1);
+        results[worker] = result;
+        resultIndices[worker] = x;
+        return true;
       } catch (ReaderException const& re) {
         (void)re;
-        continue;
       }
+      if (!votes.empty() && scale == 1) {
+        readers[worker]->voteRow(rowNumber, row, votes[2 * worker + attempt]);
+      }
+    }
+    return false;
+  }
+
+private:
+  vector< Ref<Result> > results;
+  vector<int> resultIndices;
+};
+
+// Binarizes and decodes the x'th row of the image; then, if edgeRows is
+// set up, decodes it again from its sub-pixel edges.
+class RowScan : public RowSearch {
+public:
+  RowScan(int middle, int rowStep, int width, int workers, bool vote)
+    : RowSearch(workers, vote), images(workers), middle_(middle), rowStep_(rowStep), width_(width) {
+  }
+
+  bool test(int worker, int x) {
+    int rowNumber = scanRowNumber(middle_, rowStep_, x);
+
+    // Estimate black point for this row and load it:
+    bool binarized = true;
+    try {
+      rows[worker] = images[worker]->getBlackRow(rowNumber, rows[worker]);
+    } catch (NotFoundException const& ignored) {
+      (void)ignored;
+      binarized = false;
+    }
+    if (binarized && decode(worker, x, rowNumber, rows[worker], 1)) {
+      return true;
+    }
+    if (edgeRows.empty()) {
+      return false;
+    }
+    luminances[worker] =
+      images[worker]->getLuminanceSource()->getRow(rowNumber, luminances[worker]);
+    edgeRows[worker].find(luminances[worker], width_);
+    edgeRows[worker].render(EDGE_SCALE, *fineRows[worker]);
+    return decode(worker, x, rowNumber, fineRows[worker], EDGE_SCALE);
+  }
+
+  void placePoints(int, int, ArrayRef< Ref<ResultPoint> >& points, bool reversed) {
+    if (reversed && points) {
+      // But it was upside down, so note that
+      // result.putMetadata(ResultMetadataType.ORIENTATION, new Integer(180));
+      // And remember to flip the result points horizontally.
+      points[0] = Ref<ResultPoint>(new OneDResultPoint(width_ - points[0]->getX() - 1,
+                                                       points[0]->getY()));
+      points[1] = Ref<ResultPoint>(new OneDResultPoint(width_ - points[1]->getX() - 1,
+                                                       points[1]->getY()));
+    }
+  }
+
+  vector<BinaryBitmap*> images;
+  vector< ArrayRef<char> > luminances;
+  vector<EdgeRow> edgeRows;
+  vector< Ref<BitArray> > fineRows;
+
+private:
+  int middle_;
+  int rowStep_;
+  int width_;
+};
+
+// A straight line across the image, sampled at every pixel along its major
+// axis: x for lines closer to horizontal, y for the others. The minor
+// coordinate at major coordinate m is intercept + m * slope, in 16.16 fixed
+// point.
+struct ScanLine {
+  bool alongX;
+  int intercept;
+  int slope;
+};
+
+// Adds the lines at the given angle that cross the region, spaced and
+// ordered the way doDecode() picks rows.
+void addScanLines(int degrees, int left, int top, int right, int bottom, bool tryHarder,
+                  vector<ScanLine>& lines) {
+  double dx = cos(degrees * PI / 180);
+  double dy = -sin(degrees * PI / 180);
+  ScanLine line;
+  line.alongX = fabs(dx) >= fabs(dy);
+  double slope = line.alongX ? dy / dx : dx / dy;
+  line.slope = (int) floor(slope * 65536 + 0.5);
+
+  int majorLow = line.alongX ? left : top;
+  int majorHigh = (line.alongX ? right : bottom) - 1;
+  int minorLow = line.alongX ? top : left;
+  int minorHigh = line.alongX ? bottom : right;
+  double lowShift = std::min(slope * majorLow, slope * majorHigh);
+  double highShift = std::max(slope * majorLow, slope * majorHigh);
+  int lowest = (int) floor(minorLow - highShift);
+  int highest = (int) ceil(minorHigh - lowShift);
+
+  int extent = highest - lowest;
+  int middle = lowest + extent / 2;
+  int step = std::max(1, extent >> (tryHarder ? 8 : 5));
+  int maxLines = tryHarder ? extent : 15;
+  for (int i = 0; i < maxLines; i++) {
+    int intercept = scanRowNumber(middle, step, i);
+    if (intercept < lowest || intercept >= highest) {
+      break;
+    }
+    line.intercept = intercept * 65536;
+    lines.push_back(line);
+  }
+}
+
+// Samples the x'th line from the luminances of the region, binarizes it
+// like GlobalHistogramBinarizer does a row and decodes it.
+class LineScan : public RowSearch {
+public:
+  LineScan(vector<ScanLine> const& lines, char const* pixels, int width,
+           int left, int top, int right, int bottom, int workers)
+    : RowSearch(workers, false), luminances(workers), buckets(workers), starts(workers),
+      lines_(lines), pixels_(pixels), width_(width),
+      left_(left), top_(top), right_(right), bottom_(bottom) {
+  }
+
+  bool test(int worker, int x) {
+    ScanLine const& line = lines_[x];
+    int majorLow = line.alongX ? left_ : top_;
+    int majorHigh = line.alongX ? right_ : bottom_;
+    int minorLow = (line.alongX ? top_ : left_) << 16;
+    int minorHigh = (line.alongX ? bottom_ : right_) << 16;
+
+    // Rounded to the nearest pixel; the pixels inside the region are
+    // contiguous along a straight line.
+    char* samples = &luminances[worker][0];
+    int length = 0;
+    int minor = line.intercept + majorLow * line.slope + 0x8000;
+    for (int major = majorLow; major < majorHigh; major++, minor += line.slope) {
+      if (minor >= minorLow && minor < minorHigh) {
+        if (length == 0) {
+          starts[worker] = major;
+        }
+        int m = minor >> 16;
+        samples[length++] = line.alongX ? pixels_[m * width_ + major] : pixels_[major * width_ + m];
+      } else if (length > 0) {
+        break;
+      }
+    }
+    if (length < 3) {
+      return false;
+    }
+
+    Ref<BitArray>& row = rows[worker];
+    if (!row || row->getSize() != length) {
+      row = new BitArray(length);
+    } else {
+      row->clear();
+    }
+    try {
+      GlobalHistogramBinarizer::binarizeRow(luminances[worker], length, buckets[worker], *row);
+    } catch (NotFoundException const& ignored) {
+      (void)ignored;
+      return false;
+    }
+    return decode(worker, x, 0, rows[worker], 1);
+  }
+
+  void placePoints(int worker, int x, ArrayRef< Ref<ResultPoint> >& points, bool reversed) {
+    if (!points) {
+      return;
+    }
+    ScanLine const& line = lines_[x];
+    int length = rows[worker]->getSize();
+    for (int i = 0; i < points->size(); i++) {
+      float along = points[i]->getX();
+      float major = starts[worker] + (reversed ? length - 1 - along : along);
+      float minor = (line.intercept + major * line.slope) / 65536;
+      points[i] = Ref<ResultPoint>(line.alongX ? new OneDResultPoint(major, minor)
+                                               : new OneDResultPoint(minor, major));
+    }
+  }
+
+  vector< ArrayRef<char> > luminances;
+
+private:
+  vector< ArrayRef<int> > buckets;
+  vector<int> starts;
+  vector<ScanLine> const& lines_;
+  char const* pixels_;
+  int width_;
+  int left_;
+  int top_;
+  int right_;
+  int bottom_;
+};
+
+}
+
+Ref<Result> OneDReader::doDecode(Ref<BinaryBitmap> image, DecodeHints hints) {
+  int width = image->getWidth();
+
+  // Only rows inside the region of interest are binarized and scanned;
+  // decodeRow() still sees each of them in full.
+  int left, top, right, bottom;
+  hints.getRegionOfInterest(width, image->getHeight(), left, top, right, bottom);
+  int regionHeight = bottom - top;
+
+  int middle = (top + bottom) >> 1;
+  bool tryHarder = hints.getTryHarder();
+  int rowStep = std::max(1, regionHeight >> (tryHarder ? 8 : 5));
+  int maxLines;
+  if (tryHarder) {
+    maxLines = regionHeight; // Look at the whole image, not just the center
+  } else {
+    maxLines = 15; // 15 rows spaced 1/32 apart is roughly the middle half of the image
+  }
+
+  // If we run off the top or bottom, stop
+  int rowCount = 0;
+  while (rowCount < maxLines) {
+    int rowNumber = scanRowNumber(middle, rowStep, rowCount);
+    if (rowNumber < top || rowNumber >= bottom) {
+      break;
+    }
+    rowCount++;
+  }
+
+  // Rows are independent, so extra threads each get a copy of this reader
+  // and of the bitmap.
+  vector< Ref<OneDReader> > readerCopies;
+  vector< Ref<BinaryBitmap> > imageCopies;
+  int threads = std::min(hints.getThreads(), (rowCount + ROWS_PER_BATCH - 1) / ROWS_PER_BATCH);
+  cloneReaders(*this, threads, readerCopies);
+  for (size_t i = 0; i < readerCopies.size(); i++) {
+    imageCopies.push_back(image->clone());
+  }
+
+  int workers = 1 + (int) readerCopies.size();
+  RowScan scan(middle, rowStep, width, workers, hints.getRowConsensus());
+  scan.readers[0] = this;
+  scan.images[0] = image;
+  for (int i = 1; i < workers; i++) {
+    scan.readers[i] = readerCopies[i - 1];
+    scan.images[i] = imageCopies[i - 1];
+  }
+  for (int i = 0; i < workers; i++) {
+    scan.rows[i] = new BitArray(width);
+  }
+  if (hints.getSubPixelEdges()) {
+    scan.edgeRows.resize(workers);
+    for (int i = 0; i < workers; i++) {
+      scan.luminances.push_back(ArrayRef<char>(width));
+      scan.fineRows.push_back(Ref<BitArray>(new BitArray(width * EDGE_SCALE)));
+    }
+  }
+
+  int x = ParallelSearch::find(scan, rowCount, workers, ROWS_PER_BATCH);
+  if (x >= 0) {
+    return scan.getResult(x);
+  }
+
+  // No row decoded on its own; see whether together they do.
+  for (int attempt = 0; attempt < 2 && !scan.votes.empty(); attempt++) {
+    RowVotes votes;
+    for (int i = 0; i < workers; i++) {
+      votes.merge(scan.votes[2 * i + attempt]);
+    }
+    Ref<Result> result = votes.empty() ? Ref<Result>() : decodeVotes(votes);
+    if (result) {
+      scan.placePoints(0, 0, result->getResultPoints(), attempt == 1);
+      return result;
     }
   }
   throw NotFoundException();
 }
 
+Ref<Result> OneDReader::doDecodeAngled(Ref<BinaryBitmap> image, DecodeHints const& hints) {
+  Ref<LuminanceSource> const& source = image->getLuminanceSource();
+  int width = source->getWidth();
+  int left, top, right, bottom;
+  hints.getRegionOfInterest(width, source->getHeight(), left, top, right, bottom);
+  if (right - left < 3 || bottom - top < 3) {
+    return Ref<Result>();
+  }
+
+  // Interleave the angles so that lines through the middle come first.
+  vector<int> const& angles = hints.getScanAngles();
+  vector< vector<ScanLine> > lineSets(angles.size());
+  size_t mostLines = 0;
+  for (size_t i = 0; i < angles.size(); i++) {
+    addScanLines(angles[i], left, top, right, bottom, hints.getTryHarder(), lineSets[i]);
+    mostLines = std::max(mostLines, lineSets[i].size());
+  }
+  vector<ScanLine> lines;
+  for (size_t i = 0; i < mostLines; i++) {
+    for (size_t j = 0; j < lineSets.size(); j++) {
+      if (i < lineSets[j].size()) {
+        lines.push_back(lineSets[j][i]);
+      }
+    }
+  }
+  int lineCount = (int) lines.size();
+
+  vector< Ref<OneDReader> > readerCopies;
+  int threads = std::min(hints.getThreads(), (lineCount + ROWS_PER_BATCH - 1) / ROWS_PER_BATCH);
+  cloneReaders(*this, threads, readerCopies);
+
+  ArrayRef<char> pixels = source->getMatrix();
+  int workers = 1 + (int) readerCopies.size();
+  LineScan scan(lines, &pixels[0], width, left, top, right, bottom, workers);
+  scan.readers[0] = this;
+  for (int i = 1; i < workers; i++) {
+    scan.readers[i] = readerCopies[i - 1];
+  }
+  for (int i = 0; i < workers; i++) {
+    scan.luminances[i] = ArrayRef<char>(std::max(right - left, bottom - top));
+  }
+
+  int x = ParallelSearch::find(scan, lineCount, workers, ROWS_PER_BATCH);
+  return x < 0 ? Ref<Result>() : scan.getResult(x);
+}
+
+Ref<OneDReader> OneDReader::clone() const {
+  return Ref<OneDReader>();
+}
+
+Ref<Reader> OneDReader::cloneReader() const {
+  return clone();
+}
+
+void OneDReader::voteRow(int, Ref<BitArray> const&, RowVotes&) {
+}
+
+Ref<Result> OneDReader::decodeVotes(RowVotes const&) {
+  return Ref<Result>();
+}
+
+int OneDReader::findEdge(Ref<BitArray> const& row, float position, int range, bool toBlack) {
+  int center = (int) (position + 0.5f);
+  int width = row->getSize();
+  for (int distance = 0; distance <= range; distance++) {
+    for (int x = center - distance; x <= center + distance; x += std::max(1, 2 * distance)) {
+      if (x > 0 && x < width && row->get(x) == toBlack && row->get(x - 1) != toBlack) {
+        return x;
+      }
+    }
+  }
+  return -1;
+}
+
 int OneDReader::patternMatchVariance(vector<int>& counters,
                                      vector<int> const& pattern,
                                      int maxIndividualVariance) {
@@ -189,7 +580,7 @@ int OneDReader::patternMatchVariance(vector<int>& counters,
   return totalVariance / total;
 }
 
-void OneDReader::recordPattern(Ref<BitArray> row,
+void OneDReader::recordPattern(Ref<BitArray> const& row,
                                int start,
                                vector<int>& counters) {
   int numCounters = (int) counters.size();
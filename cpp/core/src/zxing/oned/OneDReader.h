@@ -22,6 +22,7 @@
  */
 
 #include <zxing/Reader.h>
+#include <zxing/oned/RowVotes.h>
 
 namespace zxing {
 namespace oned {
@@ -29,6 +30,9 @@ namespace oned {
 class OneDReader : public Reader {
 private:
   Ref<Result> doDecode(Ref<BinaryBitmap> image, DecodeHints hints);
+  // Scans lines at the angles in hints instead of rows; returns an empty
+  // Ref if none of them decodes.
+  Ref<Result> doDecodeAngled(Ref<BinaryBitmap> image, DecodeHints const& hints);
 
 protected:
   static const int INTEGER_MATH_SHIFT = 8;
@@ -57,6 +61,10 @@ protected:
                                   int const pattern[],
                                   int maxIndividualVariance);
 
+  // Returns the offset within range pixels of position, nearest to it, at
+  // which the row turns black (or white, if toBlack is false), or -1.
+  static int findEdge(Ref<BitArray> const& row, float position, int range, bool toBlack);
+
 protected:
   static const int PATTERN_MATCH_RESULT_SCALE_FACTOR = 1 << INTEGER_MATH_SHIFT;
 
@@ -67,9 +75,25 @@ public:
 
   // Implementations must not throw any exceptions. If a barcode is not found on this row,
   // a empty ref should be returned e.g. return Ref<Result>();
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row) = 0;
+  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row) = 0;
+
+  // Returns a new reader configured like this one that shares no state with
+  // it, so that rows can be decoded on several threads at once (see
+  // DecodeHints::setThreads). Readers that return an empty Ref, as this
+  // default does, only scan rows on the calling thread.
+  virtual Ref<OneDReader> clone() const;
+  // Returns clone().
+  Ref<Reader> cloneReader() const;
+
+  // Row consensus (see DecodeHints::setRowConsensus): adds to votes what
+  // can be read of a barcode on a row that decodeRow() could not decode.
+  // Readers that do not take part, as by default, add nothing.
+  virtual void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+
+  // Decodes a barcode from the votes of many rows, or returns an empty Ref.
+  virtual Ref<Result> decodeVotes(RowVotes const& votes);
 
-  static void recordPattern(Ref<BitArray> row,
+  static void recordPattern(Ref<BitArray> const& row,
                             int start,
                             std::vector<int>& counters);
   virtual ~OneDReader();
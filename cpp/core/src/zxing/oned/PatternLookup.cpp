@@ -0,0 +1,93 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/PatternLookup.h>
+#include <zxing/common/IllegalArgumentException.h>
+
+using std::vector;
+using zxing::oned::PatternLookup;
+
+namespace {
+
+const int MAX_MODULES = 4;
+// Widths are rounded in eighths of a module; one within an eighth of
+// halfway could round either way once the bars blur, so it is not looked up.
+const int FRACTION_BITS = 3;
+
+}
+
+PatternLookup::PatternLookup(int const* patterns, int count, int elements)
+  : elements_(elements), modules_(0), indices_(1 << (2 * elements), -1) {
+  for (int j = 0; j < elements; j++) {
+    modules_ += patterns[j];
+  }
+  for (int i = 0; i < count; i++) {
+    int key = 0;
+    int modules = 0;
+    for (int j = 0; j < elements; j++) {
+      int width = patterns[i * elements + j];
+      if (width < 1 || width > MAX_MODULES) {
+        throw IllegalArgumentException("pattern element out of range");
+      }
+      key = (key << 2) | (width - 1);
+      modules += width;
+    }
+    if (modules != modules_) {
+      throw IllegalArgumentException("patterns differ in length");
+    }
+    if (indices_[key] < 0) {
+      indices_[key] = (signed char) i;
+    }
+  }
+}
+
+int PatternLookup::lookup(vector<int> const& counters) const {
+  if ((int) counters.size() != elements_) {
+    return -1;
+  }
+  int total = 0;
+  for (int j = 0; j < elements_; j++) {
+    total += counters[j];
+  }
+  if (total < modules_) {
+    // Less than a pixel per module, like OneDReader::patternMatchVariance().
+    return -1;
+  }
+  int const half = 1 << (FRACTION_BITS - 1);
+  int key = 0;
+  for (int j = 0; j < elements_; j++) {
+    int scaled = (counters[j] * modules_ << FRACTION_BITS) / total;
+    int fraction = scaled & ((1 << FRACTION_BITS) - 1);
+    if (fraction == half || fraction == half - 1) {
+      return -1;
+    }
+    int width = (scaled + half) >> FRACTION_BITS;
+    if (width < 1 || width > MAX_MODULES) {
+      return -1;
+    }
+    key = (key << 2) | (width - 1);
+  }
+  return indices_[key];
+}
+
+vector<signed char> PatternLookup::invert(int const* encodings, int count, int bits) {
+  vector<signed char> indices(1 << bits, -1);
+  for (int i = 0; i < count; i++) {
+    indices[encodings[i]] = (signed char) i;
+  }
+  return indices;
+}
@@ -0,0 +1,54 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __PATTERN_LOOKUP_H__
+#define __PATTERN_LOOKUP_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <vector>
+
+namespace zxing {
+namespace oned {
+
+// Finds the character a run of element widths encodes in one step: the
+// widths are rounded to whole modules and the result indexes a table of
+// every combination of up to 4 modules per element. Readers only need to
+// match every pattern in turn when the widths round to no character, or
+// fall too close to halfway between two module counts to round safely.
+class PatternLookup {
+public:
+  // Indexes count patterns of elements widths each, patterns[i * elements
+  // + j] being element j of pattern i. Each width is 1 to 4 modules and all
+  // patterns add up to the same number of modules.
+  PatternLookup(int const* patterns, int count, int elements);
+
+  // The index of the pattern counters round to, or -1.
+  int lookup(std::vector<int> const& counters) const;
+
+  // Maps each of count encodings below 1 << bits, such as the wide/narrow
+  // bit patterns of Code 39, to its index, and other values to -1.
+  static std::vector<signed char> invert(int const* encodings, int count, int bits);
+
+private:
+  int elements_;
+  int modules_;
+  std::vector<signed char> indices_;
+};
+
+}
+}
+
+#endif // __PATTERN_LOOKUP_H__
@@ -0,0 +1,170 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/oned/RowVotes.h>
+#include <zxing/oned/OneDResultPoint.h>
+#include <algorithm>
+#include <utility>
+
+using std::map;
+using std::pair;
+using std::vector;
+using zxing::Ref;
+using zxing::ArrayRef;
+using zxing::ResultPoint;
+using zxing::oned::RowVotes;
+using zxing::oned::OneDResultPoint;
+
+namespace {
+
+bool moreRows(pair<int, int> const& a, pair<int, int> const& b) {
+  return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+}
+
+int RowVotes::layout(BarcodeFormat format, int positions) {
+  return (format.value << 16) | positions;
+}
+
+void RowVotes::addRow(int layout, int positions, int rowNumber, float left, float right) {
+  Ballot& ballot = ballots[layout];
+  if (ballot.weights.empty()) {
+    ballot.weights.resize(positions);
+  }
+  ballot.rows++;
+  ballot.rowNumbers += rowNumber;
+  ballot.left += left;
+  ballot.right += right;
+}
+
+void RowVotes::add(int layout, int position, int value, int weight) {
+  map<int, Ballot>::iterator found = ballots.find(layout);
+  if (found != ballots.end() && position >= 0 && position < (int) found->second.weights.size()) {
+    found->second.weights[position][value] += weight;
+  }
+}
+
+void RowVotes::merge(RowVotes const& other) {
+  for (map<int, Ballot>::const_iterator i = other.ballots.begin(); i != other.ballots.end(); ++i) {
+    Ballot const& from = i->second;
+    Ballot& to = ballots[i->first];
+    if (to.weights.empty()) {
+      to.weights.resize(from.weights.size());
+    }
+    to.rows += from.rows;
+    to.rowNumbers += from.rowNumbers;
+    to.left += from.left;
+    to.right += from.right;
+    for (size_t position = 0; position < from.weights.size(); position++) {
+      map<int, int> const& weights = from.weights[position];
+      for (map<int, int>::const_iterator j = weights.begin(); j != weights.end(); ++j) {
+        to.weights[position][j->first] += j->second;
+      }
+    }
+  }
+}
+
+vector<int> RowVotes::getLayouts(BarcodeFormat format) const {
+  vector< pair<int, int> > counts;
+  for (map<int, Ballot>::const_iterator i = ballots.begin(); i != ballots.end(); ++i) {
+    if ((i->first >> 16) != format.value) {
+      continue;
+    }
+    counts.push_back(pair<int, int>(i->second.rows, i->first));
+  }
+  std::sort(counts.begin(), counts.end(), moreRows);
+  vector<int> layouts;
+  for (size_t i = 0; i < counts.size(); i++) {
+    layouts.push_back(counts[i].second);
+  }
+  return layouts;
+}
+
+int RowVotes::getRowCount(int layout) const {
+  map<int, Ballot>::const_iterator found = ballots.find(layout);
+  return found == ballots.end() ? 0 : found->second.rows;
+}
+
+bool RowVotes::elect(int layout, Check& check, vector<int>& values) const {
+  map<int, Ballot>::const_iterator found = ballots.find(layout);
+  if (found == ballots.end() || found->second.rows < 2) {
+    return false;
+  }
+  vector< map<int, int> > const& weights = found->second.weights;
+  int positions = (int) weights.size();
+  values.assign(positions, -1);
+  vector<int> winnerWeights(positions, 0);
+  vector<int> runnersUp(positions, -1);
+  vector<int> runnerUpWeights(positions, 0);
+  for (int position = 0; position < positions; position++) {
+    if (weights[position].empty()) {
+      return false;
+    }
+    for (map<int, int>::const_iterator i = weights[position].begin();
+         i != weights[position].end(); ++i) {
+      if (i->second > winnerWeights[position]) {
+        runnersUp[position] = values[position];
+        runnerUpWeights[position] = winnerWeights[position];
+        values[position] = i->first;
+        winnerWeights[position] = i->second;
+      } else if (i->second > runnerUpWeights[position]) {
+        runnersUp[position] = i->first;
+        runnerUpWeights[position] = i->second;
+      }
+    }
+  }
+  if (check.accept(values)) {
+    return true;
+  }
+
+  // Only a runner-up with at least a third of the winner's weight may stand
+  // in for it, so that the check is not simply tried until it passes.
+  int bestPosition = -1;
+  int bestWeight = 0;
+  for (int position = 0; position < positions; position++) {
+    if (runnerUpWeights[position] * 3 < winnerWeights[position] ||
+        runnerUpWeights[position] <= bestWeight) {
+      continue;
+    }
+    int winner = values[position];
+    values[position] = runnersUp[position];
+    if (check.accept(values)) {
+      bestPosition = position;
+      bestWeight = runnerUpWeights[position];
+    }
+    values[position] = winner;
+  }
+  if (bestPosition < 0) {
+    return false;
+  }
+  values[bestPosition] = runnersUp[bestPosition];
+  return check.accept(values);
+}
+
+ArrayRef< Ref<ResultPoint> > RowVotes::getResultPoints(int layout) const {
+  map<int, Ballot>::const_iterator found = ballots.find(layout);
+  if (found == ballots.end() || found->second.rows == 0) {
+    return ArrayRef< Ref<ResultPoint> >();
+  }
+  Ballot const& ballot = found->second;
+  float y = (float) ballot.rowNumbers / ballot.rows;
+  ArrayRef< Ref<ResultPoint> > points(2);
+  points[0] = Ref<ResultPoint>(new OneDResultPoint((float) (ballot.left / ballot.rows), y));
+  points[1] = Ref<ResultPoint>(new OneDResultPoint((float) (ballot.right / ballot.rows), y));
+  return points;
+}
@@ -0,0 +1,89 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ROW_VOTES_H__
+#define __ROW_VOTES_H__
+
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zxing/BarcodeFormat.h>
+#include <zxing/ResultPoint.h>
+#include <zxing/common/Array.h>
+#include <map>
+#include <vector>
+
+namespace zxing {
+namespace oned {
+
+// Collects, over the rows of an image that did not decode on their own,
+// what each row could read of a barcode: the value at every position it
+// could make out, weighted by how closely the bars matched. Electing the
+// best value at each position then reads a barcode that no single row holds
+// in full, e.g. one crossed by a highlight.
+//
+// Readings are grouped by layout, a format and a symbol count, since rows
+// only agree on positions if they agree on how many symbols there are.
+class RowVotes {
+public:
+  class Check {
+  public:
+    virtual ~Check() {}
+    // Whether the values read at all positions form a valid barcode.
+    virtual bool accept(std::vector<int> const& values) = 0;
+  };
+
+  static int layout(BarcodeFormat format, int positions);
+
+  // Notes that a row found the barcode between left and right.
+  void addRow(int layout, int positions, int rowNumber, float left, float right);
+  // Adds one row's reading of value at position, which weighs more the
+  // closer the match; weight must be positive.
+  void add(int layout, int position, int value, int weight);
+  void merge(RowVotes const& other);
+  bool empty() const {return ballots.empty();}
+
+  // Layouts of format in order of the number of rows that found them, most
+  // first.
+  std::vector<int> getLayouts(BarcodeFormat format) const;
+  int getRowCount(int layout) const;
+
+  // Fills values with the value that has the most weight at each position
+  // of layout. If check rejects them, tries each close runner-up in place
+  // of the winner at one position. Returns false if fewer than two rows
+  // found the layout, a position has no votes or nothing passes the check;
+  // after true, check last accepted values.
+  bool elect(int layout, Check& check, std::vector<int>& values) const;
+
+  // The two ends of the barcode, averaged over the rows that found it.
+  ArrayRef< Ref<ResultPoint> > getResultPoints(int layout) const;
+
+private:
+  struct Ballot {
+    Ballot() : rows(0), rowNumbers(0), left(0), right(0) {}
+    int rows;
+    long rowNumbers;
+    double left;
+    double right;
+    // Weight of each value read, by position.
+    std::vector< std::map<int, int> > weights;
+  };
+
+  std::map<int, Ballot> ballots;
+};
+
+}
+}
+
+#endif // __ROW_VOTES_H__
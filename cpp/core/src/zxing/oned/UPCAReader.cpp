@@ -22,6 +22,7 @@
 #include <zxing/ReaderException.h>
 
 using zxing::oned::UPCAReader;
+using zxing::oned::RowVotes;
 using zxing::Ref;
 using zxing::Result;
 
@@ -32,12 +33,16 @@ using zxing::DecodeHints;
 
 UPCAReader::UPCAReader() : ean13Reader() {}
 
-Ref<Result> UPCAReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<zxing::oned::OneDReader> UPCAReader::clone() const {
+  return Ref<OneDReader>(new UPCAReader());
+}
+
+Ref<Result> UPCAReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   return maybeReturnResult(ean13Reader.decodeRow(rowNumber, row));
 }
 
 Ref<Result> UPCAReader::decodeRow(int rowNumber,
-                                  Ref<BitArray> row,
+                                  Ref<BitArray> const& row,
                                   Range const& startGuardRange) {
   return maybeReturnResult(ean13Reader.decodeRow(rowNumber, row, startGuardRange));
 }
@@ -46,7 +51,15 @@ Ref<Result> UPCAReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
   return maybeReturnResult(ean13Reader.decode(image, hints));
 }
 
-int UPCAReader::decodeMiddle(Ref<BitArray> row,
+void UPCAReader::voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes) {
+  ean13Reader.voteRow(rowNumber, row, votes);
+}
+
+Ref<Result> UPCAReader::decodeVotes(RowVotes const& votes) {
+  return maybeReturnResult(ean13Reader.decodeVotes(votes));
+}
+
+int UPCAReader::decodeMiddle(Ref<BitArray> const& row,
                              Range const& startRange,
                              std::string& resultString) {
   return ean13Reader.decodeMiddle(row, startRange, resultString);
@@ -34,13 +34,17 @@ private:
 
 public:
   UPCAReader();
+  Ref<OneDReader> clone() const;
 
-  int decodeMiddle(Ref<BitArray> row, Range const& startRange, std::string& resultString);
+  int decodeMiddle(Ref<BitArray> const& row, Range const& startRange, std::string& resultString);
 
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
-  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, Range const& startGuardRange);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
+  Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, Range const& startGuardRange);
   Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
 
+  void voteRow(int rowNumber, Ref<BitArray> const& row, RowVotes& votes);
+  Ref<Result> decodeVotes(RowVotes const& votes);
+
   BarcodeFormat getBarcodeFormat();
 };
 
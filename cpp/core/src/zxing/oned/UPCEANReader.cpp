@@ -21,9 +21,11 @@
 #include <zxing/ZXing.h>
 #include <zxing/oned/UPCEANReader.h>
 #include <zxing/oned/OneDResultPoint.h>
+#include <zxing/oned/PatternLookup.h>
 #include <zxing/ReaderException.h>
 #include <zxing/NotFoundException.h>
 #include <zxing/ChecksumException.h>
+#include <algorithm>
 
 using std::vector;
 using std::string;
@@ -33,6 +35,8 @@ using zxing::Result;
 using zxing::NotFoundException;
 using zxing::ChecksumException;
 using zxing::oned::UPCEANReader;
+using zxing::oned::PatternLookup;
+using zxing::oned::RowVotes;
 
 // VC++
 using zxing::BitArray;
@@ -97,6 +101,11 @@ namespace {
     {2, 1, 1, 3}  // 19 reversed 9
   };
 //  const int L_AND_G_PATTERNS_LEN = LEN(L_AND_G_PATTERNS_);
+
+  PatternLookup const& digitLookup() {
+    static const PatternLookup lookup(L_AND_G_PATTERNS_[0], LEN(L_AND_G_PATTERNS_), 4);
+    return lookup;
+  }
 }
 
 const int UPCEANReader::MAX_AVG_VARIANCE = (int)(PATTERN_MATCH_RESULT_SCALE_FACTOR * 0.48f);
@@ -116,12 +125,12 @@ UPCEANReader::L_AND_G_PATTERNS (VECTOR_INIT(L_AND_G_PATTERNS_));
 
 UPCEANReader::UPCEANReader() {}
 
-Ref<Result> UPCEANReader::decodeRow(int rowNumber, Ref<BitArray> row) {
+Ref<Result> UPCEANReader::decodeRow(int rowNumber, Ref<BitArray> const& row) {
   return decodeRow(rowNumber, row, findStartGuardPattern(row));
 }
 
 Ref<Result> UPCEANReader::decodeRow(int rowNumber,
-                                    Ref<BitArray> row,
+                                    Ref<BitArray> const& row,
                                     Range const& startGuardRange) {
   string& result = decodeRowStringBuffer;
   result.clear();
@@ -154,7 +163,7 @@ Ref<Result> UPCEANReader::decodeRow(int rowNumber,
   return decodeResult;
 }
 
-UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> row) {
+UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> const& row) {
   bool foundStart = false;
   Range startRange;
   int nextStart = 0;
@@ -179,7 +188,7 @@ UPCEANReader::Range UPCEANReader::findStartGuardPattern(Ref<BitArray> row) {
   return startRange;
 }
 
-UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
+UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> const& row,
                                                    int rowOffset,
                                                    bool whiteFirst,
                                                    vector<int> const& pattern) {
@@ -187,7 +196,7 @@ UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
   return findGuardPattern(row, rowOffset, whiteFirst, pattern, counters);
 }
 
-UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
+UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> const& row,
                                                    int rowOffset,
                                                    bool whiteFirst,
                                                    vector<int> const& pattern,
@@ -231,16 +240,39 @@ UPCEANReader::Range UPCEANReader::findGuardPattern(Ref<BitArray> row,
   throw NotFoundException();
 }
 
-UPCEANReader::Range UPCEANReader::decodeEnd(Ref<BitArray> row, int endStart) {
+UPCEANReader::Range UPCEANReader::decodeEnd(Ref<BitArray> const& row, int endStart) {
   return findGuardPattern(row, endStart, false, START_END_PATTERN);
 }
 
-int UPCEANReader::decodeDigit(Ref<BitArray> row,
+int UPCEANReader::decodeDigit(Ref<BitArray> const& row,
                               vector<int> & counters,
                               int rowOffset,
                               vector<int const*> const& patterns) {
   recordPattern(row, rowOffset, counters);
-  int bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
+  int variance;
+  int bestMatch = matchDigit(counters, patterns, variance);
+  if (bestMatch >= 0) {
+    return bestMatch;
+  } else {
+    throw NotFoundException();
+  }
+}
+
+int UPCEANReader::matchDigit(vector<int>& counters,
+                             vector<int const*> const& patterns,
+                             int& bestVariance) {
+  // Counters that round to a digit match it better than any other digit, so
+  // the loop below is only needed when they don't. The lookup covers
+  // L_AND_G_PATTERNS, which L_PATTERNS starts; other digits are left to it.
+  int digit = digitLookup().lookup(counters);
+  if (digit >= 0 && digit < (int) patterns.size() &&
+      std::equal(patterns[digit], patterns[digit] + 4, L_AND_G_PATTERNS_[digit])) {
+    bestVariance = patternMatchVariance(counters, patterns[digit], MAX_INDIVIDUAL_VARIANCE);
+    if (bestVariance < MAX_AVG_VARIANCE) {
+      return digit;
+    }
+  }
+  bestVariance = MAX_AVG_VARIANCE; // worst variance we'll accept
   int bestMatch = -1;
   int max = (int) patterns.size();
   for (int i = 0; i < max; i++) {
@@ -251,10 +283,123 @@ int UPCEANReader::decodeDigit(Ref<BitArray> row,
       bestMatch = i;
     }
   }
-  if (bestMatch >= 0) {
-    return bestMatch;
-  } else {
-    throw NotFoundException();
+  return bestMatch;
+}
+
+void UPCEANReader::voteDigits(int rowNumber, Ref<BitArray> const& row, RowVotes& votes,
+                              int digits, vector<int const*> const& leftPatterns) {
+  // Start and end guards of 3 modules, a middle guard of 5 and digits of 7.
+  int modules = 11 + 14 * digits;
+  Range startRange;
+  Range endRange;
+  try {
+    startRange = findStartGuardPattern(row);
+  } catch (NotFoundException const& nfe) {
+    (void)nfe;
+    return;
+  }
+  // The end guard is the one with a quiet zone after it at the distance
+  // closest to what the start guard's module size suggests.
+  int start = startRange[0];
+  float guess = (startRange[1] - start) / 3.0f;
+  float bestError = guess / 4;
+  bool found = false;
+  int endStart = startRange[1] + (int) (guess * (modules - 6) * 3 / 4);
+  try {
+    for (;;) {
+      Range range = findGuardPattern(row, endStart, false, START_END_PATTERN);
+      int end = range[1];
+      int quietEnd = end + (end - range[0]);
+      float error = (end - start) / (float) modules - guess;
+      if (error > bestError) {
+        break;
+      }
+      if (fabs(error) < bestError && quietEnd < row->getSize() &&
+          row->isRange(end, quietEnd, false)) {
+        endRange = range;
+        found = true;
+        bestError = (float) fabs(error);
+      }
+      endStart = row->getNextUnset(range[0]);
+    }
+  } catch (NotFoundException const& nfe) {
+    (void)nfe;
+  }
+  if (!found) {
+    return;
+  }
+
+  int layout = RowVotes::layout(getBarcodeFormat(), 2 * digits);
+  votes.addRow(layout, 2 * digits, rowNumber,
+               (startRange[0] + startRange[1]) / 2.0f, (endRange[0] + endRange[1]) / 2.0f);
+  float moduleSize = (endRange[1] - startRange[0]) / (float) modules;
+  vector<int> counters(4, 0);
+  for (int position = 0; position < 2 * digits; position++) {
+    // Digits left of the middle guard start with a space, those right of it
+    // with a bar.
+    bool left = position < digits;
+    int offset = left ? 3 + 7 * position : 8 + 7 * position;
+    int x = findEdge(row, startRange[0] + offset * moduleSize, std::max(1, (int) moduleSize), !left);
+    if (x < 0) {
+      continue;
+    }
+    try {
+      recordPattern(row, x, counters);
+    } catch (NotFoundException const& nfe) {
+      (void)nfe;
+      continue;
+    }
+    int total = counters[0] + counters[1] + counters[2] + counters[3];
+    if (total < 5 * moduleSize || total > 9 * moduleSize) {
+      continue;
+    }
+    int variance;
+    int digit = matchDigit(counters, left ? leftPatterns : L_PATTERNS, variance);
+    if (digit >= 0) {
+      votes.add(layout, position, digit, MAX_AVG_VARIANCE - variance);
+    }
+  }
+}
+
+namespace {
+
+class DigitCheck : public zxing::oned::RowVotes::Check {
+public:
+  DigitCheck(UPCEANReader& reader) : reader_(reader) {}
+
+  bool accept(vector<int> const& digits) {
+    text.clear();
+    try {
+      reader_.appendVotedText(digits, text);
+    } catch (zxing::ReaderException const& re) {
+      (void)re;
+      return false;
+    }
+    return reader_.checkChecksum(Ref<String>(new String(text)));
+  }
+
+  string text;
+
+private:
+  UPCEANReader& reader_;
+};
+
+}
+
+Ref<Result> UPCEANReader::decodeDigitVotes(RowVotes const& votes, int digits) {
+  int layout = RowVotes::layout(getBarcodeFormat(), digits);
+  DigitCheck check(*this);
+  vector<int> values;
+  if (!votes.elect(layout, check, values)) {
+    return Ref<Result>();
+  }
+  return Ref<Result>(new Result(String::adopt(check.text), ArrayRef<char>(),
+                                votes.getResultPoints(layout), getBarcodeFormat()));
+}
+
+void UPCEANReader::appendVotedText(vector<int> const& digits, string& text) {
+  for (size_t i = 0; i < digits.size(); i++) {
+    text.append(1, (char) ('0' + digits[i]));
   }
 }
 
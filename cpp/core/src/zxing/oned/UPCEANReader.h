@@ -34,13 +34,13 @@ class UPCEANReader : public OneDReader {
   static const int MAX_AVG_VARIANCE;
   static const int MAX_INDIVIDUAL_VARIANCE;
 
-  static Range findStartGuardPattern(Ref<BitArray> row);
+  static Range findStartGuardPattern(Ref<BitArray> const& row);
 
-  virtual Range decodeEnd(Ref<BitArray> row, int endStart);
+  virtual Range decodeEnd(Ref<BitArray> const& row, int endStart);
 
   static bool checkStandardUPCEANChecksum(Ref<String> const& s);
 
-  static Range findGuardPattern(Ref<BitArray> row,
+  static Range findGuardPattern(Ref<BitArray> const& row,
                                 int rowOffset,
                                 bool whiteFirst,
                                 std::vector<int> const& pattern,
@@ -54,25 +54,42 @@ protected:
   static const std::vector<int const*> L_PATTERNS;
   static const std::vector<int const*> L_AND_G_PATTERNS;
 
-  static Range findGuardPattern(Ref<BitArray> row,
+  static Range findGuardPattern(Ref<BitArray> const& row,
                                 int rowOffset,
                                 bool whiteFirst,
                                 std::vector<int> const& pattern);
 
+  // Row consensus for barcodes with digits digits either side of the
+  // middle guard: reads each digit where the start and end guards say it
+  // is, so that a digit that cannot be read does not stop the others.
+  void voteDigits(int rowNumber, Ref<BitArray> const& row, RowVotes& votes,
+                  int digits, std::vector<int const*> const& leftPatterns);
+  Ref<Result> decodeDigitVotes(RowVotes const& votes, int digits);
+
 public:
   UPCEANReader();
 
-  virtual int decodeMiddle(Ref<BitArray> row,
+  virtual int decodeMiddle(Ref<BitArray> const& row,
                            Range const& startRange,
                            std::string& resultString) = 0;
 
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row);
-  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> row, Range const& range);
+  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row);
+  virtual Ref<Result> decodeRow(int rowNumber, Ref<BitArray> const& row, Range const& range);
 
-  static int decodeDigit(Ref<BitArray> row,
+  static int decodeDigit(Ref<BitArray> const& row,
                          std::vector<int>& counters,
                          int rowOffset,
                          std::vector<int const*> const& patterns);
+  // Returns the index of the pattern that counters match best and sets
+  // variance to how well, or returns -1 if none matches well enough.
+  static int matchDigit(std::vector<int>& counters,
+                        std::vector<int const*> const& patterns,
+                        int& variance);
+
+  // Appends the text of the barcode whose digits, indexes into the
+  // patterns as decodeDigit() returns them, were voted for; throws a
+  // ReaderException if they do not make a barcode.
+  virtual void appendVotedText(std::vector<int> const& digits, std::string& text);
 
   virtual bool checkChecksum(Ref<String> const& s);
 
@@ -53,7 +53,11 @@ namespace {
 UPCEReader::UPCEReader() {
 }
 
-int UPCEReader::decodeMiddle(Ref<BitArray> row, Range const& startRange, string& result) {
+Ref<zxing::oned::OneDReader> UPCEReader::clone() const {
+  return Ref<OneDReader>(new UPCEReader());
+}
+
+int UPCEReader::decodeMiddle(Ref<BitArray> const& row, Range const& startRange, string& result) {
   vector<int>& counters (decodeMiddleCounters);
   counters.clear();
   counters.resize(4);
@@ -78,7 +82,7 @@ int UPCEReader::decodeMiddle(Ref<BitArray> row, Range const& startRange, string&
   return rowOffset;
 }
 
-UPCEReader::Range UPCEReader::decodeEnd(Ref<BitArray> row, int endStart) {
+UPCEReader::Range UPCEReader::decodeEnd(Ref<BitArray> const& row, int endStart) {
   return findGuardPattern(row, endStart, true, MIDDLE_END_PATTERN);
 }
 
@@ -137,7 +141,7 @@ Ref<String> UPCEReader::convertUPCEtoUPCA(Ref<String> const& upce_) {
     break;
   }
   result.append(1, upce[7]);
-  return Ref<String>(new String(result));
+  return String::adopt(result);
 }
 
 
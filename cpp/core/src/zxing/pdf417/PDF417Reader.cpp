@@ -28,40 +28,56 @@ using zxing::pdf417::detector::Detector;
 using zxing::ArrayRef;
 using zxing::BinaryBitmap;
 using zxing::DecodeHints;
+using zxing::Reader;
+using zxing::ReaderException;
 
 Ref<Result> PDF417Reader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
   Ref<DecoderResult> decoderResult;
-  /* 2012-05-30 hfn C++ DecodeHintType does not yet know a type "PURE_BARCODE", */
-  /* therefore skip this for now, todo: may be add this type later */
-  /*
-    if (!hints.isEmpty() && hints.containsKey(DecodeHintType.PURE_BARCODE)) {
-    BitMatrix bits = extractPureBits(image.getBlackMatrix());
-    decoderResult = decoder.decode(bits);
-    points = NO_POINTS;
-    } else {
-  */
-  Detector detector(image);
-  Ref<DetectorResult> detectorResult = detector.detect(hints); /* 2012-09-17 hints ("try_harder") */
-  ArrayRef< Ref<ResultPoint> > points(detectorResult->getPoints());
-  
-  if (!hints.isEmpty()) {
-    Ref<ResultPointCallback> rpcb = hints.getResultPointCallback();
-    /* .get(DecodeHintType.NEED_RESULT_POINT_CALLBACK); */
-    if (rpcb != NULL) {
-      for (int i = 0; i < points->size(); i++) {
-        rpcb->foundPossibleResultPoint(*points[i]);
+  ArrayRef< Ref<ResultPoint> > points;
+  if (hints.getPureBarcode()) {
+    Ref<BitMatrix> bits(extractPureBits(image->getBlackMatrix()));
+    decoderResult = decoder.decode(bits, hints);
+    points = new Array< Ref<ResultPoint> >();
+  } else {
+    Detector detector(image);
+    Ref<DetectorResult> detectorResult;
+    int scale = 1;
+    Ref<BinaryBitmap> coarse;
+    if (hints.getCoarseDetection()) {
+      coarse = image->getCoarseLevel(scale);
+    }
+    if (scale > 1) {
+      try {
+        detectorResult = detector.detect(hints, coarse, scale);
+      } catch (ReaderException const&) {
+        // Perhaps the modules are too small to find scaled down.
       }
     }
-  }
-  decoderResult = decoder.decode(detectorResult->getBits(),hints);
-  /*
+    if (!detectorResult) {
+      detectorResult = detector.detect(hints); /* 2012-09-17 hints ("try_harder") */
+    }
+    points = detectorResult->getPoints();
+
+    if (!hints.isEmpty()) {
+      Ref<ResultPointCallback> rpcb = hints.getResultPointCallback();
+      /* .get(DecodeHintType.NEED_RESULT_POINT_CALLBACK); */
+      if (rpcb != NULL) {
+        for (int i = 0; i < points->size(); i++) {
+          rpcb->foundPossibleResultPoint(*points[i]);
+        }
+      }
     }
-  */
+    decoderResult = decoder.decode(detectorResult->getBits(),hints);
+  }
   Ref<Result> r(new Result(decoderResult->getText(), decoderResult->getRawBytes(), points,
                            BarcodeFormat::PDF_417));
   return r;
 }
 
+Ref<Reader> PDF417Reader::cloneReader() const {
+  return Ref<Reader>(new PDF417Reader());
+}
+
 void PDF417Reader::reset() {
   // do nothing
 }
@@ -69,10 +85,9 @@ void PDF417Reader::reset() {
 Ref<BitMatrix> PDF417Reader::extractPureBits(Ref<BitMatrix> image) {
   ArrayRef<int> leftTopBlack = image->getTopLeftOnBit();
   ArrayRef<int> rightBottomBlack = image->getBottomRightOnBit();
-  /* see BitMatrix::getTopLeftOnBit etc.:
-     if (leftTopBlack == null || rightBottomBlack == null) {
-     throw NotFoundException.getNotFoundInstance();
-     } */
+  if (!leftTopBlack || !rightBottomBlack) {
+    throw NotFoundException("PDF417Reader::extractPureBits: no black pixels!");
+  }
   
   int nModuleSize = moduleSize(leftTopBlack, image);
   
@@ -40,6 +40,7 @@ class PDF417Reader : public Reader {
 
  public:
   Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Reader> cloneReader() const;
   void reset();
 };
 
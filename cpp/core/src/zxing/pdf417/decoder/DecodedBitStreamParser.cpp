@@ -16,10 +16,10 @@
  */
 
 #include <stdint.h>
-#include <bigint/BigIntegerUtils.hh>
 #include <zxing/FormatException.h>
 #include <zxing/pdf417/decoder/DecodedBitStreamParser.h>
 #include <zxing/common/DecoderResult.h>
+#include <zxing/common/StringUtils.h>
 
 using std::string;
 using zxing::pdf417::DecodedBitStreamParser;
@@ -27,6 +27,7 @@ using zxing::ArrayRef;
 using zxing::Ref;
 using zxing::DecoderResult;
 using zxing::String;
+using zxing::common::StringUtils;
 
 const int DecodedBitStreamParser::TEXT_COMPACTION_MODE_LATCH = 900;
 const int DecodedBitStreamParser::BYTE_COMPACTION_MODE_LATCH = 901;
@@ -46,8 +47,6 @@ const int DecodedBitStreamParser::AL = 28;
 const int DecodedBitStreamParser::PS = 29;
 const int DecodedBitStreamParser::PAL = 29;
 
-const int DecodedBitStreamParser::EXP900_SIZE = 16;
-
 const char DecodedBitStreamParser::PUNCT_CHARS[] = {
   ';', '<', '>', '@', '[', '\\', '}', '_', '`', '~', '!',
   '\r', '\t', ',', ':', '\n', '-', '.', '$', '/', '"', '|', '*',
@@ -58,19 +57,6 @@ const char DecodedBitStreamParser::MIXED_CHARS[] = {
   '\r', '\t', ',', ':', '#', '-', '.', '$', '/', '+', '%', '*',
   '=', '^'};
 
-ArrayRef<BigInteger> DecodedBitStreamParser::initEXP900() {
-  ArrayRef<BigInteger> EXP900 (16);
-  EXP900[0] = BigInteger(1);
-  BigInteger nineHundred (900);
-  EXP900[1] = nineHundred;
-  for (int i = 2; i < EXP900->size(); i++) {
-    EXP900[i] = EXP900[i - 1] * nineHundred;
-  }
-  return EXP900;
-}
-
-ArrayRef<BigInteger> DecodedBitStreamParser::EXP900 = initEXP900();
-
 DecodedBitStreamParser::DecodedBitStreamParser(){}
 
 /**
@@ -78,7 +64,10 @@ DecodedBitStreamParser::DecodedBitStreamParser(){}
  **/
 Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<int> codewords)
 {
-  Ref<String> result (new String(100));
+  string result;
+  // Numeric compaction, the densest mode, yields about three digits per
+  // codeword.
+  result.reserve(codewords[0] * 3);
   // Get compaction mode
   int codeIndex = 1;
   int code = codewords[codeIndex++];
@@ -113,7 +102,9 @@ Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<int> codewords)
       throw FormatException();
     }
   }
-  return Ref<DecoderResult>(new DecoderResult(ArrayRef<char>(), result));
+  // Byte compaction yields ISO-8859-1; the other modes are ASCII.
+  StringUtils::convertToUTF8(result, StringUtils::ISO88591);
+  return Ref<DecoderResult>(new DecoderResult(ArrayRef<char>(), String::adopt(result)));
 }
 
 /**
@@ -128,7 +119,7 @@ Ref<DecoderResult> DecodedBitStreamParser::decode(ArrayRef<int> codewords)
  */
 int DecodedBitStreamParser::textCompaction(ArrayRef<int> codewords,
                                            int codeIndex,
-                                           Ref<String> result) {
+                                           string& result) {
   // 2 character per codeword
   ArrayRef<int> textCompactionData (codewords[0] << 1);
   // Used to hold the byte compaction value if there is a mode shift
@@ -197,7 +188,7 @@ int DecodedBitStreamParser::textCompaction(ArrayRef<int> codewords,
 void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionData,
                                                   ArrayRef<int> byteCompactionData,
                                                   int length,
-                                                  Ref<String> result)
+                                                  string& result)
 {
   // Beginning from an initial state of the Alpha sub-mode
   // The default compaction mode for PDF417 in effect at the start of each symbol shall always be Text
@@ -227,7 +218,7 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
             priorToShiftMode = subMode;
             subMode = PUNCT_SHIFT;
           } else if (subModeCh == MODE_SHIFT_TO_BYTE_COMPACTION_MODE) {
-            result->append((char) byteCompactionData[i]);
+            result += (char) byteCompactionData[i];
           } else if (subModeCh == TEXT_COMPACTION_MODE_LATCH) {
             subMode = ALPHA;
           }
@@ -252,7 +243,7 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
             priorToShiftMode = subMode;
             subMode = PUNCT_SHIFT;
           } else if (subModeCh == MODE_SHIFT_TO_BYTE_COMPACTION_MODE) {
-            result->append((char) byteCompactionData[i]);
+            result += (char) byteCompactionData[i];
           } else if (subModeCh == TEXT_COMPACTION_MODE_LATCH) {
             subMode = ALPHA;
           }
@@ -277,7 +268,7 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
             priorToShiftMode = subMode;
             subMode = PUNCT_SHIFT;
           } else if (subModeCh == MODE_SHIFT_TO_BYTE_COMPACTION_MODE) {
-            result->append((char) byteCompactionData[i]);
+            result += (char) byteCompactionData[i];
           } else if (subModeCh == TEXT_COMPACTION_MODE_LATCH) {
             subMode = ALPHA;
           }
@@ -292,7 +283,7 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
           if (subModeCh == PAL) {
             subMode = ALPHA;
           } else if (subModeCh == MODE_SHIFT_TO_BYTE_COMPACTION_MODE) {
-            result->append((char) byteCompactionData[i]);
+            result += (char) byteCompactionData[i];
           } else if (subModeCh == TEXT_COMPACTION_MODE_LATCH) {
             subMode = ALPHA;
           }
@@ -329,7 +320,7 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
           } else if (subModeCh == MODE_SHIFT_TO_BYTE_COMPACTION_MODE) {
             // PS before Shift-to-Byte is used as a padding character,
             // see 5.4.2.4 of the specification
-            result->append((char) byteCompactionData[i]);
+            result += (char) byteCompactionData[i];
           } else if (subModeCh == TEXT_COMPACTION_MODE_LATCH) {
             subMode = ALPHA;
           }
@@ -338,7 +329,7 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
     }
     if (ch != 0) {
       // Append decoded character to result
-      result->append(ch);
+      result += ch;
     }
     i++;
   }
@@ -357,14 +348,14 @@ void DecodedBitStreamParser::decodeTextCompaction(ArrayRef<int> textCompactionDa
  */
 int DecodedBitStreamParser::byteCompaction(int mode,
                                            ArrayRef<int> codewords,
-                                           int codeIndex, Ref<String> result) {
+                                           int codeIndex, string& result) {
   if (mode == BYTE_COMPACTION_MODE_LATCH) {
     // Total number of Byte Compaction characters to be encoded
     // is not a multiple of 6
     int count = 0;
     int64_t value = 0;
-    ArrayRef<char> decodedData = new Array<char>(6);
-    ArrayRef<int> byteCompactedCodewords = new Array<int>(6);
+    ArrayRef<char> decodedData(6);
+    ArrayRef<int> byteCompactedCodewords(6);
     bool end = false;
     int nextCode = codewords[codeIndex++];
     while ((codeIndex < codewords[0]) && !end) {
@@ -394,7 +385,7 @@ int DecodedBitStreamParser::byteCompaction(int mode,
             decodedData[5 - j] = (char) (value%256);
             value >>= 8;
           }
-          result->append(string(&(decodedData->values()[0]), decodedData->values().size()));
+          result.append(decodedData->values().data(), decodedData->size());
           count = 0;
         }
       }
@@ -409,7 +400,7 @@ int DecodedBitStreamParser::byteCompaction(int mode,
     // as one byte per codeword, without compaction.
     for (int i = 0; i < count; i++)
     {
-      result->append((char)byteCompactedCodewords[i]);
+      result += (char) byteCompactedCodewords[i];
     }
 
   } else if (mode == BYTE_COMPACTION_MODE_LATCH_6) {
@@ -439,12 +430,12 @@ int DecodedBitStreamParser::byteCompaction(int mode,
       if ((count % 5 == 0) && (count > 0)) {
         // Decode every 5 codewords
         // Convert to Base 256
-        ArrayRef<char> decodedData = new Array<char>(6);
+        ArrayRef<char> decodedData(6);
         for (int j = 0; j < 6; ++j) {
           decodedData[5 - j] = (char) (value & 0xFF);
           value >>= 8;
         }
-        result->append(string(&decodedData[0],6));
+        result.append(&decodedData[0], 6);
         // 2012-11-27 hfn after recent java code/fix by srowen
         count = 0;
       }
@@ -463,11 +454,11 @@ int DecodedBitStreamParser::byteCompaction(int mode,
  */
 int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
                                               int codeIndex,
-                                              Ref<String> result) {
+                                              string& result) {
   int count = 0;
   bool end = false;
   
-  ArrayRef<int> numericCodewords = new Array<int>(MAX_NUMERIC_CODEWORDS);
+  int numericCodewords[MAX_NUMERIC_CODEWORDS];
   
   while (codeIndex < codewords[0] && !end) {
     int code = codewords[codeIndex++];
@@ -495,8 +486,7 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
       // while in Numeric Compaction mode) serves  to terminate the
       // current Numeric Compaction mode grouping as described in 5.4.4.2,
       // and then to start a new one grouping.
-      Ref<String> s = decodeBase900toBase10(numericCodewords, count);
-      result->append(s->getText());
+      decodeBase900toBase10(numericCodewords, count, result);
       count = 0;
     }
   }
@@ -507,8 +497,8 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
  * Convert a list of Numeric Compacted codewords from Base 900 to Base 10.
  *
  * @param codewords The array of codewords
- * @param count     The number of codewords
- * @return The decoded string representing the Numeric data.
+ * @param count     The number of codewords, at most MAX_NUMERIC_CODEWORDS
+ * @param result    The decoded digits are appended to the result.
  */
 /*
   EXAMPLE
@@ -546,18 +536,44 @@ int DecodedBitStreamParser::numericCompaction(ArrayRef<int> codewords,
 
   Remove leading 1 =>  Result is 000213298174000
 */
-Ref<String> DecodedBitStreamParser::decodeBase900toBase10(ArrayRef<int> codewords, int count)
+void DecodedBitStreamParser::decodeBase900toBase10(int const* codewords,
+                                                   int count,
+                                                   string& result)
 {
-  BigInteger result = BigInteger(0);
+  // The value stays below 900^15 < 10^45, so five limbs of nine decimal
+  // digits, least significant first, hold it exactly.
+  const int LIMBS = 5;
+  const uint32_t LIMB_BASE = 1000000000;
+  uint32_t limbs[LIMBS] = {0};
+  int used = 1;
   for (int i = 0; i < count; i++) {
-    result = result + (EXP900[count - i - 1] * BigInteger(codewords[i]));
+    uint32_t carry = codewords[i];
+    for (int k = 0; k < used; k++) {
+      uint64_t value = (uint64_t) limbs[k] * 900 + carry;
+      limbs[k] = (uint32_t) (value % LIMB_BASE);
+      carry = (uint32_t) (value / LIMB_BASE);
+    }
+    if (carry != 0) {
+      if (used == LIMBS) {
+        throw FormatException("DecodedBitStreamParser::decodeBase900toBase10: too many codewords");
+      }
+      limbs[used++] = carry;
+    }
+  }
+
+  char digits[LIMBS * 9];
+  int start = LIMBS * 9;
+  for (int k = 0; k < used; k++) {
+    uint32_t limb = limbs[k];
+    for (int d = 0; d < 9 && (limb != 0 || k < used - 1); d++) {
+      digits[--start] = (char) ('0' + limb % 10);
+      limb /= 10;
+    }
   }
-  string resultString = bigIntegerToString(result);
-  if (resultString[0] != '1') {
+  if (start == LIMBS * 9 || digits[start] != '1') {
     throw FormatException("DecodedBitStreamParser::decodeBase900toBase10: String does not begin with 1");
   }
-  string resultString2;
-  resultString2.assign(resultString.begin()+1,resultString.end());
-  Ref<String> res (new String(resultString2));
-  return res;
+  for (int i = start + 1; i < LIMBS * 9; i++) {
+    result += digits[i];
+  }
 }
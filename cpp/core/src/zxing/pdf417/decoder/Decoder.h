@@ -22,7 +22,6 @@
  */
 
 #include <zxing/pdf417/decoder/ec/ErrorCorrection.h>
-#include <zxing/pdf417/decoder/ec/ModulusGF.h>
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
 #include <zxing/common/DecoderResult.h>
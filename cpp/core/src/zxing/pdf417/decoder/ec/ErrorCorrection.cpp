@@ -18,197 +18,249 @@
  */
 
 #include <zxing/pdf417/decoder/ec/ErrorCorrection.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
-#include <zxing/pdf417/decoder/ec/ModulusGF.h>
 
-using std::vector;
-using zxing::Ref;
 using zxing::ArrayRef;
+using zxing::ReedSolomonException;
 using zxing::pdf417::decoder::ec::ErrorCorrection;
-using zxing::pdf417::decoder::ec::ModulusPoly;
-using zxing::pdf417::decoder::ec::ModulusGF;
 
-/**
- * <p>PDF417 error correction implementation.</p>
- *
- * <p>This <a href="http://en.wikipedia.org/wiki/Reed%E2%80%93Solomon_error_correction#Example">example</a>
- * is quite useful in understanding the algorithm.</p>
- *
- * @author Sean Owen
- * @see com.google.zxing.common.reedsolomon.ReedSolomonDecoder
- */
- 
+const int ErrorCorrection::MAX_EC_CODEWORDS = 512;
 
-ErrorCorrection::ErrorCorrection()
-    : field_(ModulusGF::PDF417_GF)
-{
+namespace {
+
+const int MODULUS = 929;
+const int ORDER = MODULUS - 1;
+const int MAX_DEGREE = 2 * ErrorCorrection::MAX_EC_CODEWORDS + 1;
+
+/* exp and log tables for GF(929) with generator 3, built on first use;
+   exp is doubled so that a product of two logs needs no reduction */
+struct Tables {
+  int exp[2 * ORDER];
+  int log[MODULUS];
+  Tables() {
+    int x = 1;
+    for (int i = 0; i < ORDER; i++) {
+      exp[i] = exp[i + ORDER] = x;
+      log[x] = i;
+      x = (x * 3) % MODULUS;
+    }
+    log[0] = 0;
+  }
+};
+
+Tables const& tables() {
+  static Tables const gf;
+  return gf;
+}
+
+inline int add(int a, int b) {
+  int sum = a + b;
+  return sum >= MODULUS ? sum - MODULUS : sum;
+}
+
+inline int subtract(int a, int b) {
+  int difference = a - b;
+  return difference < 0 ? difference + MODULUS : difference;
+}
+
+inline int multiply(Tables const& gf, int a, int b) {
+  return a == 0 || b == 0 ? 0 : gf.exp[gf.log[a] + gf.log[b]];
+}
+
+inline int inverse(Tables const& gf, int a) {
+  if (a == 0) {
+    throw ReedSolomonException("inverse of zero!");
+  }
+  return gf.exp[ORDER - gf.log[a]];
+}
+
+/* p(x) with coefficients lowest degree first */
+int evaluate(Tables const& gf, int const* p, int degree, int x) {
+  int result = p[degree];
+  for (int i = degree - 1; i >= 0; i--) {
+    result = add(multiply(gf, result, x), p[i]);
+  }
+  return result;
+}
+
+}
+
+ErrorCorrection::ErrorCorrection() {
 }
 
 void ErrorCorrection::decode(ArrayRef<int> received,
                              int numECCodewords,
                              ArrayRef<int> erasures)
 {
-  Ref<ModulusPoly> poly (new ModulusPoly(field_, received));
-  ArrayRef<int> S( new Array<int>(numECCodewords));
+  Tables const& gf = tables();
+  int size = received->size();
+  if (numECCodewords <= 0 || numECCodewords > MAX_EC_CODEWORDS || size > ORDER) {
+    throw ReedSolomonException("Bad error correction parameters!");
+  }
+
+  // Unread codewords (negative values) count as erasures too
+  int erased[MAX_EC_CODEWORDS];
+  int numErased = 0;
+  for (int i = 0; i < erasures->size(); i++) {
+    int position = erasures[i];
+    if (position < 0 || position >= size) {
+      throw ReedSolomonException("Bad erasure location!");
+    }
+    if (numErased == numECCodewords) {
+      throw ReedSolomonException("Too many erasures!");
+    }
+    erased[numErased++] = position;
+  }
+  for (int i = 0; i < size; i++) {
+    if (received[i] < 0 || received[i] >= MODULUS) {
+      if (numErased == numECCodewords) {
+        throw ReedSolomonException("Too many erasures!");
+      }
+      received[i] = 0;
+      erased[numErased++] = i;
+    }
+  }
+
+  // S[j] = received(a^j) for j = 1..numECCodewords, received[0] being the
+  // highest-degree coefficient
+  int S[MAX_EC_CODEWORDS + 1];
   bool error = false;
-  for (int i = numECCodewords; i > 0; i--) {
-    int eval = poly->evaluateAt(field_.exp(i));
-    S[numECCodewords - i] = eval;
+  for (int j = 1; j <= numECCodewords; j++) {
+    int eval = 0;
+    for (int i = 0; i < size; i++) {
+      eval = add(eval == 0 ? 0 : gf.exp[gf.log[eval] + j], received[i]);
+    }
+    S[j] = eval;
     if (eval != 0) {
       error = true;
     }
   }
+  if (!error) {
+    return;
+  }
 
-  if (error) {
-
-    Ref<ModulusPoly> knownErrors = field_.getOne();
-    for (int i=0;i<erasures->size();i++) {
-      int b = field_.exp(received->size() - 1 - erasures[i]);
-      // Add (1 - bx) term:
-      ArrayRef<int> one_minus_b_x(new Array<int>(2));
-      one_minus_b_x[1]=field_.subtract(0,b);
-      one_minus_b_x[0]=1;
-      Ref<ModulusPoly> term (new ModulusPoly(field_,one_minus_b_x));
-      knownErrors = knownErrors->multiply(term);
+  // Berlekamp-Massey, starting from the erasure locator
+  // prod(1 - a^(size - 1 - position) x)
+  int buffers[3][MAX_DEGREE + 1];
+  int* lambda = buffers[0];
+  int* b = buffers[1];
+  int* t = buffers[2];
+  int lambdaDegree = 0;
+  lambda[0] = 1;
+  for (int e = 0; e < numErased; e++) {
+    int y = gf.exp[size - 1 - erased[e]];
+    lambda[++lambdaDegree] = 0;
+    for (int k = lambdaDegree; k > 0; k--) {
+      lambda[k] = subtract(lambda[k], multiply(gf, y, lambda[k - 1]));
     }
-
-    Ref<ModulusPoly> syndrome (new ModulusPoly(field_, S));
-    //syndrome = syndrome.multiply(knownErrors);
-
-    vector<Ref<ModulusPoly> > sigmaOmega (
-        runEuclideanAlgorithm(field_.buildMonomial(numECCodewords, 1), syndrome, numECCodewords));
-    Ref<ModulusPoly> sigma = sigmaOmega[0];
-    Ref<ModulusPoly> omega = sigmaOmega[1];
-
-    //sigma = sigma.multiply(knownErrors);
-
-    ArrayRef<int> errorLocations = findErrorLocations(sigma);
-    ArrayRef<int> errorMagnitudes = findErrorMagnitudes(omega, sigma, errorLocations);
-
-    for (int i = 0; i < errorLocations->size(); i++) {
-      int position = received->size() - 1 - field_.log(errorLocations[i]);
-      if (position < 0) {
-        throw ReedSolomonException("Bad error location!");
+  }
+  int bDegree = lambdaDegree;
+  for (int k = 0; k <= bDegree; k++) {
+    b[k] = lambda[k];
+  }
+  int L = numErased;
+  int shift = 1;
+  for (int r = numErased + 1; r <= numECCodewords; r++) {
+    int delta = 0;
+    for (int i = 0; i <= lambdaDegree && i < r; i++) {
+      delta = add(delta, multiply(gf, lambda[i], S[r - i]));
+    }
+    if (delta == 0) {
+      shift++;
+      continue;
+    }
+    // t = lambda - delta x^shift b
+    int tDegree = lambdaDegree > bDegree + shift ? lambdaDegree : bDegree + shift;
+    if (tDegree > MAX_DEGREE) {
+      throw ReedSolomonException("Error locator too large!");
+    }
+    for (int k = 0; k <= tDegree; k++) {
+      int value = k <= lambdaDegree ? lambda[k] : 0;
+      if (k >= shift && k - shift <= bDegree) {
+        value = subtract(value, multiply(gf, delta, b[k - shift]));
       }
-      received[position] = field_.subtract(received[position], errorMagnitudes[i]);
-#if (defined (DEBUG)  && defined _WIN32)
-      {
-        WCHAR szmsg[256];
-        swprintf(szmsg,L"ErrorCorrection::decode: fix @ %d, new value = %d\n",
-                 position, received[position]);
-        OutputDebugString(szmsg);
+      t[k] = value;
+    }
+    if (2 * L <= r + numErased - 1) {
+      // b = lambda / delta
+      int deltaInverse = inverse(gf, delta);
+      for (int k = 0; k <= lambdaDegree; k++) {
+        lambda[k] = multiply(gf, lambda[k], deltaInverse);
       }
-#endif
+      int* swap = b;
+      b = lambda;
+      bDegree = lambdaDegree;
+      lambda = t;
+      t = swap;
+      L = r + numErased - L;
+      shift = 1;
+    } else {
+      int* swap = lambda;
+      lambda = t;
+      t = swap;
+      shift++;
+    }
+    lambdaDegree = tDegree;
+    while (lambdaDegree > 0 && lambda[lambdaDegree] == 0) {
+      lambdaDegree--;
     }
   }
-}
+  if (lambdaDegree != L || 2 * L - numErased > numECCodewords) {
+    throw ReedSolomonException("Too many errors!");
+  }
 
-vector<Ref<ModulusPoly> >  ErrorCorrection::runEuclideanAlgorithm(Ref<ModulusPoly> a, Ref<ModulusPoly> b, int R)
-{
-  // Assume a's degree is >= b's
-  if (a->getDegree() < b->getDegree()) {
-    Ref<ModulusPoly> temp = a;
-    a = b;
-    b = temp;
-  }
-
-  Ref<ModulusPoly> rLast ( a);
-  Ref<ModulusPoly> r ( b);
-  Ref<ModulusPoly> tLast ( field_.getZero());
-  Ref<ModulusPoly> t ( field_.getOne());
-
-  // Run Euclidean algorithm until r's degree is less than R/2
-  while (r->getDegree() >= R / 2) {
-    Ref<ModulusPoly> rLastLast (rLast);
-    Ref<ModulusPoly> tLastLast (tLast);
-    rLast = r;
-    tLast = t;
-
-    // Divide rLastLast by rLast, with quotient in q and remainder in r
-    if (rLast->isZero()) {
-      // Oops, Euclidean algorithm already terminated?
-      throw ReedSolomonException("Euclidean algorithm already terminated?");
-    }
-    r = rLastLast;
-    Ref<ModulusPoly> q (field_.getZero());
-    int denominatorLeadingTerm = rLast->getCoefficient(rLast->getDegree());
-    int dltInverse = field_.inverse(denominatorLeadingTerm);
-    while (r->getDegree() >= rLast->getDegree() && !r->isZero()) {
-      int degreeDiff = r->getDegree() - rLast->getDegree();
-      int scale = field_.multiply(r->getCoefficient(r->getDegree()), dltInverse);
-      q = q->add(field_.buildMonomial(degreeDiff, scale));
-      r = r->subtract(rLast->multiplyByMonomial(degreeDiff, scale));
-    }
-
-	  t = q->multiply(tLast)->subtract(tLastLast)->negative();
-  }
-
-  int sigmaTildeAtZero = t->getCoefficient(0);
-  if (sigmaTildeAtZero == 0) {
-    throw ReedSolomonException("sigmaTilde = 0!");
-  }
-
-  int inverse = field_.inverse(sigmaTildeAtZero);
-  Ref<ModulusPoly> sigma (t->multiply(inverse));
-  Ref<ModulusPoly> omega (r->multiply(inverse));
-	vector<Ref<ModulusPoly> > v(2);
-	v[0] = sigma;
-	v[1] = omega;
-  return v;
-}
+  // Chien search over the codeword positions only: position p is a root
+  // when lambda(a^-(size - 1 - p)) == 0. terms[i] holds the log of
+  // lambda[i] a^(-i d) for the current degree d.
+  int terms[MAX_DEGREE + 1];
+  for (int i = 0; i <= lambdaDegree; i++) {
+    terms[i] = lambda[i] == 0 ? -1 : gf.log[lambda[i]];
+  }
+  int locations[MAX_DEGREE + 1];
+  int numLocations = 0;
+  for (int d = 0; d < size && numLocations < lambdaDegree; d++) {
+    int sum = 0;
+    for (int i = 0; i <= lambdaDegree; i++) {
+      if (terms[i] >= 0) {
+        sum = add(sum, gf.exp[terms[i]]);
+        terms[i] -= i % ORDER;
+        if (terms[i] < 0) {
+          terms[i] += ORDER;
+        }
+      }
+    }
+    if (sum == 0) {
+      locations[numLocations++] = d;
+    }
+  }
+  if (numLocations != lambdaDegree) {
+    throw ReedSolomonException("Error number inconsistency!");
+  }
 
-ArrayRef<int> ErrorCorrection::findErrorLocations(Ref<ModulusPoly> errorLocator)  {
-  // This is a direct application of Chien's search
-  int numErrors = errorLocator->getDegree();
-  ArrayRef<int> result( new Array<int>(numErrors));
-  int e = 0;
-  for (int i = 1; i < field_.getSize() && e < numErrors; i++) {
-    if (errorLocator->evaluateAt(i) == 0) {
-      result[e] = field_.inverse(i);
-      e++;
-    }
-  }
-  if (e != numErrors) {
-#if (defined (DEBUG) && defined _WIN32)
-	  char sz[128];
-	  sprintf(sz,"Error number inconsistency, %d/%d!",e,numErrors);
-    throw ReedSolomonException(sz);
-#else
-	  throw ReedSolomonException("Error number inconsistency!");
-#endif
-  }
-#if (defined (DEBUG) && defined _WIN32)
-  {
-    WCHAR szmsg[256];
-    swprintf(szmsg,L"ErrorCorrection::findErrorLocations: found %d errors.\n",
-             e);
-    OutputDebugString(szmsg);
-  }
-#endif
-  return result;
-}
+  // omega = S(x) lambda(x) mod x^n, where S(x) = sum S[j + 1] x^j; its
+  // degree is below the number of errors
+  int omega[MAX_EC_CODEWORDS];
+  int omegaDegree = lambdaDegree - 1;
+  for (int j = 0; j <= omegaDegree; j++) {
+    int value = 0;
+    for (int i = 0; i <= j; i++) {
+      value = add(value, multiply(gf, lambda[i], S[j + 1 - i]));
+    }
+    omega[j] = value;
+  }
+  int derivative[MAX_DEGREE];
+  for (int i = 1; i <= lambdaDegree; i++) {
+    derivative[i - 1] = multiply(gf, i % MODULUS, lambda[i]);
+  }
 
-ArrayRef<int> ErrorCorrection::findErrorMagnitudes(Ref<ModulusPoly> errorEvaluator,
-                                                   Ref<ModulusPoly> errorLocator,
-                                                   ArrayRef<int> errorLocations) {
-	int i;
-  int errorLocatorDegree = errorLocator->getDegree();
-  ArrayRef<int> formalDerivativeCoefficients (new Array<int>(errorLocatorDegree));
-  for (i = 1; i <= errorLocatorDegree; i++) {
-    formalDerivativeCoefficients[errorLocatorDegree - i] =
-        field_.multiply(i, errorLocator->getCoefficient(i));
-  }
-  Ref<ModulusPoly> formalDerivative (new ModulusPoly(field_, formalDerivativeCoefficients));
-
-  // This is directly applying Forney's Formula
-  int s = errorLocations->size();
-  ArrayRef<int> result ( new Array<int>(s));
-  for (i = 0; i < s; i++) {
-    int xiInverse = field_.inverse(errorLocations[i]);
-    int numerator = field_.subtract(0, errorEvaluator->evaluateAt(xiInverse));
-    int denominator = field_.inverse(formalDerivative->evaluateAt(xiInverse));
-    result[i] = field_.multiply(numerator, denominator);
+  // Forney: e = -omega(1/X) / lambda'(1/X)
+  for (int k = 0; k < numLocations; k++) {
+    int d = locations[k];
+    int xInverse = gf.exp[(ORDER - d) % ORDER];
+    int denominator = evaluate(gf, derivative, lambdaDegree - 1, xInverse);
+    int magnitude = multiply(gf,
+                             subtract(0, evaluate(gf, omega, omegaDegree, xInverse)),
+                             inverse(gf, denominator));
+    int position = size - 1 - d;
+    received[position] = subtract(received[position], magnitude);
   }
-  return result;
 }
-
@@ -22,10 +22,6 @@
 
 #include <zxing/common/Counted.h>
 #include <zxing/common/Array.h>
-#include <zxing/common/DecoderResult.h>
-#include <zxing/common/BitMatrix.h>
-#include <zxing/pdf417/decoder/ec/ModulusGF.h>
-#include <zxing/pdf417/decoder/ec/ModulusPoly.h>
 #include <zxing/common/reedsolomon/ReedSolomonException.h>
 
 namespace zxing {
@@ -35,32 +31,23 @@ namespace ec {
 
 
 /**
- * <p>PDF417 error correction implementation.</p>
- *
- * <p>This <a href="http://en.wikipedia.org/wiki/Reed%E2%80%93Solomon_error_correction#Example">example</a>
- * is quite useful in understanding the algorithm.</p>
+ * <p>PDF417 error correction implementation: Reed-Solomon over GF(929)
+ * using Berlekamp-Massey seeded with the erasure locator, Chien search
+ * and Forney's formula. All intermediate polynomials live in fixed-size
+ * buffers on the stack, so decoding does not allocate.</p>
  *
  * @author Sean Owen
  * @see com.google.zxing.common.reedsolomon.ReedSolomonDecoder
  */
 class ErrorCorrection: public Counted {
 
- private:
-  ModulusGF &field_;
-
  public:
+  static const int MAX_EC_CODEWORDS;
+
   ErrorCorrection();
   void decode(ArrayRef<int> received,
               int numECCodewords,
               ArrayRef<int> erasures);
-
- private:
-  std::vector<Ref<ModulusPoly> > runEuclideanAlgorithm(Ref<ModulusPoly> a, Ref<ModulusPoly> b, int R);
-
-  ArrayRef<int> findErrorLocations(Ref<ModulusPoly> errorLocator);
-  ArrayRef<int> findErrorMagnitudes(Ref<ModulusPoly> errorEvaluator,
-                                    Ref<ModulusPoly> errorLocator,
-                                    ArrayRef<int> errorLocations);
 };
 
 }
@@ -23,6 +23,7 @@
 #include <zxing/common/detector/MathUtils.h>
 
 using std::max;
+using std::min;
 using std::abs;
 using std::numeric_limits;
 using zxing::pdf417::detector::Detector;
@@ -73,6 +74,19 @@ const int Detector::STOP_PATTERN_LENGTH = sizeof(STOP_PATTERN) / sizeof(int);
 const int Detector::STOP_PATTERN_REVERSE[] = {1, 2, 1, 1, 1, 3, 1, 1, 7};
 const int Detector::STOP_PATTERN_REVERSE_LENGTH = sizeof(STOP_PATTERN_REVERSE) / sizeof(int);
 
+namespace {
+
+// Rows are at least three modules high, so with a known module size we can
+// step by half a row and still hit every row of the symbol.
+int getRowStep(DecodeHints const& hints) {
+  if (hints.getMinModuleSize() > 0) {
+    return max(1, (int) (3 * hints.getMinModuleSize() / 2));
+  }
+  return 8;
+}
+
+}
+
 Detector::Detector(Ref<BinaryBitmap> image) : image_(image) {}
 
 Ref<DetectorResult> Detector::detect() {
@@ -80,16 +94,21 @@ Ref<DetectorResult> Detector::detect() {
 }
 
 Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
-  (void)hints;
   // Fetch the 1 bit matrix once up front.
-  Ref<BitMatrix> matrix = image_->getBlackMatrix();
+  return detect(hints, image_->getBlackMatrix());
+}
+
+Ref<DetectorResult> Detector::detect(DecodeHints const& hints, Ref<BitMatrix> matrix) {
+  int left, top, right, bottom;
+  hints.getRegionOfInterest(matrix->getWidth(), matrix->getHeight(), left, top, right, bottom);
+
+  int rowStep = getRowStep(hints);
 
   // Try to find the vertices assuming the image is upright.
-  const int rowStep = 8;
-  ArrayRef< Ref<ResultPoint> > vertices (findVertices(matrix, rowStep));
+  ArrayRef< Ref<ResultPoint> > vertices (findVertices(matrix, rowStep, left, top, right, bottom));
   if (!vertices) {
     // Maybe the image is rotated 180 degrees?
-    vertices = findVertices180(matrix, rowStep);
+    vertices = findVertices180(matrix, rowStep, left, top, right, bottom);
     if (vertices) {
       correctVertices(matrix, vertices, true);
     }
@@ -116,7 +135,7 @@ Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
                                          vertices[13], vertices[15], moduleWidth), dimension);
 
   // Deskew and sample lines from image.
-  Ref<BitMatrix> linesMatrix = sampleLines(vertices, dimension, yDimension);
+  Ref<BitMatrix> linesMatrix = sampleLines(matrix, vertices, dimension, yDimension);
   Ref<BitMatrix> linesGrid(LinesSampler(linesMatrix, dimension).sample());
 
   ArrayRef< Ref<ResultPoint> > points(4);
@@ -127,12 +146,52 @@ Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
   return Ref<DetectorResult>(new DetectorResult(linesGrid, points));
 }
 
+Ref<DetectorResult> Detector::detect(DecodeHints const& hints, Ref<BinaryBitmap> coarse,
+                                     int scale) {
+  DecodeHints coarseHints (hints.scaleDown(scale));
+  Ref<BitMatrix> matrix = coarse->getBlackMatrix();
+  int left, top, right, bottom;
+  coarseHints.getRegionOfInterest(matrix->getWidth(), matrix->getHeight(), left, top, right, bottom);
+  int rowStep = getRowStep(coarseHints);
+
+  ArrayRef< Ref<ResultPoint> > vertices (findVertices(matrix, rowStep, left, top, right, bottom));
+  if (!vertices) {
+    vertices = findVertices180(matrix, rowStep, left, top, right, bottom);
+  }
+  if (!vertices) {
+    throw NotFoundException("No vertices found.");
+  }
+
+  // The rows searched may have stepped over the first and last rows of the
+  // symbol, so leave a step's room around the vertices.
+  float minX = vertices[0]->getX();
+  float maxX = minX;
+  float minY = vertices[0]->getY();
+  float maxY = minY;
+  for (int i = 1; i < 8; i++) {
+    minX = min(minX, vertices[i]->getX());
+    maxX = max(maxX, vertices[i]->getX());
+    minY = min(minY, vertices[i]->getY());
+    maxY = max(maxY, vertices[i]->getY());
+  }
+  int margin = rowStep + 1;
+  int regionLeft = max(0, (int) minX - margin) * scale;
+  int regionTop = max(0, (int) minY - margin) * scale;
+  int regionRight = min(matrix->getWidth(), (int) maxX + margin + 1) * scale;
+  int regionBottom = min(matrix->getHeight(), (int) maxY + margin + 1) * scale;
+  DecodeHints region (hints);
+  region.setRegionOfInterest(regionLeft, regionTop,
+                             regionRight - regionLeft, regionBottom - regionTop);
+  return detect(region, image_->getFineBlackMatrix());
+}
+
 /**
  * Locate the vertices and the codewords area of a black blob using the Start
  * and Stop patterns as locators.
  *
  * @param matrix the scanned barcode image.
  * @param rowStep the step size for iterating rows (every n-th row).
+ * @param left, top, right, bottom the region to search, right and bottom exclusive.
  * @return an array containing the vertices:
  *           vertices[0] x, y top left barcode
  *           vertices[1] x, y bottom left barcode
@@ -143,19 +202,19 @@ Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
  *           vertices[6] x, y top right codeword area
  *           vertices[7] x, y bottom right codeword area
  */
-ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int rowStep)
+ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int rowStep,
+                                                    int left, int top, int right, int bottom)
 {
-  const int height = matrix->getHeight();
-  const int width = matrix->getWidth();
+  const int width = right - left;
   
   ArrayRef< Ref<ResultPoint> > result(16);
   bool found = false;
 
-  ArrayRef<int> counters(new Array<int>(START_PATTERN_LENGTH));
+  ArrayRef<int> counters(START_PATTERN_LENGTH);
 
   // Top Left
-  for (int i = 0; i < height; i += rowStep) {
-    ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, START_PATTERN,
+  for (int i = top; i < bottom; i += rowStep) {
+    ArrayRef<int> loc = findGuardPattern(matrix, left, i, width, false, START_PATTERN,
                                          START_PATTERN_LENGTH, counters);
     if (loc) {
       result[0] = new ResultPoint((float)loc[0], (float)i);
@@ -167,8 +226,8 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int r
   // Bottom left
   if (found) { // Found the Top Left vertex
     found = false;
-    for (int i = height - 1; i > 0; i -= rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, START_PATTERN,
+    for (int i = bottom - 1; i > top; i -= rowStep) {
+      ArrayRef<int> loc = findGuardPattern(matrix, left, i, width, false, START_PATTERN,
                                            START_PATTERN_LENGTH, counters);
       if (loc) {
         result[1] = new ResultPoint((float)loc[0], (float)i);
@@ -179,13 +238,13 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int r
     }
   }
 
-  counters = new Array<int>(STOP_PATTERN_LENGTH);
+  counters = Array<int>::create(STOP_PATTERN_LENGTH);
 
   // Top right
   if (found) { // Found the Bottom Left vertex
     found = false;
-    for (int i = 0; i < height; i += rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, STOP_PATTERN,
+    for (int i = top; i < bottom; i += rowStep) {
+      ArrayRef<int> loc = findGuardPattern(matrix, left, i, width, false, STOP_PATTERN,
                                            STOP_PATTERN_LENGTH, counters);
       if (loc) {
         result[2] = new ResultPoint((float)loc[1], (float)i);
@@ -198,8 +257,8 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int r
   // Bottom right
   if (found) { // Found the Top right vertex
     found = false;
-    for (int i = height - 1; i > 0; i -= rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, width, false, STOP_PATTERN,
+    for (int i = bottom - 1; i > top; i -= rowStep) {
+      ArrayRef<int> loc = findGuardPattern(matrix, left, i, width, false, STOP_PATTERN,
                                            STOP_PATTERN_LENGTH, counters);
       if (loc) {
         result[3] = new ResultPoint((float)loc[1], (float)i);
@@ -213,20 +272,20 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices(Ref<BitMatrix> matrix, int r
   return found ? result : ArrayRef< Ref<ResultPoint> >();
 }
 
-ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, int rowStep) {
-  const int height = matrix->getHeight();
-  const int width = matrix->getWidth();
-  const int halfWidth = width >> 1;
+ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, int rowStep,
+                                                       int left, int top, int right, int bottom) {
+  const int halfWidth = (right - left) >> 1;
+  const int middle = left + halfWidth;
   
   ArrayRef< Ref<ResultPoint> > result(16);
   bool found = false;
   
-  ArrayRef<int> counters = new Array<int>(START_PATTERN_REVERSE_LENGTH);
+  ArrayRef<int> counters (START_PATTERN_REVERSE_LENGTH);
   
   // Top Left
-  for (int i = height - 1; i > 0; i -= rowStep) {
+  for (int i = bottom - 1; i > top; i -= rowStep) {
     ArrayRef<int> loc =
-        findGuardPattern(matrix, halfWidth, i, halfWidth, true, START_PATTERN_REVERSE,
+        findGuardPattern(matrix, middle, i, halfWidth, true, START_PATTERN_REVERSE,
                          START_PATTERN_REVERSE_LENGTH, counters);
     if (loc) {
       result[0] = new ResultPoint((float)loc[1], (float)i);
@@ -238,9 +297,9 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, in
   // Bottom Left
   if (found) { // Found the Top Left vertex
     found = false;
-    for (int i = 0; i < height; i += rowStep) {
+    for (int i = top; i < bottom; i += rowStep) {
       ArrayRef<int> loc =
-          findGuardPattern(matrix, halfWidth, i, halfWidth, true, START_PATTERN_REVERSE,
+          findGuardPattern(matrix, middle, i, halfWidth, true, START_PATTERN_REVERSE,
                            START_PATTERN_REVERSE_LENGTH, counters);
       if (loc) {
         result[1] = new ResultPoint((float)loc[1], (float)i);
@@ -251,13 +310,13 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, in
     }
   }
 
-  counters = new Array<int>(STOP_PATTERN_REVERSE_LENGTH);
+  counters = Array<int>::create(STOP_PATTERN_REVERSE_LENGTH);
 
   // Top Right
   if (found) { // Found the Bottom Left vertex
     found = false;
-    for (int i = height - 1; i > 0; i -= rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, halfWidth, false, STOP_PATTERN_REVERSE,
+    for (int i = bottom - 1; i > top; i -= rowStep) {
+      ArrayRef<int> loc = findGuardPattern(matrix, left, i, halfWidth, false, STOP_PATTERN_REVERSE,
                                            STOP_PATTERN_REVERSE_LENGTH, counters);
       if (loc) {
         result[2] = new ResultPoint((float)loc[0], (float)i);
@@ -270,8 +329,8 @@ ArrayRef< Ref<ResultPoint> > Detector::findVertices180(Ref<BitMatrix> matrix, in
   // Bottom Right
   if (found) { // Found the Top Right vertex
     found = false;
-    for (int i = 0; i < height; i += rowStep) {
-      ArrayRef<int> loc = findGuardPattern(matrix, 0, i, halfWidth, false, STOP_PATTERN_REVERSE,
+    for (int i = top; i < bottom; i += rowStep) {
+      ArrayRef<int> loc = findGuardPattern(matrix, left, i, halfWidth, false, STOP_PATTERN_REVERSE,
                                            STOP_PATTERN_REVERSE_LENGTH, counters);
       if (loc) {
         result[3] = new ResultPoint((float)loc[0], (float)i);
@@ -303,7 +362,8 @@ ArrayRef<int> Detector::findGuardPattern(Ref<BitMatrix> matrix,
                                          const int pattern[],
                                          int patternSize,
                                          ArrayRef<int>& counters) {
-  counters->values().assign(counters->size(), 0);
+  Span<int> values = counters->values();
+  std::fill(values.begin(), values.end(), 0);
   int patternLength = patternSize;
   bool isWhite = whiteFirst;
 
@@ -317,7 +377,7 @@ ArrayRef<int> Detector::findGuardPattern(Ref<BitMatrix> matrix,
       if (counterPosition == patternLength - 1) {
         if (patternMatchVariance(counters, pattern,
                                  MAX_INDIVIDUAL_VARIANCE) < MAX_AVG_VARIANCE) {
-          ArrayRef<int> result = new Array<int>(2);
+          ArrayRef<int> result (2);
           result[0] = patternStart;
           result[1] = x;
           return result;
@@ -635,12 +695,14 @@ int Detector::computeYDimension(Ref<ResultPoint> const& topLeft,
 /**
  * Deskew and over-sample image.
  *
+ * @param matrix the scanned barcode image.
  * @param vertices vertices from findVertices()
  * @param dimension x dimension
  * @param yDimension y dimension
  * @return an over-sampled BitMatrix.
  */
-Ref<BitMatrix> Detector::sampleLines(ArrayRef< Ref<ResultPoint> > const& vertices,
+Ref<BitMatrix> Detector::sampleLines(Ref<BitMatrix> const& matrix,
+                                     ArrayRef< Ref<ResultPoint> > const& vertices,
                                      int dimensionY,
                                      int dimension) {
   const int sampleDimensionX = dimension * 8;
@@ -657,7 +719,7 @@ Ref<BitMatrix> Detector::sampleLines(ArrayRef< Ref<ResultPoint> > const& vertice
           vertices[15]->getX(), vertices[15]->getY()));
 
   Ref<BitMatrix> linesMatrix = GridSampler::getInstance().sampleGrid(
-      image_->getBlackMatrix(), sampleDimensionX, sampleDimensionY, transform);
+      matrix, sampleDimensionX, sampleDimensionY, transform);
 
 
   return linesMatrix;
@@ -48,8 +48,10 @@ private:
 
   Ref<BinaryBitmap> image_;
   
-  static ArrayRef< Ref<ResultPoint> > findVertices(Ref<BitMatrix> matrix, int rowStep);
-  static ArrayRef< Ref<ResultPoint> > findVertices180(Ref<BitMatrix> matrix, int rowStep);
+  static ArrayRef< Ref<ResultPoint> > findVertices(Ref<BitMatrix> matrix, int rowStep,
+                                                   int left, int top, int right, int bottom);
+  static ArrayRef< Ref<ResultPoint> > findVertices180(Ref<BitMatrix> matrix, int rowStep,
+                                                      int left, int top, int right, int bottom);
 
   static ArrayRef<int> findGuardPattern(Ref<BitMatrix> matrix,
                                         int column,
@@ -90,13 +92,18 @@ private:
                         Ref<ResultPoint> const& bottomRight,
                         float moduleWidth);
 
-  Ref<BitMatrix> sampleLines(ArrayRef< Ref<ResultPoint> > const& vertices, int dimensionY, int dimension);
+  Ref<BitMatrix> sampleLines(Ref<BitMatrix> const& matrix,
+                             ArrayRef< Ref<ResultPoint> > const& vertices, int dimensionY, int dimension);
+  Ref<DetectorResult> detect(DecodeHints const& hints, Ref<BitMatrix> matrix);
 
 public:
   Detector(Ref<BinaryBitmap> image);
   Ref<BinaryBitmap> getImage();
   Ref<DetectorResult> detect();
   Ref<DetectorResult> detect(DecodeHints const& hints);
+  // Finds the start and stop patterns on coarse, the image scaled down by
+  // scale, and then detects again only around them here.
+  Ref<DetectorResult> detect(DecodeHints const& hints, Ref<BinaryBitmap> coarse, int scale);
 };
 
 }
@@ -81,12 +81,7 @@ VoteResult getValueWithMaxVotes(map<int, int>& votes) {
 
 vector<float> LinesSampler::init_ratios_table() {
   // Pre-computes and outputs the symbol ratio table.
-  vector<vector<float> > table (BitMatrixParser::SYMBOL_TABLE_LENGTH);
-  for(int i=0; i < (int)table.size(); ++i) {
-    table[i].resize(LinesSampler::BARS_IN_SYMBOL);
-  }
-  vector<float> RATIOS_TABLE (BitMatrixParser::SYMBOL_TABLE_LENGTH * LinesSampler::BARS_IN_SYMBOL);
-  int x = 0;
+  vector<float> table (BitMatrixParser::SYMBOL_TABLE_LENGTH * LinesSampler::BARS_IN_SYMBOL);
   for (int i = 0; i < BitMatrixParser::SYMBOL_TABLE_LENGTH; i++) {
     int currentSymbol = BitMatrixParser::SYMBOL_TABLE[i];
     int currentBit = currentSymbol & 0x1;
@@ -97,17 +92,17 @@ vector<float> LinesSampler::init_ratios_table() {
         currentSymbol >>= 1;
       }
       currentBit = currentSymbol & 0x1;
-      table[i][BARS_IN_SYMBOL - j - 1] = size / MODULES_IN_SYMBOL;
-    }
-    for (int j = 0; j < BARS_IN_SYMBOL; j++) {
-      RATIOS_TABLE[x] = table[i][j];
-      x++;
+      table[i * BARS_IN_SYMBOL + BARS_IN_SYMBOL - j - 1] = size / MODULES_IN_SYMBOL;
     }
   }
-  return RATIOS_TABLE;
+  return table;
 }
 
-const vector<float> LinesSampler::RATIOS_TABLE = init_ratios_table();
+// Built on first use rather than during static initialization.
+const vector<float>& LinesSampler::ratiosTable() {
+  static const vector<float> table = init_ratios_table();
+  return table;
+}
 
 LinesSampler::LinesSampler(Ref<BitMatrix> linesMatrix, int dimension)
     : linesMatrix_(linesMatrix), dimension_(dimension) {}
@@ -405,10 +400,11 @@ void LinesSampler::linesMatrixToCodewords(vector<vector<int> >& clusterNumbers,
       // Search for the most possible codeword by comparing the ratios of bar size to symbol width.
       // The sum of the squared differences is used as similarity metric.
       // (Picture it as the square euclidian distance in the space of eight tuples where a tuple represents the bar ratios.)
+      const vector<float>& ratios = ratiosTable();
       for (int j = 0; j < POSSIBLE_SYMBOLS; j++) {
         float error = 0.0f;
         for (int k = 0; k < BARS_IN_SYMBOL; k++) {
-          error += pow(RATIOS_TABLE[j * BARS_IN_SYMBOL + k] - cwRatios[i][k], 2);
+          error += pow(ratios[j * BARS_IN_SYMBOL + k] - cwRatios[i][k], 2);
         }
         if (error < bestMatchError) {
           bestMatchError = error;
@@ -31,8 +31,8 @@ private:
   static const int MODULES_IN_SYMBOL = 17;
   static const int BARS_IN_SYMBOL = 8;
   static const int POSSIBLE_SYMBOLS = 2787;
-  static const std::vector<float> RATIOS_TABLE;
   static std::vector<float> init_ratios_table();
+  static const std::vector<float>& ratiosTable();
   static const int BARCODE_START_OFFSET = 2;
 
   Ref<BitMatrix> linesMatrix_;
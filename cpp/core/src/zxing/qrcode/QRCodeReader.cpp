@@ -21,6 +21,8 @@
 
 #include <zxing/qrcode/QRCodeReader.h>
 #include <zxing/qrcode/detector/Detector.h>
+#include <zxing/NotFoundException.h>
+#include <cmath>
 
 #include <iostream>
 
@@ -33,10 +35,35 @@ namespace zxing {
 		}
 		//TODO: see if any of the other files in the qrcode tree need tryHarder
 		Ref<Result> QRCodeReader::decode(Ref<BinaryBitmap> image, DecodeHints hints) {
-			Detector detector(image->getBlackMatrix());
-			Ref<DetectorResult> detectorResult(detector.detect(hints));
-			ArrayRef< Ref<ResultPoint> > points (detectorResult->getPoints());
-			Ref<DecoderResult> decoderResult(decoder_.decode(detectorResult->getBits()));
+			Ref<DecoderResult> decoderResult;
+			ArrayRef< Ref<ResultPoint> > points;
+			if (hints.getPureBarcode()) {
+				decoderResult = decoder_.decode(extractPureBits(image->getBlackMatrix()));
+				points = new Array< Ref<ResultPoint> >();
+			} else {
+				int scale = 1;
+				Ref<BinaryBitmap> coarse;
+				if (hints.getCoarseDetection()) {
+					coarse = image->getCoarseLevel(scale);
+				}
+				if (scale > 1) {
+					try {
+						Detector detector(image->getFineBlackMatrix());
+						Ref<DetectorResult> detectorResult(
+							detector.detect(hints, coarse->getBlackMatrix(), scale));
+						points = detectorResult->getPoints();
+						decoderResult = decoder_.decode(detectorResult->getBits());
+					} catch (ReaderException const&) {
+						// Perhaps the modules are too small to find scaled down.
+					}
+				}
+				if (!decoderResult) {
+					Detector detector(image->getBlackMatrix());
+					Ref<DetectorResult> detectorResult(detector.detect(hints));
+					points = detectorResult->getPoints();
+					decoderResult = decoder_.decode(detectorResult->getBits());
+				}
+			}
 			Ref<Result> result(
 							   new Result(decoderResult->getText(), decoderResult->getRawBytes(), points, BarcodeFormat::QR_CODE));
 			return result;
@@ -48,5 +75,110 @@ namespace zxing {
     Decoder& QRCodeReader::getDecoder() {
         return decoder_;
     }
+
+    /**
+     * This method detects a code in a "pure" image -- that is, pure monochrome image
+     * which contains only an unrotated, unskewed, image of a code, with some white border
+     * around it. This is a specialized method that works exceptionally fast in this special
+     * case.
+     */
+    Ref<BitMatrix> QRCodeReader::extractPureBits(Ref<BitMatrix> image) {
+      ArrayRef<int> leftTopBlack = image->getTopLeftOnBit();
+      ArrayRef<int> rightBottomBlack = image->getBottomRightOnBit();
+      if (!leftTopBlack || !rightBottomBlack) {
+        throw NotFoundException("QRCodeReader::extractPureBits: no black pixels");
+      }
+
+      float nModuleSize = moduleSize(leftTopBlack, image);
+
+      int top = leftTopBlack[1];
+      int bottom = rightBottomBlack[1];
+      int left = leftTopBlack[0];
+      int right = rightBottomBlack[0];
+
+      if (left >= right || top >= bottom) {
+        throw NotFoundException("QRCodeReader::extractPureBits: empty symbol");
+      }
+
+      if (bottom - top != right - left) {
+        // Special case, where bottom-right module wasn't black so we found something else in the last row
+        // Assume it's a square, so use height as the width
+        right = left + (bottom - top);
+      }
+
+      int matrixWidth = (int) floor((right - left + 1) / nModuleSize + 0.5f);
+      int matrixHeight = (int) floor((bottom - top + 1) / nModuleSize + 0.5f);
+      if (matrixWidth <= 0 || matrixHeight <= 0) {
+        throw NotFoundException("QRCodeReader::extractPureBits: no matrix found");
+      }
+      if (matrixHeight != matrixWidth) {
+        // Only possibly decode square regions
+        throw NotFoundException("QRCodeReader::extractPureBits: symbol is not square");
+      }
+
+      // Push in the "border" by half the module width so that we start
+      // sampling in the middle of the module. Just in case the image is a
+      // little off, this will help recover.
+      int nudge = (int) (nModuleSize / 2.0f);
+      top += nudge;
+      left += nudge;
+
+      // But careful that this does not sample off the edge
+      int nudgedTooFarRight = left + (int) ((matrixWidth - 1) * nModuleSize) - right;
+      if (nudgedTooFarRight > 0) {
+        if (nudgedTooFarRight > nudge) {
+          throw NotFoundException("QRCodeReader::extractPureBits: sampling off the edge");
+        }
+        left -= nudgedTooFarRight;
+      }
+      int nudgedTooFarDown = top + (int) ((matrixHeight - 1) * nModuleSize) - bottom;
+      if (nudgedTooFarDown > 0) {
+        if (nudgedTooFarDown > nudge) {
+          throw NotFoundException("QRCodeReader::extractPureBits: sampling off the edge");
+        }
+        top -= nudgedTooFarDown;
+      }
+
+      // Now just read off the bits
+      Ref<BitMatrix> bits(new BitMatrix(matrixWidth, matrixHeight));
+      for (int y = 0; y < matrixHeight; y++) {
+        int iOffset = top + (int) (y * nModuleSize);
+        for (int x = 0; x < matrixWidth; x++) {
+          if (image->get(left + (int) (x * nModuleSize), iOffset)) {
+            bits->set(x, y);
+          }
+        }
+      }
+      return bits;
+    }
+
+    float QRCodeReader::moduleSize(ArrayRef<int> leftTopBlack, Ref<BitMatrix> image) {
+      int height = image->getHeight();
+      int width = image->getWidth();
+      int x = leftTopBlack[0];
+      int y = leftTopBlack[1];
+      // Walk the diagonal of the top left finder pattern; its fifth
+      // transition is the far corner, seven modules away.
+      bool inBlack = true;
+      int transitions = 0;
+      while (x < width && y < height) {
+        if (inBlack != image->get(x, y)) {
+          if (++transitions == 5) {
+            break;
+          }
+          inBlack = !inBlack;
+        }
+        x++;
+        y++;
+      }
+      if (x == width || y == height) {
+        throw NotFoundException("QRCodeReader::moduleSize: not found");
+      }
+      return (x - leftTopBlack[0]) / 7.0f;
+    }
+
+    Ref<Reader> QRCodeReader::cloneReader() const {
+      return Ref<Reader>(new QRCodeReader());
+    }
 	}
 }
@@ -31,6 +31,9 @@ namespace qrcode {
 class QRCodeReader : public Reader {
  private:
   Decoder decoder_;
+
+  static Ref<BitMatrix> extractPureBits(Ref<BitMatrix> image);
+  static float moduleSize(ArrayRef<int> leftTopBlack, Ref<BitMatrix> image);
 			
  protected:
   Decoder& getDecoder();
@@ -40,6 +43,7 @@ class QRCodeReader : public Reader {
   virtual ~QRCodeReader();
 			
   Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints);
+  Ref<Reader> cloneReader() const;
 };
 
 }
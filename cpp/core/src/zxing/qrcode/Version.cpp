@@ -72,8 +72,6 @@ unsigned int Version::VERSION_DECODE_INFO[] = { 0x07C94, 0x085BC, 0x09A99, 0x0A4
     0x27541, 0x28C69
                                               };
 int Version::N_VERSION_DECODE_INFOS = 34;
-vector<Ref<Version> > Version::VERSIONS;
-static int N_VERSIONS = Version::buildVersions();
 
 int Version::getVersionNumber() {
   return versionNumber_;
@@ -108,11 +106,19 @@ Version *Version::getProvisionalVersionForDimension(int dimension) {
 }
 
 Version *Version::getVersionForNumber(int versionNumber) {
-  if (versionNumber < 1 || versionNumber > N_VERSIONS) {
+  vector<Ref<Version> > const& versions = allVersions();
+  if (versionNumber < 1 || versionNumber > (int)versions.size()) {
     throw ReaderException("versionNumber must be between 1 and 40");
   }
 
-  return VERSIONS[versionNumber - 1];
+  return versions[versionNumber - 1];
+}
+
+// The table is built on first use rather than during static initialization,
+// so loading the library does not allocate it.
+vector<Ref<Version> > const& Version::allVersions() {
+  static const vector<Ref<Version> > versions = buildVersions();
+  return versions;
 }
 
 Version::Version(int versionNumber, vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
@@ -218,7 +224,8 @@ static vector<int> *intArray(size_t n...) {
   return result;
 }
 
-int Version::buildVersions() {
+vector<Ref<Version> > Version::buildVersions() {
+  vector<Ref<Version> > VERSIONS;
   VERSIONS.push_back(Ref<Version>(new Version(1, intArray(0),
                                   new ECBlocks(7, new ECB(1, 19)),
                                   new ECBlocks(10, new ECB(1, 16)),
@@ -553,7 +560,7 @@ int Version::buildVersions() {
                                                new ECB(34, 25)),
                                   new ECBlocks(30, new ECB(20, 15),
                                                new ECB(61, 16)))));
-  return (int) VERSIONS.size();
+  return VERSIONS;
 }
 
 }
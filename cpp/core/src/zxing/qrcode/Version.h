@@ -61,11 +61,12 @@ private:
   int totalCodewords_;
   Version(int versionNumber, std::vector<int> *alignmentPatternCenters, ECBlocks *ecBlocks1, ECBlocks *ecBlocks2,
           ECBlocks *ecBlocks3, ECBlocks *ecBlocks4);
+  static std::vector<Ref<Version> > buildVersions();
+  static std::vector<Ref<Version> > const& allVersions();
 
 public:
   static unsigned int VERSION_DECODE_INFO[];
   static int N_VERSION_DECODE_INFOS;
-  static std::vector<Ref<Version> > VERSIONS;
 
   ~Version();
   int getVersionNumber();
@@ -77,7 +78,6 @@ public:
   static Version *getVersionForNumber(int versionNumber);
   static Version *decodeVersionInformation(unsigned int versionBits);
   Ref<BitMatrix> buildFunctionPattern();
-  static int buildVersions();
 };
 }
 }
@@ -33,13 +33,12 @@ DataMask::DataMask() {
 DataMask::~DataMask() {
 }
 
-vector<Ref<DataMask> > DataMask::DATA_MASKS;
-static int N_DATA_MASKS = DataMask::buildDataMasks();
-
 DataMask &DataMask::forReference(int reference) {
   if (reference < 0 || reference > 7) {
     throw IllegalArgumentException("reference must be between 0 and 7");
   }
+  // Built on first use rather than during static initialization.
+  static const vector<Ref<DataMask> > DATA_MASKS = buildDataMasks();
   return *DATA_MASKS[reference];
 }
 
@@ -143,7 +142,8 @@ public:
   }
 };
 
-int DataMask::buildDataMasks() {
+vector<Ref<DataMask> > DataMask::buildDataMasks() {
+  vector<Ref<DataMask> > DATA_MASKS;
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask000()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask001()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask010()));
@@ -152,7 +152,7 @@ int DataMask::buildDataMasks() {
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask101()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask110()));
   DATA_MASKS.push_back(Ref<DataMask> (new DataMask111()));
-  return (int) DATA_MASKS.size();
+  return DATA_MASKS;
 }
 
 }
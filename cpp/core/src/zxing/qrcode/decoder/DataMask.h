@@ -31,12 +31,11 @@ namespace qrcode {
 
 class DataMask : public Counted {
 private:
-  static std::vector<Ref<DataMask> > DATA_MASKS;
+  static std::vector<Ref<DataMask> > buildDataMasks();
 
 protected:
 
 public:
-  static int buildDataMasks();
   DataMask();
   virtual ~DataMask();
   void unmaskBitMatrix(BitMatrix& matrix, size_t dimension);
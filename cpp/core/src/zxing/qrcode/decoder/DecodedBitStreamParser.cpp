@@ -24,19 +24,6 @@
 #include <zxing/FormatException.h>
 #include <zxing/common/StringUtils.h>
 #include <iostream>
-#ifndef NO_ICONV
-#include <iconv.h>
-#endif
-
-// Required for compatibility. TODO: test on Symbian
-#ifdef ZXING_ICONV_CONST
-#undef ICONV_CONST
-#define ICONV_CONST const
-#endif
-
-#ifndef ICONV_CONST
-#define ICONV_CONST /**/
-#endif
 
 using namespace std;
 using namespace zxing;
@@ -52,58 +39,9 @@ const char DecodedBitStreamParser::ALPHANUMERIC_CHARS[] =
 
 namespace {int GB2312_SUBSET = 1;}
 
-void DecodedBitStreamParser::append(std::string &result,
-                                    string const& in,
-                                    const char *src) {
-  append(result, (char const*)in.c_str(), in.length(), src);
-}
-
-void DecodedBitStreamParser::append(std::string &result,
-                                    const char *bufIn,
-                                    size_t nIn,
-                                    const char *src) {
-#ifndef NO_ICONV
-  if (nIn == 0) {
-    return;
-  }
-
-  iconv_t cd = iconv_open(StringUtils::UTF8, src);
-  if (cd == (iconv_t)-1) {
-    result.append((const char *)bufIn, nIn);
-    return;
-  }
-
-  const int maxOut = 4 * (int) nIn + 1;
-  char* bufOut = new char[maxOut];
-
-  ICONV_CONST char *fromPtr = (ICONV_CONST char *)bufIn;
-  size_t nFrom = nIn;
-  char *toPtr = (char *)bufOut;
-  size_t nTo = maxOut;
-
-  while (nFrom > 0) {
-    size_t oneway = iconv(cd, &fromPtr, &nFrom, &toPtr, &nTo);
-    if (oneway == (size_t)(-1)) {
-      iconv_close(cd);
-      delete[] bufOut;
-      throw ReaderException("error converting characters");
-    }
-  }
-  iconv_close(cd);
-
-  int nResult = (int) maxOut - (int) nTo;
-  bufOut[nResult] = '\0';
-  result.append((const char *)bufOut);
-  delete[] bufOut;
-#else
-  result.append((const char *)bufIn, nIn);
-#endif
-}
-
-void DecodedBitStreamParser::decodeHanziSegment(Ref<BitSource> bits_,
+void DecodedBitStreamParser::decodeHanziSegment(BitSource& bits,
                                                 string& result,
                                                 int count) {
-  BitSource& bits (*bits_);
   // Don't crash trying to read more bits than we have available.
   if (count * 13 > bits.available()) {
     throw FormatException();
@@ -132,7 +70,7 @@ void DecodedBitStreamParser::decodeHanziSegment(Ref<BitSource> bits_,
   }
 
   try {
-    append(result, buffer, nBytes, StringUtils::GB2312);
+    StringUtils::appendUTF8(result, buffer, nBytes, StringUtils::GB2312);
   } catch (ReaderException const& ignored) {
     (void)ignored;
     delete [] buffer;
@@ -142,7 +80,7 @@ void DecodedBitStreamParser::decodeHanziSegment(Ref<BitSource> bits_,
   delete [] buffer;
 }
 
-void DecodedBitStreamParser::decodeKanjiSegment(Ref<BitSource> bits, std::string &result, int count) {
+void DecodedBitStreamParser::decodeKanjiSegment(BitSource& bits, std::string &result, int count) {
   // Each character will require 2 bytes. Read the characters as 2-byte pairs
   // and decode as Shift_JIS afterwards
   size_t nBytes = 2 * count;
@@ -151,7 +89,7 @@ void DecodedBitStreamParser::decodeKanjiSegment(Ref<BitSource> bits, std::string
   while (count > 0) {
     // Each 13 bits encodes a 2-byte character
 
-    int twoBytes = bits->readBits(13);
+    int twoBytes = bits.readBits(13);
     int assembledTwoBytes = ((twoBytes / 0x0C0) << 8) | (twoBytes % 0x0C0);
     if (assembledTwoBytes < 0x01F00) {
       // In the 0x8140 to 0x9FFC range
@@ -166,7 +104,7 @@ void DecodedBitStreamParser::decodeKanjiSegment(Ref<BitSource> bits, std::string
     count--;
   }
   try {
-    append(result, buffer, nBytes, StringUtils::SHIFT_JIS);
+    StringUtils::appendUTF8(result, buffer, nBytes, StringUtils::SHIFT_JIS);
   } catch (ReaderException const& ignored) {
     (void)ignored;
     delete [] buffer;
@@ -175,14 +113,13 @@ void DecodedBitStreamParser::decodeKanjiSegment(Ref<BitSource> bits, std::string
   delete[] buffer;
 }
 
-void DecodedBitStreamParser::decodeByteSegment(Ref<BitSource> bits_,
+void DecodedBitStreamParser::decodeByteSegment(BitSource& bits,
                                                string& result,
                                                int count,
                                                CharacterSetECI* currentCharacterSetECI,
-                                               ArrayRef< ArrayRef<char> >& byteSegments,
+                                               vector< ArrayRef<char> >& byteSegments,
                                                Hashtable const& hints) {
   int nBytes = count;
-  BitSource& bits (*bits_);
   // Don't crash trying to read more bits than we have available.
   if (count << 3 > bits.available()) {
     throw FormatException();
@@ -205,25 +142,25 @@ void DecodedBitStreamParser::decodeByteSegment(Ref<BitSource> bits_,
     encoding = currentCharacterSetECI->name();
   }
   try {
-    append(result, readBytes, nBytes, encoding.c_str());
+    StringUtils::appendUTF8(result, readBytes, nBytes, encoding.c_str());
   } catch (ReaderException const& ignored) {
     (void)ignored;
     throw FormatException();
   }
-  byteSegments->values().push_back(bytes_);
+  byteSegments.push_back(bytes_);
 }
 
-void DecodedBitStreamParser::decodeNumericSegment(Ref<BitSource> bits, std::string &result, int count) {
+void DecodedBitStreamParser::decodeNumericSegment(BitSource& bits, std::string &result, int count) {
   int nBytes = count;
   char* bytes = new char[nBytes];
   int i = 0;
   // Read three digits at a time
   while (count >= 3) {
     // Each 10 bits encodes three digits
-    if (bits->available() < 10) {
+    if (bits.available() < 10) {
       throw ReaderException("format exception");
     }
-    int threeDigitsBits = bits->readBits(10);
+    int threeDigitsBits = bits.readBits(10);
     if (threeDigitsBits >= 1000) {
       ostringstream s;
       s << "Illegal value for 3-digit unit: " << threeDigitsBits;
@@ -236,11 +173,11 @@ void DecodedBitStreamParser::decodeNumericSegment(Ref<BitSource> bits, std::stri
     count -= 3;
   }
   if (count == 2) {
-    if (bits->available() < 7) {
+    if (bits.available() < 7) {
       throw ReaderException("format exception");
     }
     // Two digits left over to read, encoded in 7 bits
-    int twoDigitsBits = bits->readBits(7);
+    int twoDigitsBits = bits.readBits(7);
     if (twoDigitsBits >= 100) {
       ostringstream s;
       s << "Illegal value for 2-digit unit: " << twoDigitsBits;
@@ -250,11 +187,11 @@ void DecodedBitStreamParser::decodeNumericSegment(Ref<BitSource> bits, std::stri
     bytes[i++] = ALPHANUMERIC_CHARS[twoDigitsBits / 10];
     bytes[i++] = ALPHANUMERIC_CHARS[twoDigitsBits % 10];
   } else if (count == 1) {
-    if (bits->available() < 4) {
+    if (bits.available() < 4) {
       throw ReaderException("format exception");
     }
     // One digit left over to read
-    int digitBits = bits->readBits(4);
+    int digitBits = bits.readBits(4);
     if (digitBits >= 10) {
       ostringstream s;
       s << "Illegal value for digit unit: " << digitBits;
@@ -263,7 +200,7 @@ void DecodedBitStreamParser::decodeNumericSegment(Ref<BitSource> bits, std::stri
     }
     bytes[i++] = ALPHANUMERIC_CHARS[digitBits];
   }
-  append(result, bytes, nBytes, StringUtils::ASCII);
+  result.append(bytes, nBytes);
   delete[] bytes;
 }
 
@@ -274,20 +211,19 @@ char DecodedBitStreamParser::toAlphaNumericChar(size_t value) {
   return ALPHANUMERIC_CHARS[value];
 }
 
-void DecodedBitStreamParser::decodeAlphanumericSegment(Ref<BitSource> bits_,
+void DecodedBitStreamParser::decodeAlphanumericSegment(BitSource& bits,
                                                        string& result,
                                                        int count,
                                                        bool fc1InEffect) {
-  BitSource& bits (*bits_);
-  ostringstream bytes;
+  size_t start = result.size();
   // Read two characters at a time
   while (count > 1) {
     if (bits.available() < 11) {
       throw FormatException();
     }
     int nextTwoCharsBits = bits.readBits(11);
-    bytes << toAlphaNumericChar(nextTwoCharsBits / 45);
-    bytes << toAlphaNumericChar(nextTwoCharsBits % 45);
+    result += toAlphaNumericChar(nextTwoCharsBits / 45);
+    result += toAlphaNumericChar(nextTwoCharsBits % 45);
     count -= 2;
   }
   if (count == 1) {
@@ -295,29 +231,27 @@ void DecodedBitStreamParser::decodeAlphanumericSegment(Ref<BitSource> bits_,
     if (bits.available() < 6) {
       throw FormatException();
     }
-    bytes << toAlphaNumericChar(bits.readBits(6));
+    result += toAlphaNumericChar(bits.readBits(6));
   }
   // See section 6.4.8.1, 6.4.8.2
-  string s = bytes.str();
   if (fc1InEffect) {
     // We need to massage the result a bit if in an FNC1 mode:
-    ostringstream r;
-    for (size_t i = 0; i < s.length(); i++) {
-      if (s[i] != '%') {
-        r << s[i];
+    size_t out = start;
+    for (size_t i = start; i < result.length(); i++) {
+      if (result[i] != '%') {
+        result[out++] = result[i];
       } else {
-        if (i < s.length() - 1 && s[i + 1] == '%') {
+        if (i < result.length() - 1 && result[i + 1] == '%') {
           // %% is rendered as %
-          r << s[i++];
+          result[out++] = result[i++];
         } else {
           // In alpha mode, % should be converted to FNC1 separator 0x1D
-          r << (char)0x1D;
+          result[out++] = (char)0x1D;
         }
       }
     }
-    s = r.str();
+    result.resize(out);
   }
-  append(result, s, StringUtils::ASCII);
 }
 
 namespace {
@@ -346,11 +280,12 @@ DecodedBitStreamParser::decode(ArrayRef<char> bytes,
                                Version* version,
                                ErrorCorrectionLevel const& ecLevel,
                                Hashtable const& hints) {
-  Ref<BitSource> bits_ (new BitSource(bytes));
-  BitSource& bits (*bits_);
+  BitSource bits(bytes);
   string result;
-  result.reserve(50);
-  ArrayRef< ArrayRef<char> > byteSegments (0);
+  // The data codewords of the version and level hold at most 2.4 numeric
+  // characters per byte, the densest mode.
+  result.reserve(bytes->size() * 12 / 5);
+  vector< ArrayRef<char> > byteSegments;
   try {
     CharacterSetECI* currentCharacterSetECI = 0;
     bool fc1InEffect = false;
@@ -393,20 +328,20 @@ DecodedBitStreamParser::decode(ArrayRef<char> bytes,
             int subset = bits.readBits(4);
             int countHanzi = bits.readBits(mode->getCharacterCountBits(version));
             if (subset == GB2312_SUBSET) {
-              decodeHanziSegment(bits_, result, countHanzi);
+              decodeHanziSegment(bits, result, countHanzi);
             }
           } else {
             // "Normal" QR code modes:
             // How many characters will follow, encoded in this mode?
             int count = bits.readBits(mode->getCharacterCountBits(version));
             if (mode == &Mode::NUMERIC) {
-              decodeNumericSegment(bits_, result, count);
+              decodeNumericSegment(bits, result, count);
             } else if (mode == &Mode::ALPHANUMERIC) {
-              decodeAlphanumericSegment(bits_, result, count, fc1InEffect);
+              decodeAlphanumericSegment(bits, result, count, fc1InEffect);
             } else if (mode == &Mode::BYTE) {
-              decodeByteSegment(bits_, result, count, currentCharacterSetECI, byteSegments, hints);
+              decodeByteSegment(bits, result, count, currentCharacterSetECI, byteSegments, hints);
             } else if (mode == &Mode::KANJI) {
-              decodeKanjiSegment(bits_, result, count);
+              decodeKanjiSegment(bits, result, count);
             } else {
               throw FormatException();
             }
@@ -420,6 +355,7 @@ DecodedBitStreamParser::decode(ArrayRef<char> bytes,
     throw FormatException();
   }
   
-  return Ref<DecoderResult>(new DecoderResult(bytes, Ref<String>(new String(result)), byteSegments, (string)ecLevel));
+  ArrayRef< ArrayRef<char> > segments (new Array< ArrayRef<char> >(byteSegments));
+  return Ref<DecoderResult>(new DecoderResult(bytes, String::adopt(result), segments, (string)ecLevel));
 }
 
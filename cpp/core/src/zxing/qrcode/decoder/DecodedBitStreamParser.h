@@ -25,6 +25,7 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <vector>
 #include <zxing/qrcode/decoder/Mode.h>
 #include <zxing/common/BitSource.h>
 #include <zxing/common/Counted.h>
@@ -44,20 +45,17 @@ private:
   static char const ALPHANUMERIC_CHARS[];
   static char toAlphaNumericChar(size_t value);
 
-  static void decodeHanziSegment(Ref<BitSource> bits, std::string &result, int count);
-  static void decodeKanjiSegment(Ref<BitSource> bits, std::string &result, int count);
-  static void decodeByteSegment(Ref<BitSource> bits, std::string &result, int count);
-  static void decodeByteSegment(Ref<BitSource> bits_,
+  static void decodeHanziSegment(BitSource& bits, std::string &result, int count);
+  static void decodeKanjiSegment(BitSource& bits, std::string &result, int count);
+  static void decodeByteSegment(BitSource& bits, std::string &result, int count);
+  static void decodeByteSegment(BitSource& bits,
                                 std::string& result,
                                 int count,
                                 zxing::common::CharacterSetECI* currentCharacterSetECI,
-                                ArrayRef< ArrayRef<char> >& byteSegments,
+                                std::vector< ArrayRef<char> >& byteSegments,
                                 Hashtable const& hints);
-  static void decodeAlphanumericSegment(Ref<BitSource> bits, std::string &result, int count, bool fc1InEffect);
-  static void decodeNumericSegment(Ref<BitSource> bits, std::string &result, int count);
-
-  static void append(std::string &ost, const char *bufIn, size_t nIn, const char *src);
-  static void append(std::string &ost, std::string const& in, const char *src);
+  static void decodeAlphanumericSegment(BitSource& bits, std::string &result, int count, bool fc1InEffect);
+  static void decodeNumericSegment(BitSource& bits, std::string &result, int count);
 
 public:
   static Ref<DecoderResult> decode(ArrayRef<char> bytes,
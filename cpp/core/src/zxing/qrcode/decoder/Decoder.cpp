@@ -38,7 +38,7 @@ using zxing::ArrayRef;
 using zxing::BitMatrix;
 
 Decoder::Decoder() :
-  rsDecoder_(GenericGF::QR_CODE_FIELD_256) {
+  rsDecoder_(GenericGF::QR_CODE_FIELD_256()) {
 }
 
 void Decoder::correctErrors(ArrayRef<char> codewordBytes, int numDataCodewords) {
@@ -51,7 +51,7 @@ using zxing::qrcode::FinderPatternInfo;
 using zxing::ResultPoint;
 
 Detector::Detector(Ref<BitMatrix> image) :
-  image_(image) {
+  image_(image), expectedDimension_(0) {
 }
 
 Ref<BitMatrix> Detector::getImage() const {
@@ -64,11 +64,26 @@ Ref<ResultPointCallback> Detector::getResultPointCallback() const {
 
 Ref<DetectorResult> Detector::detect(DecodeHints const& hints) {
   callback_ = hints.getResultPointCallback();
+  expectedDimension_ = hints.getSymbolDimension();
   FinderPatternFinder finder(image_, hints.getResultPointCallback());
   Ref<FinderPatternInfo> info(finder.find(hints));
   return processFinderPatternInfo(info);
 }
 
+Ref<DetectorResult> Detector::detect(DecodeHints const& hints, Ref<BitMatrix> coarse, int scale) {
+  callback_ = hints.getResultPointCallback();
+  expectedDimension_ = hints.getSymbolDimension();
+  FinderPatternFinder coarseFinder(coarse, Ref<ResultPointCallback>());
+  Ref<FinderPatternInfo> coarseInfo(coarseFinder.find(hints.scaleDown(scale)));
+  FinderPatternFinder finder(image_, callback_);
+  std::vector<Ref<FinderPattern> > patterns;
+  patterns.push_back(finder.findNear(coarseInfo->getBottomLeft(), scale));
+  patterns.push_back(finder.findNear(coarseInfo->getTopLeft(), scale));
+  patterns.push_back(finder.findNear(coarseInfo->getTopRight(), scale));
+  Ref<FinderPatternInfo> info(new FinderPatternInfo(patterns));
+  return processFinderPatternInfo(info);
+}
+
 Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> info){
   Ref<FinderPattern> topLeft(info->getTopLeft());
   Ref<FinderPattern> topRight(info->getTopRight());
@@ -78,7 +93,14 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
   if (moduleSize < 1.0f) {
     throw zxing::ReaderException("bad module size");
   }
-  int dimension = computeDimension(topLeft, topRight, bottomLeft, moduleSize);
+  int dimension;
+  if ((expectedDimension_ & 0x03) == 1) {
+    // The caller knows the symbol size, which beats estimating it from the
+    // distances between finder patterns.
+    dimension = expectedDimension_;
+  } else {
+    dimension = computeDimension(topLeft, topRight, bottomLeft, moduleSize);
+  }
   Version *provisionalVersion = Version::getProvisionalVersionForDimension(dimension);
   int modulesBetweenFPCenters = provisionalVersion->getDimensionForVersion() - 7;
 
@@ -117,7 +139,7 @@ Ref<DetectorResult> Detector::processFinderPatternInfo(Ref<FinderPatternInfo> in
 
   Ref<PerspectiveTransform> transform = createTransform(topLeft, topRight, bottomLeft, alignmentPattern, dimension);
   Ref<BitMatrix> bits(sampleGrid(image_, dimension, transform));
-  ArrayRef< Ref<ResultPoint> > points(new Array< Ref<ResultPoint> >(alignmentPattern == 0 ? 3 : 4));
+  ArrayRef< Ref<ResultPoint> > points(alignmentPattern == 0 ? 3 : 4);
   points[0].reset(bottomLeft);
   points[1].reset(topLeft);
   points[2].reset(topRight);
@@ -39,6 +39,7 @@ class Detector : public Counted {
 private:
   Ref<BitMatrix> image_;
   Ref<ResultPointCallback> callback_;
+  int expectedDimension_;
 
 protected:
   Ref<BitMatrix> getImage() const;
@@ -60,6 +61,9 @@ public:
 
   Detector(Ref<BitMatrix> image);
   Ref<DetectorResult> detect(DecodeHints const& hints);
+  // Finds the finder patterns on coarse, this image scaled down by scale,
+  // and does everything else here.
+  Ref<DetectorResult> detect(DecodeHints const& hints, Ref<BitMatrix> coarse, int scale);
 
 
 };
@@ -236,6 +236,10 @@ float FinderPatternFinder::crossCheckHorizontal(size_t startJ, size_t centerI, i
 
 bool FinderPatternFinder::handlePossibleCenter(int* stateCount, size_t i, size_t j) {
   int stateCountTotal = stateCount[0] + stateCount[1] + stateCount[2] + stateCount[3] + stateCount[4];
+  if ((minModuleSize_ > 0 && stateCountTotal < 7 * minModuleSize_) ||
+      (maxModuleSize_ > 0 && stateCountTotal > 7 * maxModuleSize_)) {
+    return false;
+  }
   float centerJ = centerFromEnd(stateCount, (int) j);
   float centerI = crossCheckVertical(i, (size_t)centerJ, stateCount[2], stateCountTotal);
   if (!isnan(centerI)) {
@@ -425,14 +429,20 @@ float FinderPatternFinder::distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2) {
 
 FinderPatternFinder::FinderPatternFinder(Ref<BitMatrix> image,
                                            Ref<ResultPointCallback>const& callback) :
-    image_(image), possibleCenters_(), hasSkipped_(false), callback_(callback) {
+    image_(image), possibleCenters_(), hasSkipped_(false), callback_(callback),
+    minModuleSize_(0), maxModuleSize_(0) {
 }
 
 Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
   bool tryHarder = hints.getTryHarder();
 
-  size_t maxI = image_->getHeight();
-  size_t maxJ = image_->getWidth();
+  int left, top, right, bottom;
+  hints.getRegionOfInterest(image_->getWidth(), image_->getHeight(), left, top, right, bottom);
+  size_t maxI = bottom;
+  size_t minJ = left;
+  size_t maxJ = right;
+  minModuleSize_ = hints.getMinModuleSize();
+  maxModuleSize_ = hints.getMaxModuleSize();
 
 
   // We are looking for black/white/black/white/black modules in
@@ -448,15 +458,19 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
   // modules in size. This gives the smallest number of pixels the center
   // could be, so skip this often. When trying harder, look for all
   // QR versions regardless of how dense they are.
-  int iSkip = (3 * (int) maxI) / (4 * MAX_MODULES);
+  int iSkip = (3 * (bottom - top)) / (4 * MAX_MODULES);
   if (iSkip < MIN_SKIP || tryHarder) {
       iSkip = MIN_SKIP;
   }
+  // A known minimum module size bounds the center directly.
+  if (minModuleSize_ > 0) {
+    iSkip = std::max(MIN_SKIP, (int) (3 * minModuleSize_));
+  }
 
   // This is slightly faster than using the Ref. Efficiency is important here
   BitMatrix& matrix = *image_;
 
-  for (size_t i = iSkip - 1; i < maxI && !done; i += iSkip) {
+  for (size_t i = top + iSkip - 1; i < maxI && !done; i += iSkip) {
     // Get a row of black/white values
 
     stateCount[0] = 0;
@@ -465,7 +479,7 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
     stateCount[3] = 0;
     stateCount[4] = 0;
     int currentState = 0;
-    for (size_t j = 0; j < maxJ; j++) {
+    for (size_t j = minJ; j < maxJ; j++) {
       if (matrix.get((int) j, (int) i)) {
         // Black pixel
         if ((currentState & 1) == 1) { // Counting white pixels
@@ -550,6 +564,32 @@ Ref<FinderPatternInfo> FinderPatternFinder::find(DecodeHints const& hints) {
   return result;
 }
 
+Ref<FinderPattern> FinderPatternFinder::findNear(Ref<FinderPattern> const& pattern, int scale) {
+  float moduleSize = pattern->getEstimatedModuleSize() * scale;
+  float x = pattern->getX() * scale;
+  float y = pattern->getY() * scale;
+  int total = (int) (7 * moduleSize + 0.5f);
+  // Allow for the center being off by up to a pixel of the smaller image.
+  int maxCount = (int) (3 * moduleSize) + scale;
+  size_t centerJ = (size_t) std::min(x, (float) (image_->getWidth() - 1));
+  size_t centerI = (size_t) std::min(y, (float) (image_->getHeight() - 1));
+  float foundI = crossCheckVertical(centerI, centerJ, maxCount, total);
+  if (!isnan(foundI)) {
+    float foundJ = crossCheckHorizontal(centerJ, (size_t) foundI, maxCount, total);
+    if (!isnan(foundJ)) {
+      // The first vertical check was made off center.
+      float recheckedI = crossCheckVertical((size_t) foundI, (size_t) foundJ, maxCount, total);
+      x = foundJ;
+      y = isnan(recheckedI) ? foundI : recheckedI;
+    }
+  }
+  Ref<FinderPattern> result(new FinderPattern(x, y, moduleSize));
+  if (callback_ != 0) {
+    callback_->foundPossibleResultPoint(*result);
+  }
+  return result;
+}
+
 Ref<BitMatrix> FinderPatternFinder::getImage() {
   return image_;
 }
@@ -48,6 +48,9 @@ protected:
 
   Ref<ResultPointCallback> callback_;
 
+  float minModuleSize_;
+  float maxModuleSize_;
+
   /** stateCount must be int[5] */
   static float centerFromEnd(int* stateCount, int end);
   static bool foundPatternCross(int* stateCount);
@@ -69,6 +72,10 @@ public:
   static float distance(Ref<ResultPoint> p1, Ref<ResultPoint> p2);
   FinderPatternFinder(Ref<BitMatrix> image, Ref<ResultPointCallback>const&);
   Ref<FinderPatternInfo> find(DecodeHints const& hints);
+  // Re-centers a pattern found on this image scaled down by scale, by
+  // cross-checking around where it lands here. Returns the pattern merely
+  // scaled up if the cross-checks fail.
+  Ref<FinderPattern> findNear(Ref<FinderPattern> const& pattern, int scale);
 };
 }
 }
@@ -0,0 +1,74 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  StaticMultiFormatReaderTest.cpp
+ *  zxing
+ *
+ *  Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StaticMultiFormatReaderTest.h"
+#include <zxing/StaticMultiFormatReader.h>
+#include <zxing/NotFoundException.h>
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StaticMultiFormatReaderTest);
+
+namespace {
+
+class FailingReader : public Reader {
+public:
+  Ref<Result> decode(Ref<BinaryBitmap>, DecodeHints) {
+    throw NotFoundException();
+  }
+};
+
+template<BarcodeFormat::Value format>
+class FixedReader : public Reader {
+public:
+  Ref<Result> decode(Ref<BinaryBitmap>, DecodeHints) {
+    return Ref<Result>(new Result(Ref<String>(new String("")), ArrayRef<char>(),
+                                  ArrayRef< Ref<ResultPoint> >(), format));
+  }
+};
+
+}
+
+void StaticMultiFormatReaderTest::testFirstMatchWins() {
+  StaticMultiFormatReader<FixedReader<BarcodeFormat::QR_CODE>,
+                          FixedReader<BarcodeFormat::AZTEC> > reader;
+  Ref<Result> result = reader.decode(Ref<BinaryBitmap>());
+  CPPUNIT_ASSERT_EQUAL(BarcodeFormat::QR_CODE, result->getBarcodeFormat().value);
+}
+
+void StaticMultiFormatReaderTest::testFallsThrough() {
+  StaticMultiFormatReader<FailingReader, FailingReader,
+                          FixedReader<BarcodeFormat::PDF_417> > reader;
+  Ref<Result> result = reader.decode(Ref<BinaryBitmap>(), DecodeHints::DEFAULT_HINT);
+  CPPUNIT_ASSERT_EQUAL(BarcodeFormat::PDF_417, result->getBarcodeFormat().value);
+}
+
+void StaticMultiFormatReaderTest::testNothingFound() {
+  StaticMultiFormatReader<FailingReader, FailingReader> reader;
+  try {
+    reader.decode(Ref<BinaryBitmap>());
+    CPPUNIT_FAIL("Should have thrown an exception");
+  } catch (ReaderException const& re) {
+    // good
+    (void)re;
+  }
+}
+
+}
@@ -0,0 +1,43 @@
+#ifndef __STATIC_MULTI_FORMAT_READER_TEST_H__
+#define __STATIC_MULTI_FORMAT_READER_TEST_H__
+
+/*
+ *  StaticMultiFormatReaderTest.h
+ *  zxing
+ *
+ *  Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+namespace zxing {
+
+class StaticMultiFormatReaderTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(StaticMultiFormatReaderTest);
+  CPPUNIT_TEST(testFirstMatchWins);
+  CPPUNIT_TEST(testFallsThrough);
+  CPPUNIT_TEST(testNothingFound);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testFirstMatchWins();
+  void testFallsThrough();
+  void testNothingFound();
+};
+
+}
+
+#endif // __STATIC_MULTI_FORMAT_READER_TEST_H__
@@ -0,0 +1,79 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ArrayTest.h"
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ArrayTest);
+
+namespace {
+class Element : public Counted {
+};
+}
+
+void ArrayTest::testInline() {
+  ArrayRef<int> array(5);
+  char* header = reinterpret_cast<char*>(array.array_);
+  char* values = reinterpret_cast<char*>(&array[0]);
+  CPPUNIT_ASSERT(values > header);
+  CPPUNIT_ASSERT(values < header + sizeof(Array<int>) + 16);
+  for (int i = 0; i < 5; i++) {
+    CPPUNIT_ASSERT_EQUAL(0, array[i]);
+  }
+  int const ts[] = {3, 1, 4};
+  ArrayRef<int> copy(const_cast<int*>(ts), 3);
+  CPPUNIT_ASSERT_EQUAL(3, copy->size());
+  CPPUNIT_ASSERT_EQUAL(4, copy[2]);
+}
+
+void ArrayTest::testValues() {
+  ArrayRef<int> array(4);
+  Span<int> values = array->values();
+  CPPUNIT_ASSERT_EQUAL(4, values.size());
+  CPPUNIT_ASSERT_EQUAL(4, (int) (values.end() - values.begin()));
+  values[2] = 7;
+  CPPUNIT_ASSERT_EQUAL(7, array[2]);
+  CPPUNIT_ASSERT(Array<int>().values().empty());
+}
+
+void ArrayTest::testAssign() {
+  ArrayRef<int> small(2);
+  small[1] = 9;
+  ArrayRef<int> large(new Array<int>(1, 6));
+  *small = *large;
+  CPPUNIT_ASSERT_EQUAL(6, small->size());
+  for (int i = 0; i < 6; i++) {
+    CPPUNIT_ASSERT_EQUAL(1, small[i]);
+  }
+  *large = Array<int>(3);
+  CPPUNIT_ASSERT_EQUAL(3, large->size());
+  CPPUNIT_ASSERT_EQUAL(0, large[2]);
+}
+
+void ArrayTest::testReleasesElements() {
+  Ref<Element> element(new Element());
+  {
+    ArrayRef< Ref<Element> > array(3);
+    array[0] = element;
+    array[2] = element;
+    CPPUNIT_ASSERT_EQUAL(3, element->count());
+  }
+  CPPUNIT_ASSERT_EQUAL(1, element->count());
+}
+
+}
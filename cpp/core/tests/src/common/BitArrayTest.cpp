@@ -66,7 +66,7 @@ void BitArrayTest::testGetArray() {
   BitArray array(2 * bits);
   array.set(0);
   array.set(2 * bits - 1);
-  vector<int> words(array.getBitArray());
+  Span<int> words(array.getBitArray());
   CPPUNIT_ASSERT_EQUAL(1, words[0]);
   CPPUNIT_ASSERT_EQUAL((1 << (bits - 1)), words[1]);
 }
@@ -105,6 +105,18 @@ void BitArrayTest::fillRandom(BitArray& test, BitArray& reference) {
   }
 }
 
+void BitArrayTest::testSetRange() {
+  const int bits = BitArray::bitsPerWord;
+  BitArray array(3 * bits);
+  array.setRange(bits - 2, 2 * bits + 1);
+  array.setRange(5, 5);
+  for (int i = 0; i < 3 * bits; i++) {
+    CPPUNIT_ASSERT_EQUAL(i >= bits - 2 && i < 2 * bits + 1, array.get(i));
+  }
+  array.setRange(0, 3 * bits);
+  CPPUNIT_ASSERT_EQUAL(true, array.isRange(0, 3 * bits, true));
+}
+
 void BitArrayTest::testReverseHalves() {
   // one word test, split in half
   {
@@ -212,5 +224,19 @@ void BitArrayTest::testReverseReverse() {
     CPPUNIT_ASSERT_EQUAL(test.get(i), reference.get(i));
   }
 }
+void BitArrayTest::testInvert() {
+  const int bits = BitArray::bitsPerWord + 5;
+  BitArray array(bits);
+  for (int i = 0; i < bits; i += 3) {
+    array.set(i);
+  }
+  array.invert();
+  for (int i = 0; i < bits; i++) {
+    CPPUNIT_ASSERT_EQUAL(i % 3 != 0, array.get(i));
+  }
+  // Nothing is set past the end.
+  CPPUNIT_ASSERT_EQUAL(bits, array.getNextSet(bits - 1));
+}
+
 }
 
@@ -32,11 +32,13 @@ class BitArrayTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST(testClear);
   CPPUNIT_TEST(testGetArray);
   CPPUNIT_TEST(testIsRange);
+  CPPUNIT_TEST(testSetRange);
   CPPUNIT_TEST(testReverseHalves);
   CPPUNIT_TEST(testReverseEven);
   CPPUNIT_TEST(testReverseOdd);
   CPPUNIT_TEST(testReverseSweep);
   CPPUNIT_TEST(testReverseReverse);
+  CPPUNIT_TEST(testInvert);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -47,11 +49,13 @@ protected:
   void testClear();
   void testGetArray();
   void testIsRange();
+  void testSetRange();
   void testReverseHalves();
   void testReverseEven();
   void testReverseOdd();
   void testReverseSweep();
   void testReverseReverse();
+  void testInvert();
 
 private:
   static void fillRandom(BitArray& test, BitArray& reference);
@@ -60,6 +60,18 @@ void BitMatrixTest::testSetRegion() {
   }
 }
 
+void BitMatrixTest::testEnclosingRectangle() {
+  BitMatrix matrix(40, 20);
+  CPPUNIT_ASSERT(!matrix.getEnclosingRectangle());
+  matrix.set(35, 3);
+  matrix.setRegion(2, 5, 4, 9);
+  ArrayRef<int> rectangle = matrix.getEnclosingRectangle();
+  CPPUNIT_ASSERT_EQUAL(2, rectangle[0]);
+  CPPUNIT_ASSERT_EQUAL(3, rectangle[1]);
+  CPPUNIT_ASSERT_EQUAL(34, rectangle[2]);
+  CPPUNIT_ASSERT_EQUAL(11, rectangle[3]);
+}
+
 void BitMatrixTest::testGetRow0() {
   const int width = 2;
   const int height = 2;
@@ -102,4 +114,83 @@ void BitMatrixTest::runBitMatrixGetRowTest(int width, int height) {
     }
   }
 }
+namespace {
+
+// Sets the top left pixel of each tile and counts the tiles it fills.
+class CornerTiles : public BitMatrix::TileSource {
+public:
+  int filled;
+
+  CornerTiles() : filled(0) {}
+
+  void fillTile(BitMatrix& matrix, int x, int y) {
+    matrix.set(x << 2, y << 2);
+    filled++;
+  }
+};
+
+}
+
+void BitMatrixTest::testTileSource() {
+  Ref<CornerTiles> tiles (new CornerTiles());
+  BitMatrix matrix(10, 9, 2, tiles);
+  CPPUNIT_ASSERT_EQUAL(9, matrix.getTileCount());
+  CPPUNIT_ASSERT_EQUAL(0, matrix.getFilledTileCount());
+
+  CPPUNIT_ASSERT(matrix.get(4, 4));
+  CPPUNIT_ASSERT(!matrix.get(5, 7));
+  CPPUNIT_ASSERT_EQUAL(1, tiles->filled);
+  CPPUNIT_ASSERT_EQUAL(1, matrix.getFilledTileCount());
+
+  // A row fills the tiles across it, once each.
+  Ref<BitArray> row (matrix.getRow(4, Ref<BitArray>()));
+  CPPUNIT_ASSERT(row->get(0) && row->get(4) && row->get(8));
+  CPPUNIT_ASSERT_EQUAL(3, tiles->filled);
+
+  // Flipping fills the tile first, so that filling it later can't undo it.
+  matrix.flip(0, 8);
+  CPPUNIT_ASSERT(!matrix.get(0, 8));
+  CPPUNIT_ASSERT_EQUAL(4, tiles->filled);
+
+  ArrayRef<int> rectangle (matrix.getEnclosingRectangle());
+  CPPUNIT_ASSERT_EQUAL(9, tiles->filled);
+  CPPUNIT_ASSERT_EQUAL(9, matrix.getFilledTileCount());
+  CPPUNIT_ASSERT_EQUAL(0, rectangle[0]);
+  CPPUNIT_ASSERT_EQUAL(0, rectangle[1]);
+  CPPUNIT_ASSERT_EQUAL(9, rectangle[2]);
+  CPPUNIT_ASSERT_EQUAL(9, rectangle[3]);
+  // Once all tiles are in, the matrix lets go of the source.
+  CPPUNIT_ASSERT_EQUAL(1, tiles->count());
+}
+
+void BitMatrixTest::testInverted() {
+  Ref<BitMatrix> matrix (new BitMatrix(37, 5));
+  matrix->setRegion(3, 1, 33, 3);
+  Ref<BitMatrix> inverted (matrix->inverted());
+  for (int y = 0; y < 5; y++) {
+    for (int x = 0; x < 37; x++) {
+      CPPUNIT_ASSERT_EQUAL(!matrix->get(x, y), inverted->get(x, y));
+    }
+  }
+  // Nothing is set past the right edge.
+  ArrayRef<int> bottomRight (inverted->getBottomRightOnBit());
+  CPPUNIT_ASSERT_EQUAL(36, bottomRight[0]);
+  CPPUNIT_ASSERT_EQUAL(4, bottomRight[1]);
+
+  // Tiles still to fill are filled and flipped as they are read.
+  Ref<CornerTiles> tiles (new CornerTiles());
+  Ref<BitMatrix> lazy (new BitMatrix(10, 9, 2, tiles));
+  inverted = lazy->inverted();
+  CPPUNIT_ASSERT_EQUAL(9, inverted->getTileCount());
+  CPPUNIT_ASSERT(!inverted->get(4, 4));
+  CPPUNIT_ASSERT(inverted->get(5, 7));
+  CPPUNIT_ASSERT_EQUAL(1, tiles->filled);
+  CPPUNIT_ASSERT_EQUAL(1, lazy->getFilledTileCount());
+  Ref<BitArray> row (inverted->getRow(8, Ref<BitArray>()));
+  CPPUNIT_ASSERT(!row->get(0) && !row->get(4) && !row->get(8));
+  CPPUNIT_ASSERT(row->get(1) && row->get(9));
+  CPPUNIT_ASSERT_EQUAL(10, row->getNextSet(9 + 1));
+  CPPUNIT_ASSERT_EQUAL(4, tiles->filled);
+}
+
 }
@@ -33,6 +33,9 @@ class BitMatrixTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST(testGetRow1);
   CPPUNIT_TEST(testGetRow2);
   CPPUNIT_TEST(testGetRow3);
+  CPPUNIT_TEST(testEnclosingRectangle);
+  CPPUNIT_TEST(testTileSource);
+  CPPUNIT_TEST(testInverted);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -45,6 +48,9 @@ protected:
   void testGetRow1();
   void testGetRow2();
   void testGetRow3();
+  void testEnclosingRectangle();
+  void testTileSource();
+  void testInverted();
 
 private:
   void runBitMatrixGetRowTest(int width, int height);
@@ -19,6 +19,7 @@
  */
 
 #include "BitSourceTest.h"
+#include <zxing/common/IllegalArgumentException.h>
 
 namespace zxing {
 
@@ -46,4 +47,47 @@ void BitSourceTest::testSource() {
   CPPUNIT_ASSERT_EQUAL(5, source.readBits(6));
   CPPUNIT_ASSERT_EQUAL(0, source.available());
 }
+
+void BitSourceTest::testLongSource() {
+  // Read codes of every width across many buffer refills and compare with
+  // the bits picked out one at a time.
+  const int size = 61;
+  ArrayRef<byte> bytes(size);
+  for (int i = 0; i < size; i++) {
+    bytes[i] = (byte) (i * 37 + 11);
+  }
+  BitSource source(bytes);
+  int offset = 0;
+  for (int numBits = 1; offset + numBits <= 8 * size; numBits = numBits % 32 + 1) {
+    int expected = 0;
+    for (int i = offset; i < offset + numBits; i++) {
+      expected = (expected << 1) | ((bytes[i / 8] >> (7 - i % 8)) & 1);
+    }
+    CPPUNIT_ASSERT_EQUAL(expected, source.readBits(numBits));
+    offset += numBits;
+    CPPUNIT_ASSERT_EQUAL(8 * size - offset, source.available());
+    CPPUNIT_ASSERT_EQUAL(offset / 8, source.getByteOffset());
+    CPPUNIT_ASSERT_EQUAL(offset % 8, source.getBitOffset());
+  }
+}
+
+void BitSourceTest::testPeek() {
+  byte rawBytes[] = {(byte) 0xA5, (byte) 0xF0};
+  ArrayRef<byte> bytes(rawBytes, 2);
+  BitSource source(bytes);
+  CPPUNIT_ASSERT_EQUAL(0xA, source.peekBits(4));
+  CPPUNIT_ASSERT_EQUAL(0xA, source.peekBits(4));
+  source.skipBits(4);
+  CPPUNIT_ASSERT_EQUAL(12, source.available());
+  CPPUNIT_ASSERT_EQUAL(0x5F, source.readBits(8));
+  // bits past the end peek as zero
+  CPPUNIT_ASSERT_EQUAL(0x0, source.peekBits(8));
+  CPPUNIT_ASSERT_EQUAL(0x0, source.readBits(4));
+  try {
+    source.readBits(1);
+    CPPUNIT_FAIL("expected IllegalArgumentException");
+  } catch (IllegalArgumentException const& expected) {
+    (void)expected;
+  }
+}
 }
@@ -28,12 +28,16 @@ namespace zxing {
 class BitSourceTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST_SUITE(BitSourceTest);
   CPPUNIT_TEST(testSource);
+  CPPUNIT_TEST(testLongSource);
+  CPPUNIT_TEST(testPeek);
   CPPUNIT_TEST_SUITE_END();
 
 public:
 
 protected:
   void testSource();
+  void testLongSource();
+  void testPeek();
 
 private:
 };
@@ -34,7 +34,27 @@ public:
   }
 };
 
-//CPPUNIT_TEST_SUITE_REGISTRATION(CountedTest);
+class Bar : public Foo {
+};
+
+class Tracked : public Counted {
+public:
+  Tracked(bool& deleted) : deleted_(deleted) {
+  }
+  ~Tracked() {
+    deleted_ = true;
+  }
+private:
+  bool& deleted_;
+};
+
+namespace {
+int countOf(RefView<Foo> view) {
+  return view->count();
+}
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(CountedTest);
 
 void CountedTest::setUp() {}
 void CountedTest::tearDown() {}
@@ -55,4 +75,28 @@ void CountedTest::test() {
   CPPUNIT_ASSERT_EQUAL(1, foobar->count());
 }
 
+void CountedTest::testRefView() {
+  Ref<Bar> bar(new Bar);
+  CPPUNIT_ASSERT_EQUAL(1, countOf(bar));
+  RefView<Foo> view(bar);
+  CPPUNIT_ASSERT(!view.empty());
+  CPPUNIT_ASSERT_EQUAL(1, view->count());
+  CPPUNIT_ASSERT(RefView<Foo>(0).empty());
+}
+
+void CountedTest::testPermanent() {
+  bool deleted = false;
+  Tracked* tracked = new Tracked(deleted);
+  {
+    Ref<Tracked> ref(tracked);
+    tracked->makePermanent();
+    int count = tracked->count();
+    Ref<Tracked> secondRef(ref);
+    CPPUNIT_ASSERT_EQUAL(count, tracked->count());
+  }
+  CPPUNIT_ASSERT(!deleted);
+  delete tracked;
+  CPPUNIT_ASSERT(deleted);
+}
+
 }
@@ -30,6 +30,8 @@ namespace zxing {
 class CountedTest : public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(CountedTest);
   CPPUNIT_TEST(test);
+  CPPUNIT_TEST(testRefView);
+  CPPUNIT_TEST(testPermanent);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -38,6 +40,8 @@ public:
 
 protected:
   void test();
+  void testRefView();
+  void testPermanent();
 
 private:
 };
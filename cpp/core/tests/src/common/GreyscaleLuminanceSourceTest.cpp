@@ -0,0 +1,185 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GreyscaleLuminanceSourceTest.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/common/GreyscaleRotatedLuminanceSource.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <ctime>
+#include <iostream>
+
+using namespace std;
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(GreyscaleLuminanceSourceTest);
+
+namespace {
+
+double elapsedUsec(clock_t start) {
+  return double(clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+}
+
+ArrayRef<char> makeImage(int width, int height) {
+  ArrayRef<char> pixels (width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      pixels[y * width + x] = char(x * 7 + y * 13 + (x ^ y));
+    }
+  }
+  return pixels;
+}
+
+// Reads every row of source, the way a full 1D scan would.
+int readAllRows(LuminanceSource const& source) {
+  ArrayRef<char> row;
+  int sum = 0;
+  for (int y = 0; y < source.getHeight(); y++) {
+    row = source.getRow(y, row);
+    sum += row[y % source.getWidth()];
+  }
+  return sum;
+}
+
+}
+
+void GreyscaleLuminanceSourceTest::testRotateCounterClockwise() {
+  // Sizes that are not a multiple of the 8 pixel tiles, cropped out of a
+  // larger image.
+  const int dataWidth = 45;
+  const int dataHeight = 30;
+  const int left = 3;
+  const int top = 2;
+  const int width = 37;
+  const int height = 27;
+  ArrayRef<char> pixels = makeImage(dataWidth, dataHeight);
+  GreyscaleLuminanceSource source(pixels, dataWidth, dataHeight, left, top, width, height);
+  Ref<LuminanceSource> rotated = source.rotateCounterClockwise();
+
+  CPPUNIT_ASSERT_EQUAL(height, rotated->getWidth());
+  CPPUNIT_ASSERT_EQUAL(width, rotated->getHeight());
+  ArrayRef<char> row;
+  for (int y = 0; y < width; y++) {
+    row = rotated->getRow(y, row);
+    for (int x = 0; x < height; x++) {
+      CPPUNIT_ASSERT_EQUAL(pixels[(top + x) * dataWidth + left + width - 1 - y], row[x]);
+    }
+  }
+}
+
+void GreyscaleLuminanceSourceTest::testRotatedBitmapIsKept() {
+  Ref<LuminanceSource> source (new GreyscaleLuminanceSource(makeImage(40, 30), 40, 30, 0, 0, 40, 30));
+  Ref<BinaryBitmap> image (new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(source))));
+  Ref<BinaryBitmap> rotated = image->rotateCounterClockwise();
+  CPPUNIT_ASSERT_EQUAL(30, rotated->getWidth());
+  CPPUNIT_ASSERT_EQUAL(40, rotated->getHeight());
+  CPPUNIT_ASSERT(rotated.object_ == image->rotateCounterClockwise().object_);
+}
+
+void GreyscaleLuminanceSourceTest::testRotatedRowTime() {
+  // Reading the columns of a 1080p frame as rows: straight off the
+  // unrotated pixels, and after rotating them all up front.
+  const int width = 1920;
+  const int height = 1080;
+  ArrayRef<char> pixels = makeImage(width, height);
+  GreyscaleLuminanceSource source(pixels, width, height, 0, 0, width, height);
+  GreyscaleRotatedLuminanceSource columns(pixels, width, height, 0, 0, height, width);
+
+  clock_t start = clock();
+  int columnSum = readAllRows(columns);
+  double columnTime = elapsedUsec(start);
+
+  start = clock();
+  Ref<LuminanceSource> rotated = source.rotateCounterClockwise();
+  double rotateTime = elapsedUsec(start);
+  start = clock();
+  int rotatedSum = readAllRows(*rotated);
+  double rowTime = elapsedUsec(start);
+
+  CPPUNIT_ASSERT_EQUAL(columnSum, rotatedSum);
+  ArrayRef<char> expected = columns.getRow(width / 3, ArrayRef<char>());
+  ArrayRef<char> actual = rotated->getRow(width / 3, ArrayRef<char>());
+  for (int x = 0; x < height; x++) {
+    CPPUNIT_ASSERT_EQUAL(expected[x], actual[x]);
+  }
+
+  cout << endl << "rotated rows: " << columnTime << " us reading columns, "
+       << rotateTime << " us rotating and " << rowTime << " us reading rows" << endl;
+}
+
+void GreyscaleLuminanceSourceTest::testScaleDown() {
+  const int dataWidth = 45;
+  const int dataHeight = 30;
+  const int left = 3;
+  const int top = 2;
+  const int width = 37;
+  const int height = 27;
+  ArrayRef<char> pixels = makeImage(dataWidth, dataHeight);
+  GreyscaleLuminanceSource source(pixels, dataWidth, dataHeight, left, top, width, height);
+  // The generic version, which reads the rows one by one.
+  GreyscaleRotatedLuminanceSource columns(pixels, dataWidth, dataHeight, 0, 0, dataHeight, dataWidth);
+  Ref<LuminanceSource> halves[] = {source.scaleDown(), columns.scaleDown()};
+
+  for (int i = 0; i < 2; i++) {
+    LuminanceSource const& unscaled = i == 0 ? (LuminanceSource const&) source : columns;
+    CPPUNIT_ASSERT_EQUAL(unscaled.getWidth() / 2, halves[i]->getWidth());
+    CPPUNIT_ASSERT_EQUAL(unscaled.getHeight() / 2, halves[i]->getHeight());
+    ArrayRef<char> row;
+    ArrayRef<char> above;
+    ArrayRef<char> below;
+    for (int y = 0; y < halves[i]->getHeight(); y++) {
+      row = halves[i]->getRow(y, row);
+      above = unscaled.getRow(2 * y, above);
+      below = unscaled.getRow(2 * y + 1, below);
+      for (int x = 0; x < halves[i]->getWidth(); x++) {
+        int sum = (above[2 * x] & 0xFF) + (above[2 * x + 1] & 0xFF) +
+          (below[2 * x] & 0xFF) + (below[2 * x + 1] & 0xFF);
+        CPPUNIT_ASSERT_EQUAL((sum + 2) / 4, row[x] & 0xFF);
+      }
+    }
+  }
+}
+
+void GreyscaleLuminanceSourceTest::testCoarseLevels() {
+  Ref<LuminanceSource> small (new GreyscaleLuminanceSource(makeImage(640, 480), 640, 480, 0, 0, 640, 480));
+  Ref<BinaryBitmap> image (new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(small))));
+  int scale;
+  CPPUNIT_ASSERT(image->getCoarseLevel(scale).object_ == image.object_);
+  CPPUNIT_ASSERT_EQUAL(1, scale);
+
+  const int width = 4000;
+  const int height = 2000;
+  Ref<LuminanceSource> source (new GreyscaleLuminanceSource(makeImage(width, height), width, height,
+                                                            0, 0, width, height));
+  image = new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(source)));
+  Ref<BinaryBitmap> coarse = image->getCoarseLevel(scale);
+  CPPUNIT_ASSERT_EQUAL(4, scale);
+  CPPUNIT_ASSERT_EQUAL(width / 4, coarse->getWidth());
+  CPPUNIT_ASSERT_EQUAL(height / 4, coarse->getHeight());
+  CPPUNIT_ASSERT(coarse.object_ == image->getCoarseLevel(scale).object_);
+
+  // Only the tiles read are thresholded at full size, with no black points
+  // of their own.
+  Ref<BitMatrix> fine = image->getFineBlackMatrix();
+  CPPUNIT_ASSERT_EQUAL(width, fine->getWidth());
+  CPPUNIT_ASSERT_EQUAL(height, fine->getHeight());
+  fine->get(width - 1, height - 1);
+  CPPUNIT_ASSERT_EQUAL(1, fine->getFilledTileCount());
+  CPPUNIT_ASSERT(fine.object_ == image->getFineBlackMatrix().object_);
+}
+
+}
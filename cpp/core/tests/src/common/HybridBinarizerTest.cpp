@@ -0,0 +1,251 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HybridBinarizerTest.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <ctime>
+#include <iostream>
+#include <stdlib.h>
+
+using namespace std;
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(HybridBinarizerTest);
+
+namespace {
+
+double elapsedUsec(clock_t start) {
+  return double(clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+}
+
+// Flat areas, which take their black points from their neighbours,
+// gradients and noise.
+ArrayRef<char> makeImage(int width, int height) {
+  ArrayRef<char> pixels (width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int value;
+      if (x < width / 3) {
+        value = y < height / 2 ? 200 : 190 + (x + y) % 3;
+      } else if (y < height / 3) {
+        value = x * 255 / width;
+      } else {
+        value = rand() % 256;
+      }
+      pixels[y * width + x] = char(value);
+    }
+  }
+  return pixels;
+}
+
+Ref<LuminanceSource> makeSource(ArrayRef<char> const& pixels, int width, int height) {
+  return Ref<LuminanceSource>(
+    new GreyscaleLuminanceSource(pixels, width, height, 0, 0, width, height));
+}
+
+// HybridBinarizer as it was before it thresholded tiles on demand.
+vector<bool> binarizeWholeFrame(ArrayRef<char> const& pixels, int width, int height) {
+  int subWidth = (width + 7) >> 3;
+  int subHeight = (height + 7) >> 3;
+  vector<int> blackPoints (subWidth * subHeight);
+  for (int y = 0; y < subHeight; y++) {
+    int yoffset = min(y << 3, height - 8);
+    for (int x = 0; x < subWidth; x++) {
+      int xoffset = min(x << 3, width - 8);
+      int sum = 0;
+      int minimum = 0xFF;
+      int maximum = 0;
+      for (int yy = 0; yy < 8; yy++) {
+        for (int xx = 0; xx < 8; xx++) {
+          int pixel = pixels[(yoffset + yy) * width + xoffset + xx] & 0xFF;
+          sum += pixel;
+          minimum = min(minimum, pixel);
+          maximum = max(maximum, pixel);
+        }
+      }
+      int average = sum >> 6;
+      if (maximum - minimum <= 24) {
+        average = minimum >> 1;
+        if (y > 0 && x > 0) {
+          int bp = (blackPoints[(y - 1) * subWidth + x] +
+                    2 * blackPoints[y * subWidth + x - 1] +
+                    blackPoints[(y - 1) * subWidth + x - 1]) >> 2;
+          if (minimum < bp) {
+            average = bp;
+          }
+        }
+      }
+      blackPoints[y * subWidth + x] = average;
+    }
+  }
+  vector<bool> black (width * height);
+  for (int y = 0; y < subHeight; y++) {
+    int yoffset = min(y << 3, height - 8);
+    for (int x = 0; x < subWidth; x++) {
+      int xoffset = min(x << 3, width - 8);
+      int left = max(2, min(x, subWidth - 3));
+      int top = max(2, min(y, subHeight - 3));
+      int sum = 0;
+      for (int z = -2; z <= 2; z++) {
+        for (int w = -2; w <= 2; w++) {
+          sum += blackPoints[(top + z) * subWidth + left + w];
+        }
+      }
+      for (int yy = 0; yy < 8; yy++) {
+        for (int xx = 0; xx < 8; xx++) {
+          int offset = (yoffset + yy) * width + xoffset + xx;
+          if ((pixels[offset] & 0xFF) <= sum / 25) {
+            black[offset] = true;
+          }
+        }
+      }
+    }
+  }
+  return black;
+}
+
+}
+
+void HybridBinarizerTest::testMatchesWholeFrame() {
+  srand(44);
+  int const sizes[][2] = {{40, 40}, {61, 53}, {203, 97}, {123, 301}};
+  for (int i = 0; i < 4; i++) {
+    int width = sizes[i][0];
+    int height = sizes[i][1];
+    ArrayRef<char> pixels (makeImage(width, height));
+    vector<bool> expected (binarizeWholeFrame(pixels, width, height));
+    HybridBinarizer binarizer(makeSource(pixels, width, height));
+    Ref<BitMatrix> matrix (binarizer.getBlackMatrix());
+    // Read the tiles in no particular order, so that black points are
+    // worked out before their neighbours above and to the left.
+    for (int n = 0; n < width * height; n++) {
+      int offset = n * 7919 % (width * height);
+      CPPUNIT_ASSERT_EQUAL((bool) expected[offset],
+                           matrix->get(offset % width, offset / width));
+    }
+    CPPUNIT_ASSERT_EQUAL(matrix->getTileCount(), matrix->getFilledTileCount());
+  }
+}
+
+void HybridBinarizerTest::testFillsWhatIsRead() {
+  int const width = 640;
+  int const height = 480;
+  ArrayRef<char> pixels (makeImage(width, height));
+  Ref<LuminanceSource> source (makeSource(pixels, width, height));
+
+  clock_t start = clock();
+  HybridBinarizer region(source);
+  Ref<BitMatrix> matrix (region.getBlackMatrix());
+  int black = 0;
+  for (int y = 200; y < 264; y++) {
+    for (int x = 296; x < 360; x++) {
+      black += matrix->get(x, y);
+    }
+  }
+  double regionTime = elapsedUsec(start);
+  CPPUNIT_ASSERT_EQUAL(80 * 60, matrix->getTileCount());
+  CPPUNIT_ASSERT_EQUAL(8 * 8, matrix->getFilledTileCount());
+
+  start = clock();
+  HybridBinarizer frame(source);
+  frame.getBlackMatrix()->getEnclosingRectangle();
+  double frameTime = elapsedUsec(start);
+  CPPUNIT_ASSERT_EQUAL(80 * 60, frame.getBlackMatrix()->getFilledTileCount());
+
+  cout << endl << "hybrid binarizer: " << regionTime << " us for a 64x64 region, "
+       << frameTime << " us for the whole " << width << "x" << height << " frame" << endl;
+  (void) black;
+}
+
+void HybridBinarizerTest::testReusesBlackPoints() {
+  srand(45);
+  int const width = 160;
+  int const height = 120;
+  int const blocks = 20 * 15;
+  // Noise has enough contrast everywhere for each black point to depend on
+  // its own block alone.
+  ArrayRef<char> first (width * height);
+  for (int i = 0; i < width * height; i++) {
+    first[i] = char(rand() % 256);
+  }
+  ArrayRef<char> second (width * height);
+  for (int y = 0; y < height; y++) {
+    for (int x = 0; x < width; x++) {
+      int pixel = first[y * width + x] & 0xFF;
+      if (x >= 64 && x < 80 && y >= 48 && y < 64) {
+        pixel >>= 1;
+      }
+      second[y * width + x] = char(pixel);
+    }
+  }
+
+  Ref<BlackPointHistory> history (new BlackPointHistory());
+  ArrayRef<char> const frames[] = {first, first, second};
+  int const computed[] = {blocks, 0, 4};
+  for (int i = 0; i < 3; i++) {
+    vector<bool> expected (binarizeWholeFrame(frames[i], width, height));
+    history->resetCounts();
+    HybridBinarizer binarizer(makeSource(frames[i], width, height), history);
+    Ref<BitMatrix> matrix (binarizer.getBlackMatrix());
+    for (int y = 0; y < height; y++) {
+      for (int x = 0; x < width; x++) {
+        CPPUNIT_ASSERT_EQUAL((bool) expected[y * width + x], matrix->get(x, y));
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(computed[i], history->getComputedCount());
+    CPPUNIT_ASSERT_EQUAL(blocks - computed[i], history->getReusedCount());
+  }
+  CPPUNIT_ASSERT(history->getReuseRatio() > 0.98f);
+
+  // A frame of another size starts afresh.
+  history->resetCounts();
+  Ref<LuminanceSource> cropped (
+    new GreyscaleLuminanceSource(first, width, height, 0, 0, width - 8, height));
+  HybridBinarizer other(cropped, history);
+  other.getBlackMatrix()->getEnclosingRectangle();
+  CPPUNIT_ASSERT_EQUAL(0, history->getReusedCount());
+}
+
+void HybridBinarizerTest::testInvert() {
+  int const width = 203;
+  int const height = 97;
+  ArrayRef<char> pixels (makeImage(width, height));
+  Ref<BinaryBitmap> bitmap (new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(makeSource(pixels, width, height)))));
+  Ref<BinaryBitmap> inverted (bitmap->invert());
+  CPPUNIT_ASSERT_EQUAL(255 - (pixels[0] & 0xFF),
+                       inverted->getLuminanceSource()->getRow(0, ArrayRef<char>())[0] & 0xFF);
+
+  // The black matrix is flipped, not binarized again, and only where read.
+  Ref<BitMatrix> matrix (bitmap->getBlackMatrix());
+  Ref<BitMatrix> flipped (inverted->getBlackMatrix());
+  for (int y = 40; y < 48; y++) {
+    for (int x = 104; x < 112; x++) {
+      CPPUNIT_ASSERT_EQUAL(!matrix->get(x, y), flipped->get(x, y));
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(1, matrix->getFilledTileCount());
+
+  Ref<BitArray> row (bitmap->getBlackRow(50, Ref<BitArray>()));
+  Ref<BitArray> flippedRow (inverted->getBlackRow(50, Ref<BitArray>()));
+  for (int x = 0; x < width; x++) {
+    CPPUNIT_ASSERT_EQUAL(!row->get(x), flippedRow->get(x));
+  }
+}
+
+}
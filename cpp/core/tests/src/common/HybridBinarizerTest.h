@@ -0,0 +1,46 @@
+#ifndef __HYBRID_BINARIZER_TEST_H__
+#define __HYBRID_BINARIZER_TEST_H__
+
+/*
+ *  BitMatrixTest.h
+ *  zxing
+ *
+ *  Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/common/HybridBinarizer.h>
+
+namespace zxing {
+
+class HybridBinarizerTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(HybridBinarizerTest);
+  CPPUNIT_TEST(testMatchesWholeFrame);
+  CPPUNIT_TEST(testFillsWhatIsRead);
+  CPPUNIT_TEST(testReusesBlackPoints);
+  CPPUNIT_TEST(testInvert);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testMatchesWholeFrame();
+  void testFillsWhatIsRead();
+  void testReusesBlackPoints();
+  void testInvert();
+};
+
+}
+
+#endif // __HYBRID_BINARIZER_TEST_H__
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ParallelSearchTest.h"
+#include <zxing/common/IllegalArgumentException.h>
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ParallelSearchTest);
+
+namespace {
+
+// Matches every index from first on that is a multiple of step, and throws
+// for failAt.
+class StepTask : public ParallelSearch::Task {
+public:
+  StepTask(int first, int step, int failAt) : first_(first), step_(step), failAt_(failAt) {}
+  bool test(int, int index) {
+    if (index == failAt_) {
+      throw IllegalArgumentException("failed");
+    }
+    return index >= first_ && index % step_ == 0;
+  }
+private:
+  int first_;
+  int step_;
+  int failAt_;
+};
+
+}
+
+void ParallelSearchTest::testFirstMatch() {
+  StepTask task(40, 5, -1);
+  for (int threads = 1; threads <= 4; threads++) {
+    CPPUNIT_ASSERT_EQUAL(40, ParallelSearch::find(task, 1000, threads, 3));
+  }
+  // The match is the last index of the range.
+  CPPUNIT_ASSERT_EQUAL(40, ParallelSearch::find(task, 41, 4, 3));
+}
+
+void ParallelSearchTest::testNoMatch() {
+  StepTask task(40, 5, -1);
+  CPPUNIT_ASSERT_EQUAL(-1, ParallelSearch::find(task, 40, 1, 3));
+  CPPUNIT_ASSERT_EQUAL(-1, ParallelSearch::find(task, 40, 4, 3));
+  CPPUNIT_ASSERT_EQUAL(-1, ParallelSearch::find(task, 0, 4, 3));
+}
+
+void ParallelSearchTest::testException() {
+  // A match before the failing index wins, as it would scanning in order.
+  StepTask early(20, 20, 30);
+  CPPUNIT_ASSERT_EQUAL(20, ParallelSearch::find(early, 1000, 1, 4));
+  CPPUNIT_ASSERT_EQUAL(20, ParallelSearch::find(early, 1000, 4, 4));
+
+  StepTask late(50, 50, 30);
+  for (int threads = 1; threads <= 4; threads *= 4) {
+    try {
+      ParallelSearch::find(late, 1000, threads, 4);
+      CPPUNIT_FAIL("expected IllegalArgumentException");
+    } catch (IllegalArgumentException const& expected) {
+      (void)expected;
+    }
+  }
+}
+
+}
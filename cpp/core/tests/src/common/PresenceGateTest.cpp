@@ -0,0 +1,134 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PresenceGateTest.h"
+#include <zxing/BinaryBitmap.h>
+#include <zxing/MultiFormatReader.h>
+#include <zxing/NotFoundException.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <stdlib.h>
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PresenceGateTest);
+
+namespace {
+
+const int WIDTH = 640;
+const int HEIGHT = 480;
+
+enum Content {
+  BARS,
+  MODULES,
+  GRADIENT,
+  NOISE
+};
+
+// A grey frame with content in a 160 pixel square in the middle: bars 2 to
+// 8 pixels wide, 4 pixel modules, a smooth gradient or faint noise.
+Ref<LuminanceSource> makeSource(Content content) {
+  ArrayRef<char> pixels (WIDTH * HEIGHT);
+  for (int i = 0; i < WIDTH * HEIGHT; i++) {
+    pixels[i] = char(128);
+  }
+  bool dark = true;
+  int barEnd = 0;
+  for (int x = 240; x < 400; x++) {
+    if (x >= barEnd) {
+      dark = !dark;
+      barEnd = x + 2 + 2 * (rand() % 4);
+    }
+    for (int y = 160; y < 320; y++) {
+      int value = 128;
+      switch (content) {
+      case BARS:
+        value = dark ? 30 : 220;
+        break;
+      case MODULES:
+        value = (rand() % 2 == 0 ? 30 : 220);
+        break;
+      case GRADIENT:
+        value = (x - 240) + (y - 160) / 2;
+        break;
+      case NOISE:
+        value = 128 + rand() % 9 - 4;
+        break;
+      }
+      pixels[y * WIDTH + x] = char(value);
+    }
+  }
+  if (content == MODULES) {
+    // Copy the top left pixel of each module over the rest of it.
+    for (int y = 160; y < 320; y++) {
+      for (int x = 240; x < 400; x++) {
+        pixels[y * WIDTH + x] = pixels[(y & ~3) * WIDTH + (x & ~3)];
+      }
+    }
+  }
+  return Ref<LuminanceSource>(
+    new GreyscaleLuminanceSource(pixels, WIDTH, HEIGHT, 0, 0, WIDTH, HEIGHT));
+}
+
+}
+
+void PresenceGateTest::testKeepsBarcodes() {
+  srand(47);
+  PresenceGate gate;
+  CPPUNIT_ASSERT(gate.mayContainBarcode(*makeSource(BARS)));
+  CPPUNIT_ASSERT(gate.mayContainBarcode(*makeSource(MODULES)));
+  // Too small to tell.
+  ArrayRef<char> tiny (12 * 12);
+  CPPUNIT_ASSERT(gate.mayContainBarcode(GreyscaleLuminanceSource(tiny, 12, 12, 0, 0, 12, 12)));
+}
+
+void PresenceGateTest::testSkipsPlainImages() {
+  srand(47);
+  PresenceGate gate;
+  CPPUNIT_ASSERT(!gate.mayContainBarcode(*makeSource(GRADIENT)));
+  CPPUNIT_ASSERT(!gate.mayContainBarcode(*makeSource(NOISE)));
+}
+
+void PresenceGateTest::testThresholds() {
+  srand(47);
+  Ref<LuminanceSource> noise (makeSource(NOISE));
+  PresenceGate gate;
+  gate.setMinGradientEnergy(0);
+  gate.setMinPeriodicity(0.0f);
+  CPPUNIT_ASSERT_EQUAL(0, gate.getMinGradientEnergy());
+  CPPUNIT_ASSERT(gate.mayContainBarcode(*noise));
+  gate.setMinTransitionDensity(1.0f);
+  CPPUNIT_ASSERT(!gate.mayContainBarcode(*noise));
+}
+
+void PresenceGateTest::testReaderFailsEarly() {
+  srand(47);
+  Ref<BinaryBitmap> image (
+    new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(makeSource(GRADIENT)))));
+  MultiFormatReader reader;
+  reader.setPresenceGate(Ref<PresenceGate>(new PresenceGate()));
+  try {
+    reader.decode(image);
+    CPPUNIT_FAIL("decoded an image without a barcode");
+  } catch (NotFoundException const& e) {
+    CPPUNIT_ASSERT_EQUAL(std::string("No barcode-like texture"), std::string(e.what()));
+  }
+  // Nothing was binarized.
+  CPPUNIT_ASSERT_EQUAL(0, image->getBlackMatrix()->getFilledTileCount());
+}
+
+}
@@ -0,0 +1,70 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RegionProposerTest.h"
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RegionProposerTest);
+
+void RegionProposerTest::testFindsRegions() {
+  Ref<BitMatrix> matrix (new BitMatrix(512, 448));
+  // Bars 4 pixels wide over 5 x 2 cells...
+  for (int x = 64; x < 224; x += 8) {
+    matrix->setRegion(x, 64, 4, 64);
+  }
+  // ...and 4 pixel modules over 4 x 4 cells.
+  for (int y = 256; y < 384; y += 4) {
+    for (int x = 320; x < 448; x += 4) {
+      if ((x * 7 + y * 13) % 5 < 2) {
+        matrix->setRegion(x, y, 4, 4);
+      }
+    }
+  }
+
+  std::vector<Ref<CandidateRegion> > regions = RegionProposer(matrix).propose();
+  CPPUNIT_ASSERT_EQUAL(2, (int) regions.size());
+
+  Ref<CandidateRegion> modules = regions[0];
+  CPPUNIT_ASSERT(!modules->isOneDimensional());
+  CPPUNIT_ASSERT_EQUAL(288, modules->getLeft());
+  CPPUNIT_ASSERT_EQUAL(224, modules->getTop());
+  CPPUNIT_ASSERT_EQUAL(480, modules->getRight());
+  CPPUNIT_ASSERT_EQUAL(416, modules->getBottom());
+
+  Ref<CandidateRegion> bars = regions[1];
+  CPPUNIT_ASSERT(bars->isOneDimensional());
+  CPPUNIT_ASSERT_EQUAL(32, bars->getLeft());
+  CPPUNIT_ASSERT_EQUAL(32, bars->getTop());
+  CPPUNIT_ASSERT_EQUAL(256, bars->getRight());
+  CPPUNIT_ASSERT_EQUAL(160, bars->getBottom());
+}
+
+void RegionProposerTest::testSkipsSparseCells() {
+  Ref<BitMatrix> matrix (new BitMatrix(256, 256));
+  CPPUNIT_ASSERT(RegionProposer(matrix).propose().empty());
+
+  // A frame around the image and one busy cell on its own.
+  matrix->setRegion(0, 0, 256, 2);
+  matrix->setRegion(0, 0, 2, 256);
+  for (int x = 128; x < 160; x += 4) {
+    matrix->setRegion(x, 128, 2, 32);
+  }
+  CPPUNIT_ASSERT(RegionProposer(matrix).propose().empty());
+}
+
+}
@@ -0,0 +1,93 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  StartupTest.cpp
+ *  zxing
+ *
+ *  Copyright 2010 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StartupTest.h"
+#include <zxing/MultiFormatReader.h>
+#include <zxing/common/CharacterSetECI.h>
+#include <zxing/common/reedsolomon/GenericGF.h>
+#ifndef NO_QR_CODE
+#include <zxing/qrcode/Version.h>
+#endif
+#ifndef NO_DATA_MATRIX
+#include <zxing/datamatrix/Version.h>
+#endif
+#include <ctime>
+#include <iostream>
+
+using namespace std;
+
+namespace zxing {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StartupTest);
+
+namespace {
+
+double elapsedUsec(clock_t start) {
+  return double(clock() - start) * 1000000.0 / CLOCKS_PER_SEC;
+}
+
+}
+
+void StartupTest::testTablesBuiltOnce() {
+  // The decoder tables are built on first use; every later lookup has to
+  // hand out the same objects.
+  clock_t start = clock();
+#ifndef NO_QR_CODE
+  qrcode::Version *qrVersion = qrcode::Version::getVersionForNumber(40);
+#endif
+#ifndef NO_DATA_MATRIX
+  Ref<datamatrix::Version> dmVersion = datamatrix::Version::getVersionForDimensions(144, 144);
+#endif
+  Ref<GenericGF> aztecField = GenericGF::AZTEC_DATA_12();
+  Ref<GenericGF> qrField = GenericGF::QR_CODE_FIELD_256();
+  common::CharacterSetECI *eci = common::CharacterSetECI::getCharacterSetECIByValue(26);
+  double firstUse = elapsedUsec(start);
+
+#ifndef NO_QR_CODE
+  CPPUNIT_ASSERT_EQUAL(177, qrVersion->getDimensionForVersion());
+  CPPUNIT_ASSERT(qrVersion == qrcode::Version::getVersionForNumber(40));
+#endif
+#ifndef NO_DATA_MATRIX
+  CPPUNIT_ASSERT_EQUAL(24, dmVersion->getVersionNumber());
+  CPPUNIT_ASSERT(dmVersion.object_ == datamatrix::Version::getVersionForDimensions(144, 144).object_);
+#endif
+  CPPUNIT_ASSERT_EQUAL(1, aztecField->exp(aztecField->log(1)));
+  CPPUNIT_ASSERT_EQUAL(string("UTF8"), string(eci->name()));
+
+  CPPUNIT_ASSERT(aztecField.object_ == GenericGF::AZTEC_DATA_12().object_);
+  CPPUNIT_ASSERT(qrField.object_ == GenericGF::QR_CODE_FIELD_256().object_);
+  CPPUNIT_ASSERT(GenericGF::AZTEC_DATA_8().object_ == GenericGF::DATA_MATRIX_FIELD_256().object_);
+  CPPUNIT_ASSERT(eci == common::CharacterSetECI::getCharacterSetECIByName("UTF-8"));
+  CPPUNIT_ASSERT(common::CharacterSetECI::getCharacterSetECIByValue(899) == 0);
+
+  cout << endl << "decoder tables: " << firstUse << " us on first use" << endl;
+}
+
+void StartupTest::testReaderStartupTime() {
+  const int iterations = 100;
+  clock_t start = clock();
+  for (int i = 0; i < iterations; i++) {
+    MultiFormatReader reader;
+    reader.setHints(DecodeHints::DEFAULT_HINT);
+  }
+  cout << endl << "reader setup: " << elapsedUsec(start) / iterations << " us" << endl;
+}
+
+}
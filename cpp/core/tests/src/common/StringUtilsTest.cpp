@@ -0,0 +1,119 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringUtilsTest.h"
+#include <zxing/FormatException.h>
+#include <zxing/common/Str.h>
+#include <string.h>
+
+using std::string;
+
+namespace zxing {
+namespace common {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StringUtilsTest);
+
+namespace {
+string toUTF8(char const* bytes, char const* encoding) {
+  string result;
+  StringUtils::appendUTF8(result, bytes, strlen(bytes), encoding);
+  return result;
+}
+
+bool rejects(char const* bytes, char const* encoding) {
+  try {
+    toUTF8(bytes, encoding);
+  } catch (FormatException const&) {
+    return true;
+  }
+  return false;
+}
+}
+
+void StringUtilsTest::testASCII() {
+  string result("> ");
+  StringUtils::appendUTF8(result, "Hello, world! 0123456789", 24, StringUtils::ASCII);
+  CPPUNIT_ASSERT_EQUAL(string("> Hello, world! 0123456789"), result);
+  CPPUNIT_ASSERT(rejects("abc\xE9", StringUtils::ASCII));
+}
+
+void StringUtilsTest::testSingleByte() {
+  CPPUNIT_ASSERT_EQUAL(string("caf\xC3\xA9 na\xC3\xAFve"),
+                       toUTF8("caf\xE9 na\xEFve", StringUtils::ISO88591));
+  // Euro sign in ISO-8859-15 and windows-1252, L with caron in ISO-8859-2
+  CPPUNIT_ASSERT_EQUAL(string("\xE2\x82\xAC"), toUTF8("\xA4", "ISO-8859-15"));
+  CPPUNIT_ASSERT_EQUAL(string("\xE2\x82\xAC"), toUTF8("\x80", "Cp1252"));
+  CPPUNIT_ASSERT_EQUAL(string("\xC4\xBD"), toUTF8("\xA5", "ISO8859_2"));
+  // 0x81 is unassigned in windows-1252
+  CPPUNIT_ASSERT(rejects("\x81", "windows-1252"));
+}
+
+void StringUtilsTest::testUTF8() {
+  char const* text = "\xC3\xA9\xE3\x81\x82\xF0\x9F\x98\x80 long enough for a word";
+  CPPUNIT_ASSERT_EQUAL(string(text), toUTF8(text, StringUtils::UTF8));
+  CPPUNIT_ASSERT(rejects("\xC0\xAF", StringUtils::UTF8));
+  CPPUNIT_ASSERT(rejects("\xED\xA0\x80", StringUtils::UTF8));
+  CPPUNIT_ASSERT(rejects("abc\xE3\x81", StringUtils::UTF8));
+}
+
+void StringUtilsTest::testJapanese() {
+  // "\xE3\x81\x82" is HIRAGANA LETTER A, "\xE6\xBC\xA2" is the kanji for "kan"
+  CPPUNIT_ASSERT_EQUAL(string("\xE3\x80\x80\xE3\x81\x82\xE6\xBC\xA2"),
+                       toUTF8("\x81\x40\x82\xA0\x8A\xBF", StringUtils::SHIFT_JIS));
+  CPPUNIT_ASSERT_EQUAL(string("\xEF\xBD\xB1"), toUTF8("\xB1", "SJIS"));
+  CPPUNIT_ASSERT_EQUAL(string("\xE3\x81\x82\xE6\xBC\xA2\xEF\xBD\xB1"),
+                       toUTF8("\xA4\xA2\xB4\xC1\x8E\xB1", StringUtils::EUC_JP));
+  CPPUNIT_ASSERT(rejects("\x81", StringUtils::SHIFT_JIS));
+}
+
+void StringUtilsTest::testChinese() {
+  // "\xE5\x95\x8A" is the first GB2312 hanzi, "\xE4\xB8\xAD" means "middle"
+  CPPUNIT_ASSERT_EQUAL(string("\xE5\x95\x8A\xE4\xB8\xAD"),
+                       toUTF8("\xB0\xA1\xD6\xD0", StringUtils::GB2312));
+  CPPUNIT_ASSERT_EQUAL(string("\xE4\xB8\xAD"), toUTF8("\xD6\xD0", "GB18030"));
+}
+
+void StringUtilsTest::testGuessEncoding() {
+  StringUtils::Hashtable hints;
+  char ascii[] = "plain ASCII text";
+  CPPUNIT_ASSERT_EQUAL(string(StringUtils::ISO88591),
+                       StringUtils::guessEncoding(ascii, (int) strlen(ascii), hints));
+  char utf8[] = "caf\xC3\xA9";
+  CPPUNIT_ASSERT_EQUAL(string(StringUtils::UTF8),
+                       StringUtils::guessEncoding(utf8, (int) strlen(utf8), hints));
+}
+
+void StringUtilsTest::testConvertInPlace() {
+  string text("ASCII only");
+  char const* data = text.data();
+  StringUtils::convertToUTF8(text, StringUtils::ISO88591);
+  CPPUNIT_ASSERT_EQUAL(string("ASCII only"), text);
+  CPPUNIT_ASSERT(data == text.data());
+  text = "caf\xE9";
+  StringUtils::convertToUTF8(text, StringUtils::ISO88591);
+  CPPUNIT_ASSERT_EQUAL(string("caf\xC3\xA9"), text);
+
+  // long enough not to live inside the string object itself
+  text.assign(100, 'x');
+  data = text.data();
+  Ref<String> adopted(String::adopt(text));
+  CPPUNIT_ASSERT(adopted->getText().data() == data);
+  CPPUNIT_ASSERT(text.empty());
+}
+
+}
+}
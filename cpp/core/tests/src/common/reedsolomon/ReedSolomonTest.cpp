@@ -54,7 +54,7 @@ void ReedSolomonTest::setUp() {
   qrCodeCorrectable_ =
     (qrCodeTestWithEc_->size() - qrCodeTest_->size()) / 2;
 
-  qrRSDecoder_ = new ReedSolomonDecoder(GenericGF::QR_CODE_FIELD_256);
+  qrRSDecoder_ = new ReedSolomonDecoder(GenericGF::QR_CODE_FIELD_256());
 }
 
 void ReedSolomonTest::tearDown() {
@@ -0,0 +1,143 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RegionSearchTest.h"
+#include <zxing/NotFoundException.h>
+#include <zxing/ReaderException.h>
+#include <zxing/common/GreyscaleLuminanceSource.h>
+#include <zxing/common/HybridBinarizer.h>
+#include <zxing/multi/ByQuadrantReader.h>
+#include <zxing/multi/GenericMultipleBarcodeReader.h>
+
+using std::string;
+using std::vector;
+
+namespace zxing {
+namespace multi {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RegionSearchTest);
+
+namespace {
+
+struct Barcode {
+  int left;
+  int top;
+  int right;
+  int bottom;
+  char const* text;
+  BarcodeFormat::Value format;
+};
+
+// Decodes the first of its barcodes that lies inside the region of
+// interest, without looking at the image.
+class StubReader : public Reader {
+public:
+  StubReader(Barcode const* barcodes, int count) : barcodes_(barcodes), count_(count) {
+  }
+
+  Ref<Result> decode(Ref<BinaryBitmap> image, DecodeHints hints) {
+    int left, top, right, bottom;
+    hints.getRegionOfInterest(image->getWidth(), image->getHeight(), left, top, right, bottom);
+    for (int i = 0; i < count_; i++) {
+      Barcode const& barcode = barcodes_[i];
+      if (barcode.left >= left && barcode.top >= top &&
+          barcode.right <= right && barcode.bottom <= bottom) {
+        ArrayRef< Ref<ResultPoint> > points (2);
+        points[0] = new ResultPoint(barcode.left, barcode.top);
+        points[1] = new ResultPoint(barcode.right, barcode.bottom);
+        return Ref<Result>(new Result(Ref<String>(new String(barcode.text)), ArrayRef<char>(),
+                                      points, barcode.format));
+      }
+    }
+    throw NotFoundException();
+  }
+
+  Ref<Reader> cloneReader() const {
+    return Ref<Reader>(new StubReader(barcodes_, count_));
+  }
+
+private:
+  Barcode const* barcodes_;
+  int count_;
+};
+
+Ref<BinaryBitmap> blankImage(int width, int height) {
+  ArrayRef<char> pixels (width * height);
+  Ref<LuminanceSource> source (new GreyscaleLuminanceSource(pixels, width, height, 0, 0, width, height));
+  return Ref<BinaryBitmap>(new BinaryBitmap(Ref<Binarizer>(new HybridBinarizer(source))));
+}
+
+string describe(Ref<Result> const& result) {
+  return result->getText()->getText() + " " + BarcodeFormat::barcodeFormatNames[result->getBarcodeFormat()];
+}
+
+}
+
+void RegionSearchTest::testGenericReaderOrder() {
+  Barcode const barcodes[] = {
+    {250, 250, 350, 350, "centre", BarcodeFormat::QR_CODE},
+    {20, 20, 80, 80, "corner", BarcodeFormat::QR_CODE},
+    {20, 500, 80, 560, "corner", BarcodeFormat::DATA_MATRIX},
+    {450, 450, 550, 550, "far", BarcodeFormat::QR_CODE},
+    // Repeats the second.
+    {500, 20, 560, 80, "corner", BarcodeFormat::QR_CODE}
+  };
+  StubReader stub (barcodes, 5);
+  GenericMultipleBarcodeReader reader (stub);
+  Ref<BinaryBitmap> image = blankImage(600, 600);
+  for (int threads = 1; threads <= 4; threads += 3) {
+    DecodeHints hints (DecodeHints::DEFAULT_HINT);
+    hints.setThreads(threads);
+    vector<Ref<Result> > results = reader.decodeMultiple(image, hints);
+    // In the order decoding the parts one at a time would find them: the
+    // second is found left of the first, the third below the second and the
+    // fourth right of the first.
+    CPPUNIT_ASSERT_EQUAL(4, (int) results.size());
+    CPPUNIT_ASSERT_EQUAL(string("centre QR_CODE"), describe(results[0]));
+    CPPUNIT_ASSERT_EQUAL(string("corner QR_CODE"), describe(results[1]));
+    CPPUNIT_ASSERT_EQUAL(string("corner DATA_MATRIX"), describe(results[2]));
+    CPPUNIT_ASSERT_EQUAL(string("far QR_CODE"), describe(results[3]));
+    CPPUNIT_ASSERT_EQUAL(450.0f, results[3]->getResultPoints()[0]->getX());
+  }
+}
+
+void RegionSearchTest::testByQuadrantReaderOrder() {
+  Barcode const barcodes[] = {
+    // Only inside the center quarter...
+    {260, 260, 340, 340, "middle", BarcodeFormat::QR_CODE},
+    // ...which is tried after the bottom right one.
+    {400, 400, 500, 500, "bottom right", BarcodeFormat::QR_CODE}
+  };
+  Ref<BinaryBitmap> image = blankImage(600, 600);
+  for (int threads = 1; threads <= 4; threads += 3) {
+    DecodeHints hints (DecodeHints::DEFAULT_HINT);
+    hints.setThreads(threads);
+    StubReader both (barcodes, 2);
+    CPPUNIT_ASSERT_EQUAL(string("bottom right QR_CODE"), describe(ByQuadrantReader(both).decode(image, hints)));
+    StubReader middle (barcodes, 1);
+    CPPUNIT_ASSERT_EQUAL(string("middle QR_CODE"), describe(ByQuadrantReader(middle).decode(image, hints)));
+    StubReader none (barcodes, 0);
+    try {
+      ByQuadrantReader(none).decode(image, hints);
+      CPPUNIT_FAIL("expected a ReaderException");
+    } catch (ReaderException const&) {
+    }
+  }
+}
+
+}
+}
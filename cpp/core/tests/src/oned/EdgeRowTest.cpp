@@ -0,0 +1,151 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EdgeRowTest.h"
+#include <zxing/oned/OneDReader.h>
+#include <algorithm>
+#include <limits.h>
+#include <math.h>
+
+using std::vector;
+
+namespace zxing {
+namespace oned {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(EdgeRowTest);
+
+namespace {
+
+const int WHITE = 200;
+const int BLACK = 40;
+
+// A row of width pixels that starts white and changes colour at each of
+// edges, each pixel taking the average of what it covers, as a camera's
+// would.
+ArrayRef<char> sampleRow(vector<float> const& edges, int width) {
+  ArrayRef<char> row(width);
+  for (int x = 0; x < width; x++) {
+    float black = 0;
+    for (size_t i = 1; i < edges.size() + 1; i += 2) {
+      float start = edges[i - 1];
+      float end = i < edges.size() ? edges[i] : (float) width;
+      black += std::max(0.0f, std::min(x + 1.0f, end) - std::max((float) x, start));
+    }
+    row[x] = (char) (int) (WHITE - (WHITE - BLACK) * black + 0.5f);
+  }
+  return row;
+}
+
+struct Matcher : public OneDReader {
+  using OneDReader::patternMatchVariance;
+  using OneDReader::recordPattern;
+};
+
+const int L_PATTERNS[10][4] = {
+  {3, 2, 1, 1}, {2, 2, 2, 1}, {2, 1, 2, 2}, {1, 4, 1, 1}, {1, 1, 3, 2},
+  {1, 2, 3, 1}, {1, 1, 1, 4}, {1, 3, 1, 2}, {1, 2, 1, 3}, {3, 1, 1, 2}
+};
+
+}
+
+void EdgeRowTest::testSubPixelEdges() {
+  vector<float> edges;
+  edges.push_back(10.25f);
+  edges.push_back(13.75f);
+  edges.push_back(15.5f);
+  edges.push_back(21.0f);
+  EdgeRow row;
+  row.find(sampleRow(edges, 30), 30);
+
+  CPPUNIT_ASSERT_EQUAL(5, row.getRunCount());
+  CPPUNIT_ASSERT(!row.isBlack(0));
+  CPPUNIT_ASSERT(row.isBlack(1));
+  CPPUNIT_ASSERT(row.isBlack(3));
+  for (int i = 0; i < 4; i++) {
+    CPPUNIT_ASSERT(fabs(row.getRunEnd(i) - edges[i]) < 0.01f);
+    CPPUNIT_ASSERT_EQUAL(row.getRunEnd(i), row.getRunStart(i + 1));
+  }
+  CPPUNIT_ASSERT_EQUAL(30.0f, row.getRunEnd(4));
+
+  CPPUNIT_ASSERT(fabs(row.getRunEnd(1) - row.getRunStart(1) - 3.5f) < 0.02f);
+  CPPUNIT_ASSERT(fabs(row.getRunEnd(2) - row.getRunStart(2) - 1.75f) < 0.02f);
+}
+
+void EdgeRowTest::testBlurredDigits() {
+  // EAN left-hand digits 0 to 9 after a start guard, at 1.4 pixels a
+  // module, then blurred: bars a module wide no longer reach black.
+  const float moduleSize = 1.4f;
+  vector<float> edges;
+  float x = 10 * moduleSize;
+  for (int i = 0; i < 3; i++) {
+    edges.push_back(x);
+    x += moduleSize;
+  }
+  for (int digit = 0; digit < 10; digit++) {
+    for (int i = 0; i < 4; i++) {
+      edges.push_back(x);
+      x += L_PATTERNS[digit][i] * moduleSize;
+    }
+  }
+  edges.push_back(x);
+  int width = (int) x + 10;
+  ArrayRef<char> sharp = sampleRow(edges, width);
+  ArrayRef<char> blurred(width);
+  for (int i = 0; i < width; i++) {
+    int left = sharp[std::max(0, i - 1)] & 0xff;
+    int right = sharp[std::min(width - 1, i + 1)] & 0xff;
+    blurred[i] = (char) ((left + 4 * (sharp[i] & 0xff) + right) / 6);
+  }
+
+  // Drawn four bits a pixel, as readers see them with sub-pixel edges.
+  EdgeRow row;
+  row.find(blurred, width);
+  CPPUNIT_ASSERT_EQUAL((int) edges.size() + 1, row.getRunCount());
+  Ref<BitArray> bits (new BitArray(width * 4));
+  row.render(4, *bits);
+  vector<int> counters(4);
+  for (int digit = 0; digit < 10; digit++) {
+    Matcher::recordPattern(bits, (int) (row.getRunStart(4 + 4 * digit) * 4 + 0.5f), counters);
+    int bestVariance = INT_MAX;
+    int best = -1;
+    for (int i = 0; i < 10; i++) {
+      int variance = Matcher::patternMatchVariance(counters, L_PATTERNS[i], 179);
+      if (variance < bestVariance) {
+        bestVariance = variance;
+        best = i;
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(digit, best);
+  }
+}
+
+void EdgeRowTest::testRender() {
+  vector<float> edges;
+  edges.push_back(2.5f);
+  edges.push_back(4.25f);
+  EdgeRow row;
+  row.find(sampleRow(edges, 8), 8);
+  BitArray bits(32);
+  bits.set(0);
+  row.render(4, bits);
+  for (int i = 0; i < 32; i++) {
+    CPPUNIT_ASSERT_EQUAL(i >= 10 && i < 17, bits.get(i));
+  }
+}
+
+}
+}
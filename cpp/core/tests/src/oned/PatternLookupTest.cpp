@@ -0,0 +1,116 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PatternLookupTest.h"
+#include <zxing/oned/UPCEANReader.h>
+#include <stdlib.h>
+
+using std::vector;
+
+namespace zxing {
+namespace oned {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PatternLookupTest);
+
+namespace {
+
+const int PATTERNS[4][3] = {
+  {1, 1, 3}, {1, 3, 1}, {2, 2, 1}, {1, 2, 2}
+};
+
+vector<int> widths(int a, int b, int c) {
+  vector<int> counters(3);
+  counters[0] = a;
+  counters[1] = b;
+  counters[2] = c;
+  return counters;
+}
+
+struct Digits : public UPCEANReader {
+  using UPCEANReader::L_PATTERNS;
+  using UPCEANReader::L_AND_G_PATTERNS;
+  using OneDReader::PATTERN_MATCH_RESULT_SCALE_FACTOR;
+  using OneDReader::patternMatchVariance;
+};
+
+// UPCEANReader's limits.
+const int MAX_AVG_VARIANCE = (int)(Digits::PATTERN_MATCH_RESULT_SCALE_FACTOR * 0.48f);
+const int MAX_INDIVIDUAL_VARIANCE = (int)(Digits::PATTERN_MATCH_RESULT_SCALE_FACTOR * 0.7f);
+
+// matchDigit() as it was before it used a PatternLookup.
+int matchEach(vector<int>& counters, vector<int const*> const& patterns, int& bestVariance) {
+  bestVariance = MAX_AVG_VARIANCE;
+  int bestMatch = -1;
+  for (int i = 0; i < (int) patterns.size(); i++) {
+    int variance = Digits::patternMatchVariance(counters, patterns[i], MAX_INDIVIDUAL_VARIANCE);
+    if (variance < bestVariance) {
+      bestVariance = variance;
+      bestMatch = i;
+    }
+  }
+  return bestMatch;
+}
+
+}
+
+void PatternLookupTest::testLookup() {
+  PatternLookup lookup(PATTERNS[0], 4, 3);
+  CPPUNIT_ASSERT_EQUAL(0, lookup.lookup(widths(1, 1, 3)));
+  CPPUNIT_ASSERT_EQUAL(1, lookup.lookup(widths(10, 30, 10)));
+  CPPUNIT_ASSERT_EQUAL(2, lookup.lookup(widths(9, 11, 5)));
+  CPPUNIT_ASSERT_EQUAL(3, lookup.lookup(widths(4, 9, 7)));
+  // Rounds to a pattern that is not there.
+  CPPUNIT_ASSERT_EQUAL(-1, lookup.lookup(widths(3, 1, 1)));
+  // The middle bar is 2.5 modules wide: 2 or 3 is too close to call.
+  CPPUNIT_ASSERT_EQUAL(-1, lookup.lookup(widths(5, 10, 5)));
+  // Fewer pixels than modules, and the wrong number of elements.
+  CPPUNIT_ASSERT_EQUAL(-1, lookup.lookup(widths(1, 1, 1)));
+  CPPUNIT_ASSERT_EQUAL(-1, lookup.lookup(vector<int>(4, 5)));
+}
+
+void PatternLookupTest::testInvert() {
+  int const encodings[] = {0x05, 0x12, 0x03};
+  vector<signed char> indices = PatternLookup::invert(encodings, 3, 5);
+  CPPUNIT_ASSERT_EQUAL(32, (int) indices.size());
+  for (int i = 0; i < 32; i++) {
+    int expected = i == 0x05 ? 0 : i == 0x12 ? 1 : i == 0x03 ? 2 : -1;
+    CPPUNIT_ASSERT_EQUAL(expected, (int) indices[i]);
+  }
+}
+
+void PatternLookupTest::testMatchDigit() {
+  srand(43);
+  for (int trial = 0; trial < 20000; trial++) {
+    vector<int const*> const& patterns =
+      (trial & 1) == 0 ? Digits::L_PATTERNS : Digits::L_AND_G_PATTERNS;
+    int digit = rand() % 20;
+    int moduleSize = 1 + rand() % 6;
+    vector<int> counters(4);
+    for (int i = 0; i < 4; i++) {
+      int width = Digits::L_AND_G_PATTERNS[digit][i] * moduleSize + rand() % 5 - 2;
+      counters[i] = width < 1 ? 1 : width;
+    }
+    int expectedVariance;
+    int expected = matchEach(counters, patterns, expectedVariance);
+    int variance;
+    CPPUNIT_ASSERT_EQUAL(expected, UPCEANReader::matchDigit(counters, patterns, variance));
+    CPPUNIT_ASSERT_EQUAL(expectedVariance, variance);
+  }
+}
+
+}
+}
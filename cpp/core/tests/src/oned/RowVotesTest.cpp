@@ -0,0 +1,170 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ * Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RowVotesTest.h"
+#include <zxing/oned/Code128Reader.h>
+#include <zxing/ReaderException.h>
+
+using std::string;
+using std::vector;
+
+namespace zxing {
+namespace oned {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RowVotesTest);
+
+namespace {
+
+// Accepts values whose sum is a multiple of 10, like a check digit would.
+class SumCheck : public RowVotes::Check {
+public:
+  SumCheck() : calls(0) {}
+
+  bool accept(vector<int> const& values) {
+    calls++;
+    int sum = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      sum += values[i];
+    }
+    return sum % 10 == 0;
+  }
+
+  int calls;
+};
+
+}
+
+void RowVotesTest::testElect() {
+  RowVotes votes;
+  int layout = RowVotes::layout(BarcodeFormat::EAN_8, 3);
+  votes.addRow(layout, 3, 10, 5, 95);
+  votes.addRow(layout, 3, 20, 7, 97);
+  votes.add(layout, 0, 1, 50);
+  votes.add(layout, 0, 7, 40);
+  votes.add(layout, 0, 7, 40);
+  votes.add(layout, 1, 2, 10);
+  votes.add(layout, 2, 1, 30);
+
+  SumCheck check;
+  vector<int> values;
+  CPPUNIT_ASSERT(votes.elect(layout, check, values));
+  CPPUNIT_ASSERT_EQUAL(3, (int) values.size());
+  CPPUNIT_ASSERT_EQUAL(7, values[0]);
+  CPPUNIT_ASSERT_EQUAL(2, values[1]);
+  CPPUNIT_ASSERT_EQUAL(1, check.calls);
+
+  ArrayRef< Ref<ResultPoint> > points = votes.getResultPoints(layout);
+  CPPUNIT_ASSERT_EQUAL(6.0f, points[0]->getX());
+  CPPUNIT_ASSERT_EQUAL(96.0f, points[1]->getX());
+  CPPUNIT_ASSERT_EQUAL(15.0f, points[0]->getY());
+
+  // A position nobody read fails the election.
+  int longer = RowVotes::layout(BarcodeFormat::EAN_8, 4);
+  votes.addRow(longer, 4, 10, 5, 95);
+  votes.addRow(longer, 4, 20, 5, 95);
+  votes.add(longer, 0, 1, 50);
+  CPPUNIT_ASSERT(!votes.elect(longer, check, values));
+}
+
+void RowVotesTest::testElectRunnerUp() {
+  RowVotes votes;
+  int layout = RowVotes::layout(BarcodeFormat::EAN_8, 2);
+  votes.addRow(layout, 2, 0, 0, 10);
+  votes.addRow(layout, 2, 1, 0, 10);
+  votes.add(layout, 0, 3, 90);
+  votes.add(layout, 0, 4, 20);
+  votes.add(layout, 1, 5, 60);
+  votes.add(layout, 1, 6, 30);
+
+  // 3 + 5 fails; 4 + 5 would pass but 4 is too weak to stand in for 3,
+  // while 3 + 6 is not a multiple of 10 either.
+  SumCheck check;
+  vector<int> values;
+  CPPUNIT_ASSERT(!votes.elect(layout, check, values));
+
+  votes.add(layout, 1, 7, 40);
+  CPPUNIT_ASSERT(votes.elect(layout, check, values));
+  CPPUNIT_ASSERT_EQUAL(3, values[0]);
+  CPPUNIT_ASSERT_EQUAL(7, values[1]);
+}
+
+void RowVotesTest::testElectNeedsTwoRows() {
+  RowVotes votes;
+  int layout = RowVotes::layout(BarcodeFormat::EAN_8, 1);
+  votes.addRow(layout, 1, 0, 0, 10);
+  votes.add(layout, 0, 0, 100);
+
+  SumCheck check;
+  vector<int> values;
+  CPPUNIT_ASSERT(!votes.elect(layout, check, values));
+  votes.addRow(layout, 1, 1, 0, 10);
+  CPPUNIT_ASSERT(votes.elect(layout, check, values));
+}
+
+void RowVotesTest::testMerge() {
+  int ean = RowVotes::layout(BarcodeFormat::EAN_8, 8);
+  int shortCode = RowVotes::layout(BarcodeFormat::CODE_128, 4);
+  int longCode = RowVotes::layout(BarcodeFormat::CODE_128, 5);
+  RowVotes first;
+  first.addRow(ean, 8, 0, 0, 10);
+  first.addRow(shortCode, 4, 0, 0, 10);
+  first.add(shortCode, 1, 9, 10);
+  RowVotes second;
+  second.addRow(longCode, 5, 1, 0, 10);
+  second.addRow(longCode, 5, 2, 0, 10);
+  second.addRow(shortCode, 4, 1, 0, 10);
+  second.add(shortCode, 1, 9, 10);
+  second.add(shortCode, 1, 8, 15);
+
+  CPPUNIT_ASSERT(RowVotes().empty());
+  first.merge(second);
+  CPPUNIT_ASSERT(!first.empty());
+  CPPUNIT_ASSERT_EQUAL(2, first.getRowCount(shortCode));
+  CPPUNIT_ASSERT_EQUAL(2, first.getRowCount(longCode));
+  CPPUNIT_ASSERT_EQUAL(1, first.getRowCount(ean));
+
+  vector<int> layouts = first.getLayouts(BarcodeFormat::CODE_128);
+  CPPUNIT_ASSERT_EQUAL(2, (int) layouts.size());
+  CPPUNIT_ASSERT(layouts[0] == shortCode || layouts[0] == longCode);
+  CPPUNIT_ASSERT_EQUAL(1, (int) first.getLayouts(BarcodeFormat::EAN_8).size());
+  CPPUNIT_ASSERT_EQUAL(0, (int) first.getLayouts(BarcodeFormat::UPC_A).size());
+}
+
+void RowVotesTest::testCode128Codes() {
+  // Start B, "Hi", checksum (104 + 40 + 2 * 73) % 103.
+  vector<int> codes;
+  codes.push_back(104);
+  codes.push_back('H' - ' ');
+  codes.push_back('i' - ' ');
+  codes.push_back(84);
+  string text;
+  Code128Reader::decodeCodes(codes, text);
+  CPPUNIT_ASSERT_EQUAL(string("Hi"), text);
+
+  codes[3] = 85;
+  text.clear();
+  bool rejected = false;
+  try {
+    Code128Reader::decodeCodes(codes, text);
+  } catch (ReaderException const&) {
+    rejected = true;
+  }
+  CPPUNIT_ASSERT(rejected);
+}
+
+}
+}
@@ -0,0 +1,77 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DecodedBitStreamParserTest.h"
+#include <zxing/FormatException.h>
+
+using namespace std;
+
+namespace zxing {
+namespace pdf417 {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DecodedBitStreamParserTest);
+
+namespace {
+
+const int NUMERIC_LATCH = 902;
+const int PAD = 900;
+
+/* symbol length descriptor, numeric latch, the given codewords and two
+   padding codewords */
+string decodeNumeric(int const* codewords, int count) {
+  ArrayRef<int> symbol(count + 4);
+  symbol[0] = count + 2;
+  symbol[1] = NUMERIC_LATCH;
+  for (int i = 0; i < count; i++) {
+    symbol[i + 2] = codewords[i];
+  }
+  symbol[count + 2] = PAD;
+  symbol[count + 3] = PAD;
+  return DecodedBitStreamParser::decode(symbol)->getText()->getText();
+}
+
+}
+
+void DecodedBitStreamParserTest::testNumericCompaction() {
+  // the worked example from the specification, 5.4.4
+  int const codewords[] = {1, 624, 434, 632, 282, 200};
+  CPPUNIT_ASSERT_EQUAL(string("000213298174000"), decodeNumeric(codewords, 6));
+}
+
+void DecodedBitStreamParserTest::testNumericCompactionFullGroups() {
+  // 15 codewords carry 43 digits behind the leading 1; a second group
+  // follows the first directly
+  int const codewords[] = {61, 109, 170, 544, 819, 268, 405, 690, 247, 718,
+                           596, 753, 320, 521, 825,
+                           1, 624, 434, 632, 282, 200};
+  CPPUNIT_ASSERT_EQUAL(string("3982597919074833788762328601290404796669725"
+                              "000213298174000"),
+                       decodeNumeric(codewords, 21));
+}
+
+void DecodedBitStreamParserTest::testNumericCompactionWithoutLeadingOne() {
+  int const codewords[] = {5, 624, 434, 632, 282, 200};
+  try {
+    decodeNumeric(codewords, 6);
+    CPPUNIT_FAIL("expected FormatException");
+  } catch (FormatException const& expected) {
+    (void)expected;
+  }
+}
+
+}
+}
@@ -0,0 +1,192 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ErrorCorrectionTest.h"
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+namespace zxing {
+namespace pdf417 {
+namespace decoder {
+namespace ec {
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ErrorCorrectionTest);
+
+namespace {
+
+const int MODULUS = 929;
+
+unsigned int seed = 1;
+
+int nextRandom(int n) {
+  seed = seed * 1103515245u + 12345u;
+  return (int) ((seed >> 16) % (unsigned int) n);
+}
+
+int power(int base, int exponent) {
+  int result = 1;
+  for (int i = 0; i < exponent; i++) {
+    result = result * base % MODULUS;
+  }
+  return result;
+}
+
+/* data codewords followed by numECCodewords check codewords, such that the
+   codeword polynomial vanishes at 3^1 .. 3^numECCodewords */
+ArrayRef<int> encode(int numData, int numECCodewords) {
+  // generator, highest degree first
+  vector<int> generator(1, 1);
+  for (int i = 1; i <= numECCodewords; i++) {
+    int root = power(3, i);
+    generator.push_back(0);
+    for (int k = (int) generator.size() - 1; k > 0; k--) {
+      generator[k] = (generator[k] + MODULUS - root * generator[k - 1] % MODULUS) % MODULUS;
+    }
+  }
+  ArrayRef<int> codewords(numData + numECCodewords);
+  for (int i = 0; i < numData; i++) {
+    codewords[i] = nextRandom(MODULUS);
+  }
+  vector<int> remainder(codewords->values().begin(), codewords->values().end());
+  for (int i = 0; i < numData; i++) {
+    int factor = remainder[i];
+    for (int k = 0; k <= numECCodewords; k++) {
+      remainder[i + k] = (remainder[i + k] + MODULUS - factor * generator[k] % MODULUS) % MODULUS;
+    }
+  }
+  for (int i = numData; i < numData + numECCodewords; i++) {
+    codewords[i] = (MODULUS - remainder[i]) % MODULUS;
+  }
+  return codewords;
+}
+
+ArrayRef<int> copy(ArrayRef<int> const& codewords) {
+  return ArrayRef<int>(new Array<int>(codewords->values().data(), codewords->size()));
+}
+
+/* replaces count distinct codewords with different values; returns their
+   positions */
+vector<int> corrupt(ArrayRef<int> received, int count) {
+  vector<int> positions;
+  while ((int) positions.size() < count) {
+    int position = nextRandom(received->size());
+    bool seen = false;
+    for (size_t i = 0; i < positions.size(); i++) {
+      seen = seen || positions[i] == position;
+    }
+    if (!seen) {
+      positions.push_back(position);
+      received[position] = (received[position] + 1 + nextRandom(MODULUS - 1)) % MODULUS;
+    }
+  }
+  return positions;
+}
+
+void assertEqual(ArrayRef<int> const& expected, ArrayRef<int> const& actual) {
+  CPPUNIT_ASSERT_EQUAL(expected->size(), actual->size());
+  for (int i = 0; i < expected->size(); i++) {
+    CPPUNIT_ASSERT_EQUAL(expected[i], actual[i]);
+  }
+}
+
+}
+
+void ErrorCorrectionTest::testNoError() {
+  ArrayRef<int> codewords = encode(20, 8);
+  ArrayRef<int> received = copy(codewords);
+  ErrorCorrection().decode(received, 8, ArrayRef<int>(0));
+  assertEqual(codewords, received);
+}
+
+void ErrorCorrectionTest::testMaxErrors() {
+  for (int level = 0; level <= 8; level++) {
+    int numECCodewords = 1 << (level + 1);
+    ArrayRef<int> codewords = encode(level == 8 ? 300 : 100, numECCodewords);
+    for (int trial = 0; trial < 4; trial++) {
+      ArrayRef<int> received = copy(codewords);
+      corrupt(received, numECCodewords / 2);
+      ErrorCorrection().decode(received, numECCodewords, ArrayRef<int>(0));
+      assertEqual(codewords, received);
+    }
+  }
+}
+
+void ErrorCorrectionTest::testErasures() {
+  // 2 * errors + erasures == numECCodewords
+  ArrayRef<int> codewords = encode(60, 32);
+  for (int errors = 0; errors <= 16; errors += 4) {
+    ArrayRef<int> received = copy(codewords);
+    vector<int> positions = corrupt(received, 32 - errors);
+    ArrayRef<int> erasures(32 - 2 * errors);
+    for (int i = 0; i < erasures->size(); i++) {
+      erasures[i] = positions[i];
+      received[positions[i]] = 0;
+    }
+    // unread codewords arrive as -1
+    if (erasures->size() > 0) {
+      received[erasures[0]] = -1;
+      erasures = ArrayRef<int>(new Array<int>(&erasures[1], erasures->size() - 1));
+    }
+    ErrorCorrection().decode(received, 32, erasures);
+    assertEqual(codewords, received);
+  }
+}
+
+void ErrorCorrectionTest::testTooManyErasures() {
+  ArrayRef<int> received = encode(20, 4);
+  ArrayRef<int> erasures(5);
+  for (int i = 0; i < 5; i++) {
+    erasures[i] = i;
+  }
+  try {
+    ErrorCorrection().decode(received, 4, erasures);
+    CPPUNIT_FAIL("expected ReedSolomonException");
+  } catch (ReedSolomonException const& expected) {
+    (void)expected;
+  }
+}
+
+void ErrorCorrectionTest::testBenchmark() {
+  // decoding time with the most errors each EC level can correct
+  const int iterations = 20;
+  cout << endl;
+  for (int level = 2; level <= 8; level++) {
+    int numECCodewords = 1 << (level + 1);
+    ArrayRef<int> codewords = encode(928 - numECCodewords, numECCodewords);
+    vector< ArrayRef<int> > received;
+    for (int i = 0; i < iterations; i++) {
+      received.push_back(copy(codewords));
+      corrupt(received.back(), numECCodewords / 2);
+    }
+    ErrorCorrection errorCorrection;
+    clock_t start = clock();
+    for (int i = 0; i < iterations; i++) {
+      errorCorrection.decode(received[i], numECCodewords, ArrayRef<int>(0));
+    }
+    double usec = double(clock() - start) * 1000000.0 / CLOCKS_PER_SEC / iterations;
+    assertEqual(codewords, received[0]);
+    cout << "PDF417 EC level " << level << ": " << usec << " us per decode" << endl;
+  }
+}
+
+}
+}
+}
+}
@@ -0,0 +1,52 @@
+// -*- mode:c++; tab-width:2; indent-tabs-mode:nil; c-basic-offset:2 -*-
+#ifndef __ERROR_CORRECTION_PDF_TEST_H__
+#define __ERROR_CORRECTION_PDF_TEST_H__
+
+/*
+ *  Copyright 2013 ZXing authors All rights reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <zxing/pdf417/decoder/ec/ErrorCorrection.h>
+
+namespace zxing {
+namespace pdf417 {
+namespace decoder {
+namespace ec {
+
+class ErrorCorrectionTest : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ErrorCorrectionTest);
+  CPPUNIT_TEST(testNoError);
+  CPPUNIT_TEST(testMaxErrors);
+  CPPUNIT_TEST(testErasures);
+  CPPUNIT_TEST(testTooManyErasures);
+  CPPUNIT_TEST(testBenchmark);
+  CPPUNIT_TEST_SUITE_END();
+
+protected:
+  void testNoError();
+  void testMaxErrors();
+  void testErasures();
+  void testTooManyErasures();
+  void testBenchmark();
+};
+
+}
+}
+}
+}
+
+#endif // __ERROR_CORRECTION_PDF_TEST_H__
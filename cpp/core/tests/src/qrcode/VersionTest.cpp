@@ -48,8 +48,8 @@ static void checkVersion(Version *version, int number, int dimension) {
 CPPUNIT_TEST_SUITE_REGISTRATION(VersionTest);
 
 void VersionTest::testVersionForNumber() {
-  for (int i = 1; i <= (int)Version::VERSIONS.size(); i++) {
-    Version *v = Version::VERSIONS[i-1];
+  for (int i = 1; i <= 40; i++) {
+    Version *v = Version::getVersionForNumber(i);
     CPPUNIT_ASSERT_EQUAL((int)i, v->getVersionNumber());
   }
 